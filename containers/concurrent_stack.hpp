@@ -0,0 +1,260 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   concurrent_stack.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// lock-free LIFO shared between threads (Treiber stack), gcc / clang __atomic builtins
+//
+//	nodes come from a pool allocated at construction, so push / pop never call the allocator.
+//	a list is linked by node index, and its head is one 64 bit word: [tag (32) | index (32)].
+//	the tag is incremented on every change of the head, which prevents ABA on the CAS.
+//	the pool has a fixed capacity: push returns false when it is exhausted.
+
+#ifndef CONCURRENT_STACK_HPP
+# define CONCURRENT_STACK_HPP
+
+# include <memory>
+# include <new>
+# include <stdexcept>
+# include <stdint.h>
+
+# include "../utils/util.hpp"
+
+namespace ft {
+
+
+template< typename T, typename Allocator = std::allocator<T> >
+class	concurrent_stack : private ft::ebo_holder_<Allocator>
+{
+	public:
+		// Member types
+			typedef T				value_type;
+			typedef Allocator		allocator_type;
+			typedef std::size_t		size_type;
+
+			typedef value_type&			reference;
+			typedef const value_type&	const_reference;
+
+		// Member functions
+			// constructors and canonical
+				explicit	concurrent_stack( size_type capacity, const Allocator& alloc = Allocator() )
+				: alloc_holder_(alloc), nodes_(NULL), capacity_(capacity), head_(nil_), free_(nil_), size_(0)
+				{
+					if (capacity >= nil_index_)
+						throw std::length_error("concurrent_stack: length_error: capacity >= 2^32 - 1");
+					nodes_ = node_allocator_type(alloc_()).allocate(capacity);
+					for (size_type i = 0; i < capacity; ++i)
+						nodes_[i].next = (i + 1 < capacity ? static_cast<uint32_t>(i + 1) : nil_index_);
+					if (capacity != 0)
+						free_ = 0;
+				}
+
+				// not thread safe: no other thread may use the stack any more
+				~concurrent_stack()
+				{
+					for (uint32_t i = index_(head_); i != nil_index_; i = nodes_[i].next)
+						alloc_().destroy(value_of_(i));
+					node_allocator_type(alloc_()).deallocate(nodes_, capacity_);
+				}
+
+			// Capacity
+				// snapshot, may be stale as soon as it returns
+				size_type	size() const
+				{ return (__atomic_load_n(&size_, __ATOMIC_RELAXED)); }
+
+				bool	empty() const
+				{ return (size() == 0); }
+
+				size_type	capacity() const
+				{ return (capacity_); }
+
+			// Modifiers
+				// false when the node pool is exhausted
+				bool	push( const value_type& value )
+				{
+					uint32_t	node = pop_list_(&free_);
+
+					if (node == nil_index_)
+						return (false);
+					try
+					{
+						alloc_().construct(value_of_(node), value);
+					}
+					catch (...)
+					{
+						push_chain_(&free_, node, node);
+						throw ;
+					}
+					push_chain_(&head_, node, node);
+					__atomic_fetch_add(&size_, 1, __ATOMIC_RELAXED);
+					return (true);
+				}
+
+				// false when the stack is empty. when the assignment to out throws, the element
+				// is pushed back (on the top, above what was pushed in the meantime)
+				bool	pop( value_type& out )
+				{
+					uint32_t	node = pop_list_(&head_);
+
+					if (node == nil_index_)
+						return (false);
+					try
+					{
+						out = *value_of_(node);
+					}
+					catch (...)
+					{
+						push_chain_(&head_, node, node);
+						throw ;
+					}
+					__atomic_fetch_sub(&size_, 1, __ATOMIC_RELAXED);
+					alloc_().destroy(value_of_(node));
+					push_chain_(&free_, node, node);
+					return (true);
+				}
+
+				// link [first, last) privately, then publish the whole chain with a single CAS
+				// (last one on the top). returns the number pushed, less than the range if the
+				// pool is exhausted; when a copy throws, nothing is pushed
+				template< class InputIt >
+				size_type	push_range( InputIt first, InputIt last )
+				{
+					uint32_t	chain_top = nil_index_;
+					uint32_t	chain_bottom = nil_index_;
+					size_type	count = 0;
+
+					for (; first != last; ++first, ++count)
+					{
+						uint32_t	node = pop_list_(&free_);
+
+						if (node == nil_index_)
+							break ;
+						try
+						{
+							alloc_().construct(value_of_(node), *first);
+						}
+						catch (...)
+						{
+							push_chain_(&free_, node, node);
+							free_chain_(chain_top, chain_bottom);
+							throw ;
+						}
+						if (chain_top == nil_index_)
+							chain_bottom = node;
+						else
+							__atomic_store_n(&nodes_[node].next, chain_top, __ATOMIC_RELAXED);
+						chain_top = node;
+					}
+					if (count != 0)
+					{
+						push_chain_(&head_, chain_top, chain_bottom);
+						__atomic_fetch_add(&size_, count, __ATOMIC_RELAXED);
+					}
+					return (count);
+				}
+
+
+	private:
+		struct	node_
+		{
+			uint32_t	next;
+			// raw storage of a T, constructed only while the node is in the stack
+			union
+			{
+				char		bytes[sizeof(T)];
+				double		align_d;
+				long		align_l;
+				void*		align_p;
+			}			storage;
+		};
+
+		typedef typename Allocator::template rebind<node_>::other	node_allocator_type;
+		typedef ft::ebo_holder_<Allocator>							alloc_holder_;
+		typedef uint64_t											head_type;
+
+		static const uint32_t	nil_index_ = 0xFFFFFFFFu;
+		static const head_type	nil_ = 0xFFFFFFFFu;		// tag 0, index nil_index_
+
+		node_*			nodes_;
+		size_type		capacity_;
+		// the two lists live on separate cache lines, both are hot
+		head_type		head_;
+		char			pad_head_[64 - sizeof(head_type)];
+		head_type		free_;
+		char			pad_free_[64 - sizeof(head_type)];
+		size_type		size_;
+
+		// not copyable
+		concurrent_stack( const concurrent_stack& );
+		concurrent_stack&	operator=( const concurrent_stack& );
+
+			allocator_type&		alloc_()
+			{ return (alloc_holder_::get()); }
+
+			T*	value_of_( uint32_t node )
+			{ return (reinterpret_cast<T*>(nodes_[node].storage.bytes)); }
+
+			static uint32_t		index_( head_type head )
+			{ return (static_cast<uint32_t>(head & 0xFFFFFFFFu)); }
+
+			static head_type	make_head_( head_type old_head, uint32_t index )
+			{ return ((((old_head >> 32) + 1) << 32) | index); }
+
+			// take the top node of a list (nil_index_ when the list is empty)
+			// destroy the values of a private chain (top to bottom) and give its nodes back
+			void	free_chain_( uint32_t top, uint32_t bottom )
+			{
+				if (top == nil_index_)
+					return ;
+				for (uint32_t node = top; ; node = __atomic_load_n(&nodes_[node].next, __ATOMIC_RELAXED))
+				{
+					alloc_().destroy(value_of_(node));
+					if (node == bottom)
+						break ;
+				}
+				push_chain_(&free_, top, bottom);
+			}
+
+			uint32_t	pop_list_( head_type* list )
+			{
+				head_type	old_head = __atomic_load_n(list, __ATOMIC_ACQUIRE);
+				head_type	new_head;
+
+				do
+				{
+					if (index_(old_head) == nil_index_)
+						return (nil_index_);
+					// the node may be taken by another thread meanwhile: then next is stale,
+					// but the tag in old_head has changed and the CAS fails
+					uint32_t	next = __atomic_load_n(&nodes_[index_(old_head)].next, __ATOMIC_RELAXED);
+					new_head = make_head_(old_head, next);
+				}
+				while (!__atomic_compare_exchange_n(list, &old_head, new_head, true,
+													__ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE));
+				return (index_(old_head));
+			}
+
+			// link the chain top -> ... -> bottom onto a list
+			void	push_chain_( head_type* list, uint32_t top, uint32_t bottom )
+			{
+				head_type	old_head = __atomic_load_n(list, __ATOMIC_RELAXED);
+
+				do
+					__atomic_store_n(&nodes_[bottom].next, index_(old_head), __ATOMIC_RELAXED);
+				while (!__atomic_compare_exchange_n(list, &old_head, make_head_(old_head, top), true,
+													__ATOMIC_RELEASE, __ATOMIC_RELAXED));
+			}
+
+};	// class concurrent_stack
+
+
+}	// namespace ft
+
+#endif
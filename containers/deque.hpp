@@ -0,0 +1,760 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deque.hpp                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// deque: https://en.cppreference.com/w/cpp/container/deque
+
+#ifndef DEQUE_HPP
+# define DEQUE_HPP
+
+# include <algorithm>
+# include <cstring>
+# include <limits>
+# include <stdexcept>
+
+# include "../utils/algorithm.hpp"
+# include "../utils/iterator.hpp"
+# include "../utils/type_traits.hpp"
+# include "../utils/util.hpp"
+
+namespace ft {
+
+/*
+	elements are stored in fixed-size chunks, and the map holds pointers to the chunks.
+	growing at either end only adds a chunk (and sometimes reallocates the map of pointers),
+	so elements are never relocated and references to them stay valid.
+
+	map_:	[    |    | c0 | c1 | c2 |    |    ]
+	                    |              |
+	                 start_.node   finish_.node
+	start_.cur: first element, finish_.cur: one past the last element
+*/
+
+// number of elements in one chunk
+template< typename T >
+inline std::size_t	deque_chunk_size_()
+{ return (sizeof(T) < 512 ? 512 / sizeof(T) : 1); }
+
+
+template< typename T, typename Ref, typename Ptr >
+class	deque_iterator_
+{
+	public:
+		typedef T								value_type;
+		typedef Ref								reference;
+		typedef Ptr								pointer;
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::random_access_iterator_tag	iterator_category;
+
+		typedef T**		map_pointer;
+
+	private:
+		typedef deque_iterator_<T, Ref, Ptr>			Self_;
+		typedef deque_iterator_<T, T&, T*>				iterator_;
+
+	public:
+		deque_iterator_()
+		: cur(NULL), first(NULL), last(NULL), node(NULL)
+		{
+
+		}
+
+		deque_iterator_( T* x, map_pointer y )
+		: cur(x), first(*y), last(*y + deque_chunk_size_<T>()), node(y)
+		{
+
+		}
+
+		deque_iterator_( const iterator_& other )
+		: cur(other.cur), first(other.first), last(other.last), node(other.node)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (*cur); }
+
+		pointer		operator->() const
+		{ return (cur); }
+
+		reference	operator[]( difference_type n ) const
+		{ return (*(*this + n)); }
+
+		Self_&	operator++()
+		{
+			++cur;
+			if (cur == last)
+			{
+				set_node(node + 1);
+				cur = first;
+			}
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			++*this;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			if (cur == first)
+			{
+				set_node(node - 1);
+				cur = last;
+			}
+			--cur;
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			--*this;
+			return (tmp);
+		}
+
+		Self_&	operator+=( difference_type n )
+		{
+			const difference_type	chunk = deque_chunk_size_<T>();
+			difference_type			offset = n + (cur - first);
+
+			if (offset >= 0 && offset < chunk)
+				cur += n;
+			else
+			{
+				difference_type	node_offset = offset > 0 ? offset / chunk
+															: -((-offset - 1) / chunk) - 1;
+				set_node(node + node_offset);
+				cur = first + (offset - node_offset * chunk);
+			}
+			return (*this);
+		}
+
+		Self_&	operator-=( difference_type n )
+		{ return (*this += -n); }
+
+		Self_	operator+( difference_type n ) const
+		{
+			Self_	tmp = *this;
+
+			return (tmp += n);
+		}
+
+		Self_	operator-( difference_type n ) const
+		{
+			Self_	tmp = *this;
+
+			return (tmp -= n);
+		}
+
+		void	set_node( map_pointer new_node )
+		{
+			node = new_node;
+			first = *new_node;
+			last = first + deque_chunk_size_<T>();
+		}
+	// ~public:
+
+		T*			cur;
+		T*			first;
+		T*			last;
+		map_pointer	node;
+
+};	// class deque_iterator_
+
+
+// Non-member functions (deque_iterator_)
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator==( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return (lhs.cur == rhs.cur); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator!=( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return (lhs.cur != rhs.cur); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator<( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node == rhs.node ? lhs.cur < rhs.cur : lhs.node < rhs.node); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator>( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return (rhs < lhs); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator<=( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return !(rhs < lhs); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator>=( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{ return !(lhs < rhs); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+std::ptrdiff_t	operator-( const deque_iterator_<T, R1, P1>& lhs, const deque_iterator_<T, R2, P2>& rhs )
+{
+	return (static_cast<std::ptrdiff_t>(deque_chunk_size_<T>()) * (lhs.node - rhs.node - 1)
+			+ (lhs.cur - lhs.first) + (rhs.last - rhs.cur));
+}
+
+template< class T, class Ref, class Ptr >
+deque_iterator_<T, Ref, Ptr>	operator+( std::ptrdiff_t n, const deque_iterator_<T, Ref, Ptr>& it )
+{ return (it + n); }
+
+
+template< typename T, typename Allocator = std::allocator<T> >
+class	deque : private ft::ebo_holder_<Allocator>
+{
+	public:
+		// Member types
+			typedef T				value_type;
+			typedef Allocator		allocator_type;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			typedef value_type&							reference;
+			typedef const value_type&					const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+			typedef deque_iterator_<T, T&, T*>					iterator;
+			typedef deque_iterator_<T, const T&, const T*>		const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+		// Member functions
+			// constructors and canonical
+				deque()
+				: alloc_holder_(), map_(NULL), map_size_(0)
+				{
+					initialize_map(0);
+				}
+
+				explicit	deque( const Allocator& alloc )
+				: alloc_holder_(alloc), map_(NULL), map_size_(0)
+				{
+					initialize_map(0);
+				}
+
+				explicit	deque( size_type count,
+									const value_type& value = value_type(),
+									const Allocator& alloc = Allocator() )
+				: alloc_holder_(alloc), map_(NULL), map_size_(0)
+				{
+					initialize_map(count);
+					assign(count, value);
+				}
+
+				template< class InputIt >
+				deque( InputIt first, InputIt last,
+						const Allocator& alloc = Allocator(),
+						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+				: alloc_holder_(alloc), map_(NULL), map_size_(0)
+				{
+					initialize_map(0);
+					assign(first, last);
+				}
+
+				deque( const deque& other )
+				: alloc_holder_(other.alloc_()), map_(NULL), map_size_(0)
+				{
+					initialize_map(other.size());
+					assign(other.begin(), other.end());
+				}
+
+				~deque()
+				{
+					clear();
+					deallocate_chunk(*start_.node);
+					deallocate_map(map_, map_size_);
+				}
+
+				deque&	operator=( const deque& other )
+				{
+					if (this == &other)
+						return (*this);
+					assign(other.begin(), other.end());
+					return (*this);
+				}
+
+				void	assign( size_type count, const value_type& value )
+				{
+					clear();
+					for (; count != 0; --count)
+						push_back(value);
+				}
+
+				template< class InputIt >
+				void	assign( InputIt first, InputIt last,
+								typename ft::enable_if<!ft::is_integral<InputIt>::value,
+														InputIt>::type* = NULL	)
+				{
+					clear();
+					for (; first != last; ++first)
+						push_back(*first);
+				}
+
+				allocator_type	get_allocator() const
+				{ return allocator_type(alloc_()); }
+
+			// Element access
+				reference	at( size_type pos )
+				{
+					if (pos >= size())
+						throw std::out_of_range("deque::at: out_of_range: pos >= this->size()");
+					return (start_[pos]);
+				}
+
+				const_reference		at( size_type pos ) const
+				{
+					if (pos >= size())
+						throw std::out_of_range("deque::at: out_of_range: pos >= this->size()");
+					return (start_[pos]);
+				}
+
+				reference	operator[]( size_type pos )
+				{ return (start_[pos]); }
+
+				const_reference		operator[]( size_type pos ) const
+				{ return (start_[pos]); }
+
+				reference	front()
+				{ return (*start_.cur); }
+
+				const_reference		front() const
+				{ return (*start_.cur); }
+
+				reference	back()
+				{ return (*(finish_ - 1)); }
+
+				const_reference		back() const
+				{ return (*(finish_ - 1)); }
+
+			// Iterators
+				iterator	begin()
+				{ return (start_); }
+
+				const_iterator	begin() const
+				{ return (start_); }
+
+				iterator	end()
+				{ return (finish_); }
+
+				const_iterator	end() const
+				{ return (finish_); }
+
+				reverse_iterator	rbegin()
+				{ return (reverse_iterator(end())); }
+
+				const_reverse_iterator	rbegin() const
+				{ return (const_reverse_iterator(end())); }
+
+				reverse_iterator	rend()
+				{ return (reverse_iterator(begin())); }
+
+				const_reverse_iterator	rend() const
+				{ return (const_reverse_iterator(begin())); }
+
+			// Capacity
+				bool	empty() const
+				{ return (start_ == finish_); }
+
+				size_type	size() const
+				{ return (size_type(finish_ - start_)); }
+
+				size_type	max_size() const
+				{
+					return std::min(static_cast<size_type>(std::numeric_limits<difference_type>::max() / sizeof(value_type)),
+									alloc_().max_size());
+				}
+
+			// Modifiers
+				void	clear()
+				{
+					while (!empty())
+						pop_back();
+					// recenter the only chunk left, so both ends have room to grow
+					map_pointer		center = map_ + map_size_ / 2;
+					if (center != start_.node)
+					{
+						*center = *start_.node;
+						start_.set_node(center);
+						start_.cur = start_.first + deque_chunk_size_<T>() / 2;
+						finish_ = start_;
+					}
+				}
+
+				iterator	insert( iterator pos, const value_type& value )
+				{
+					difference_type	index = pos - start_;
+
+					insert(pos, 1, value);
+					return (start_ + index);
+				}
+
+				// grow at the nearer end, then rotate the new elements into place
+				void	insert( iterator pos, size_type count, const value_type& value )
+				{
+					difference_type	index = pos - start_;
+					size_type		old_size = size();
+
+					if (static_cast<size_type>(index) < old_size / 2)
+					{
+						for (size_type i = 0; i < count; ++i)
+							push_front(value);
+						rotate_(start_, start_ + count, start_ + (count + index));
+					}
+					else
+					{
+						for (size_type i = 0; i < count; ++i)
+							push_back(value);
+						rotate_(start_ + index, start_ + old_size, finish_);
+					}
+				}
+
+				template< class InputIt >
+				void	insert( iterator pos, InputIt first, InputIt last,
+								typename ft::enable_if<!ft::is_integral<InputIt>::value,
+														InputIt>::type* = NULL)
+				{ range_insert(pos, first, last, ft::iterator_category(first)); }
+
+				iterator	erase( iterator pos )
+				{ return (erase(pos, pos + 1)); }
+
+				// shift the shorter side over the erased range, then pop at that end
+				iterator	erase( iterator first, iterator last )
+				{
+					difference_type	count = last - first;
+					difference_type	elems_before = first - start_;
+
+					if (count == 0)
+						return (first);
+					if (elems_before < (static_cast<difference_type>(size()) - count) / 2)
+					{
+						iterator	src = first;
+						iterator	dest = last;
+
+						while (src != start_)
+							*--dest = *--src;
+						for (; count != 0; --count)
+							pop_front();
+					}
+					else
+					{
+						iterator	dest = first;
+
+						for (iterator src = last; src != finish_; ++src, ++dest)
+							*dest = *src;
+						for (; count != 0; --count)
+							pop_back();
+					}
+					return (start_ + elems_before);
+				}
+
+				void	push_back( const value_type& value )
+				{
+					if (finish_.cur != finish_.last - 1)
+					{
+						construct(finish_.cur, value);
+						++finish_.cur;
+					}
+					else
+					{	// last slot of the chunk: prepare the next chunk first
+						reserve_map_at_back();
+						*(finish_.node + 1) = allocate_chunk();
+						try
+						{
+							construct(finish_.cur, value);
+						}
+						catch (...)
+						{
+							deallocate_chunk(*(finish_.node + 1));
+							throw ;
+						}
+						finish_.set_node(finish_.node + 1);
+						finish_.cur = finish_.first;
+					}
+				}
+
+				void	push_front( const value_type& value )
+				{
+					if (start_.cur != start_.first)
+					{
+						construct(start_.cur - 1, value);
+						--start_.cur;
+					}
+					else
+					{
+						reserve_map_at_front();
+						*(start_.node - 1) = allocate_chunk();
+						try
+						{
+							construct(*(start_.node - 1) + deque_chunk_size_<T>() - 1, value);
+						}
+						catch (...)
+						{
+							deallocate_chunk(*(start_.node - 1));
+							throw ;
+						}
+						start_.set_node(start_.node - 1);
+						start_.cur = start_.last - 1;
+					}
+				}
+
+				void	pop_back()
+				{
+					if (finish_.cur != finish_.first)
+					{
+						--finish_.cur;
+						destroy(finish_.cur);
+					}
+					else
+					{
+						deallocate_chunk(finish_.first);
+						finish_.set_node(finish_.node - 1);
+						finish_.cur = finish_.last - 1;
+						destroy(finish_.cur);
+					}
+				}
+
+				void	pop_front()
+				{
+					if (start_.cur != start_.last - 1)
+					{
+						destroy(start_.cur);
+						++start_.cur;
+					}
+					else
+					{
+						destroy(start_.cur);
+						deallocate_chunk(start_.first);
+						start_.set_node(start_.node + 1);
+						start_.cur = start_.first;
+					}
+				}
+
+				void	resize( size_type count, value_type value = value_type() )
+				{
+					while (size() > count)
+						pop_back();
+					while (size() < count)
+						push_back(value);
+				}
+
+				void	swap( deque& other )
+				{
+					std::swap(alloc_(), other.alloc_());
+					std::swap(map_, other.map_);
+					std::swap(map_size_, other.map_size_);
+					std::swap(start_, other.start_);
+					std::swap(finish_, other.finish_);
+				}
+
+
+	private:
+		typedef typename Allocator::template rebind<T*>::other	map_allocator_type;
+		typedef T**												map_pointer;
+		typedef ft::ebo_holder_<Allocator>						alloc_holder_;
+
+		static const size_type	initial_map_size_ = 8;
+
+		map_pointer		map_;
+		size_type		map_size_;
+		iterator		start_;
+		iterator		finish_;
+
+			allocator_type&		alloc_()
+			{ return (alloc_holder_::get()); }
+
+			const allocator_type&	alloc_() const
+			{ return (alloc_holder_::get()); }
+
+			pointer		allocate_chunk()
+			{ return (alloc_().allocate(deque_chunk_size_<T>())); }
+
+			void	deallocate_chunk( pointer chunk )
+			{ alloc_().deallocate(chunk, deque_chunk_size_<T>()); }
+
+			map_pointer		allocate_map( size_type n )
+			{ return (map_allocator_type(alloc_()).allocate(n)); }
+
+			void	deallocate_map( map_pointer map, size_type n )
+			{ map_allocator_type(alloc_()).deallocate(map, n); }
+
+			void	construct( pointer ptr, const_reference value )
+			{ alloc_().construct(ptr, value); }
+
+			void	destroy( pointer ptr )
+			{ alloc_().destroy(ptr); }
+
+			// allocate the map, with the chunk pointers for count elements and one spare at each end
+			// (at least initial_map_size_), and one chunk at its center, where an empty deque starts
+			// half way; the next chunks are only allocated as elements are pushed
+			void	initialize_map( size_type count )
+			{
+				size_type	num_chunks = count / deque_chunk_size_<T>() + 1;
+
+				map_size_ = (num_chunks + 2 > initial_map_size_ ? num_chunks + 2 : initial_map_size_);
+				map_ = allocate_map(map_size_);
+
+				map_pointer		center = map_ + map_size_ / 2;
+				*center = allocate_chunk();
+				start_.set_node(center);
+				start_.cur = start_.first + (count == 0 ? deque_chunk_size_<T>() / 2 : 0);
+				finish_ = start_;
+			}
+
+			void	reserve_map_at_back()
+			{
+				if (finish_.node + 1 == map_ + map_size_)
+					reallocate_map(false);
+			}
+
+			void	reserve_map_at_front()
+			{
+				if (start_.node == map_)
+					reallocate_map(true);
+			}
+
+			// make room for one more chunk pointer at one end:
+			// recenter the chunk pointers when the map is less than half full, otherwise double it
+			void	reallocate_map( bool add_at_front )
+			{
+				size_type		old_num_nodes = finish_.node - start_.node + 1;
+				size_type		new_num_nodes = old_num_nodes + 1;
+				map_pointer		new_start;
+
+				if (map_size_ > 2 * new_num_nodes)
+				{
+					new_start = map_ + (map_size_ - new_num_nodes) / 2 + (add_at_front ? 1 : 0);
+					std::memmove(new_start, start_.node, old_num_nodes * sizeof(*map_));
+				}
+				else
+				{
+					size_type		new_map_size = map_size_ * 2 + 2;
+					map_pointer		new_map = allocate_map(new_map_size);
+
+					new_start = new_map + (new_map_size - new_num_nodes) / 2 + (add_at_front ? 1 : 0);
+					std::memcpy(new_start, start_.node, old_num_nodes * sizeof(*map_));
+					deallocate_map(map_, map_size_);
+					map_ = new_map;
+					map_size_ = new_map_size;
+				}
+				difference_type	start_offset = start_.cur - start_.first;
+				difference_type	finish_offset = finish_.cur - finish_.first;
+				start_.set_node(new_start);
+				start_.cur = start_.first + start_offset;
+				finish_.set_node(new_start + old_num_nodes - 1);
+				finish_.cur = finish_.first + finish_offset;
+			}
+
+			template< typename InputIt >
+			void	range_insert( iterator pos, InputIt first, InputIt last, ft::input_iterator_tag )
+			{
+				difference_type	index = pos - start_;
+				size_type		old_size = size();
+
+				for (; first != last; ++first)
+					push_back(*first);
+				rotate_(start_ + index, start_ + old_size, finish_);
+			}
+
+			template< typename ForwardIt >
+			void	range_insert( iterator pos, ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
+			{
+				difference_type	index = pos - start_;
+				size_type		old_size = size();
+				size_type		count = ft::distance(first, last);
+
+				if (count == 0)
+					return ;
+				if (static_cast<size_type>(index) < old_size / 2)
+				{
+					for (size_type i = 0; i < count; ++i)
+						push_front(*first);
+					for (iterator dest = start_; first != last; ++first, ++dest)
+						*dest = *first;
+					rotate_(start_, start_ + count, start_ + (count + index));
+				}
+				else
+				{
+					for (; first != last; ++first)
+						push_back(*first);
+					rotate_(start_ + index, start_ + old_size, finish_);
+				}
+			}
+
+			static void	reverse_( iterator first, iterator last )
+			{
+				while (first != last && first != --last)
+				{
+					std::swap(*first, *last);
+					++first;
+				}
+			}
+
+			// [first, middle, last) -> [middle, last, first)
+			static void	rotate_( iterator first, iterator middle, iterator last )
+			{
+				reverse_(first, middle);
+				reverse_(middle, last);
+				reverse_(first, last);
+			}
+
+};	// class deque
+
+
+// Non-member functions
+template< class T, class Alloc >
+bool	operator==( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return (lhs.size() == rhs.size()
+			&& ft::equal(lhs.begin(), lhs.end(), rhs.begin())); }
+
+template< class T, class Alloc >
+bool	operator!=( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return !(lhs == rhs); }
+
+template< class T, class Alloc >
+bool	operator<( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+										rhs.begin(), rhs.end())); }
+
+template< class T, class Alloc >
+bool	operator<=( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return !(rhs < lhs); }
+
+template< class T, class Alloc >
+bool	operator>( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return (rhs < lhs); }
+
+template< class T, class Alloc >
+bool	operator>=( const ft::deque<T,Alloc>& lhs,
+					const ft::deque<T,Alloc>& rhs )
+{ return !(lhs < rhs); }
+
+
+template< class T, class Alloc >
+void	swap( ft::deque<T,Alloc>& lhs,
+				ft::deque<T,Alloc>& rhs )
+{ lhs.swap(rhs); }
+
+
+}	// namespace ft
+
+#endif
@@ -0,0 +1,437 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   intrusive_map.hpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// intrusive_map: an ordered map over objects that embed their own tree links
+
+#ifndef INTRUSIVE_MAP_HPP
+# define INTRUSIVE_MAP_HPP
+
+# include <algorithm>
+# include <functional>
+
+# include "../utils/iterator.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/rb_tree.hpp"
+# include "../utils/util.hpp"
+
+namespace ft {
+
+/*
+	the user type embeds one rb_hook per tree it can be linked in:
+
+		struct	Session
+		{
+			int				id;
+			long			deadline;
+			ft::rb_hook		by_id;
+			ft::rb_hook		by_deadline;
+		};
+
+		ft::intrusive_map<int, Session, &Session::by_id, SessionId>			sessions;
+		ft::intrusive_map<long, Session, &Session::by_deadline, Deadline>	timeouts;
+
+	the map links the hooks with the rb_tree rebalancing (rb_tree_balance_),
+	so insert and erase never allocate and never copy the object.
+	an object must be erased (or the map cleared) before it is destroyed.
+*/
+
+// a tree node without a payload: value points back at the object that embeds the hook
+class	rb_hook : public rb_node_<void>
+{
+	public:
+		rb_hook()
+		{ unlink_(); }
+
+		// copying an object does not copy its place in a tree
+		rb_hook( const rb_hook& )
+		: rb_node_<void>()
+		{ unlink_(); }
+
+		rb_hook&	operator=( const rb_hook& )
+		{ return (*this); }
+
+		bool	is_linked() const
+		{ return (parent != NULL); }
+
+		void	unlink_()
+		{
+			parent = NULL;
+			left = NULL;
+			right = NULL;
+			color = RED;
+			value = NULL;
+		}
+};
+
+
+template< typename T, typename Ref, typename Ptr >
+class	intrusive_map_iterator_
+{
+	public:
+		typedef T									value_type;
+		typedef Ref									reference;
+		typedef Ptr									pointer;
+		typedef std::ptrdiff_t						difference_type;
+		typedef ft::bidirectional_iterator_tag		iterator_category;
+
+		typedef rb_node_<void>*		link_type;
+
+	private:
+		typedef intrusive_map_iterator_<T, Ref, Ptr>	Self_;
+		typedef intrusive_map_iterator_<T, T&, T*>		iterator_;
+
+	public:
+		intrusive_map_iterator_()
+		: node(NULL)
+		{
+
+		}
+
+		explicit	intrusive_map_iterator_( link_type x )
+		: node(x)
+		{
+
+		}
+
+		intrusive_map_iterator_( const iterator_& other )
+		: node(other.node)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (*static_cast<T*>(node->value)); }
+
+		pointer		operator->() const
+		{ return (static_cast<T*>(node->value)); }
+
+		Self_&	operator++()
+		{
+			node = rb_tree_increment(node);
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			++*this;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			node = rb_tree_decrement(node);
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			--*this;
+			return (tmp);
+		}
+	// ~public:
+
+		link_type	node;
+
+};	// class intrusive_map_iterator_
+
+
+// Non-member functions (intrusive_map_iterator_)
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator==( const intrusive_map_iterator_<T, R1, P1>& lhs, const intrusive_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node == rhs.node); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator!=( const intrusive_map_iterator_<T, R1, P1>& lhs, const intrusive_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node != rhs.node); }
+
+
+// unique keys; KeyOfValue()(object) gives the key of an object
+template< class Key, class T, ft::rb_hook T::*Hook, class KeyOfValue, class Compare = std::less<Key> >
+class	intrusive_map : private ft::ebo_holder_<Compare>
+{
+	public:
+		// Member types
+			typedef Key				key_type;
+			typedef T				value_type;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+			typedef Compare			key_compare;
+
+			typedef value_type&			reference;
+			typedef const value_type&	const_reference;
+			typedef value_type*			pointer;
+			typedef const value_type*	const_pointer;
+
+			typedef intrusive_map_iterator_<T, T&, T*>				iterator;
+			typedef intrusive_map_iterator_<T, const T&, const T*>	const_iterator;
+			typedef ft::reverse_iterator<iterator>					reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+	private:
+		typedef rb_node_<void>*					link_type;
+		typedef rb_tree_balance_<void>			balance_type_;
+		typedef ft::ebo_holder_<Compare>		compare_holder_;
+
+	public:
+		// Constructors and canonical
+			intrusive_map()
+			: compare_holder_(), size_(0)
+			{ initialize_(); }
+
+			explicit	intrusive_map( const Compare& comp )
+			: compare_holder_(comp), size_(0)
+			{ initialize_(); }
+
+			// the objects stay where they are, only their hooks are reset
+			~intrusive_map()
+			{ clear(); }
+
+		// Iterators
+			iterator	begin()
+			{ return (iterator(header_.parent)); }
+
+			const_iterator	begin() const
+			{ return (const_iterator(header_.parent)); }
+
+			iterator	end()
+			{ return (iterator(end_())); }
+
+			const_iterator	end() const
+			{ return (const_iterator(end_())); }
+
+			reverse_iterator	rbegin()
+			{ return (reverse_iterator(end())); }
+
+			const_reverse_iterator	rbegin() const
+			{ return (const_reverse_iterator(end())); }
+
+			reverse_iterator	rend()
+			{ return (reverse_iterator(begin())); }
+
+			const_reverse_iterator	rend() const
+			{ return (const_reverse_iterator(begin())); }
+
+			// iterator to an object linked in this map, without a lookup
+			iterator	iterator_to( T& object )
+			{ return (iterator(&(object.*Hook))); }
+
+			const_iterator	iterator_to( const T& object ) const
+			{ return (const_iterator(const_cast<rb_hook*>(&(object.*Hook)))); }
+
+		// Capacity
+			bool	empty() const
+			{ return (size_ == 0); }
+
+			size_type	size() const
+			{ return (size_); }
+
+		// Modifiers
+			// unlinks every object; O(size)
+			void	clear()
+			{
+				clear_process_(header_.left);
+				initialize_();
+			}
+
+			// links object unless its key is already present. object must not be linked by Hook yet
+			ft::pair<iterator, bool>	insert( T& object )
+			{
+				link_type	parent = end_();
+				link_type	current_node = header_.left;
+				bool		insert_left = true;
+				const Key&	key = KeyOfValue()(object);
+
+				while (current_node)
+				{
+					parent = current_node;
+					if (key_compare_(key, key_(current_node)))
+					{
+						insert_left = true;
+						current_node = current_node->left;
+					}
+					else if (key_compare_(key_(current_node), key))
+					{
+						insert_left = false;
+						current_node = current_node->right;
+					}
+					else
+						return (ft::make_pair(iterator(current_node), false));
+				}
+
+				rb_hook&	hook = object.*Hook;
+
+				hook.value = &object;
+				balance_type_::linkNode(end_(), &hook, parent, insert_left);
+				++size_;
+				return (ft::make_pair(iterator(&hook), true));
+			}
+
+			void	erase( iterator pos )
+			{
+				link_type	node = pos.node;
+
+				if (node == header_.parent)
+					header_.parent = rb_tree_increment(node);
+				balance_type_::unlinkNode(end_(), node);
+				static_cast<rb_hook*>(node)->unlink_();
+				--size_;
+			}
+
+			void	erase( iterator first, iterator last )
+			{
+				while (first != last)
+					erase(first++);
+			}
+
+			void	erase( T& object )
+			{ erase(iterator_to(object)); }
+
+			size_type	erase( const Key& key )
+			{
+				iterator	it = find(key);
+
+				if (it == end())
+					return (0);
+				erase(it);
+				return (1);
+			}
+
+			void	swap( intrusive_map& other )
+			{
+				std::swap(header_.left, other.header_.left);
+				std::swap(header_.parent, other.header_.parent);
+				std::swap(size_, other.size_);
+				std::swap(compare_holder_::get(), other.compare_holder_::get());
+				relink_header_();
+				other.relink_header_();
+			}
+
+		// Lookup
+			size_type	count( const Key& key ) const
+			{ return (find(key) != end()); }
+
+			iterator	find( const Key& key )
+			{
+				iterator	it = lower_bound(key);
+
+				if (it == end() || key_compare_(key, key_(it.node)))
+					return (end());
+				return (it);
+			}
+
+			const_iterator	find( const Key& key ) const
+			{ return (const_cast<intrusive_map*>(this)->find(key)); }
+
+			iterator	lower_bound( const Key& key )
+			{
+				link_type	x = header_.left;
+				link_type	y = end_();
+
+				while (x)
+				{
+					if (!key_compare_(key_(x), key))
+					{
+						y = x;
+						x = x->left;
+					}
+					else
+						x = x->right;
+				}
+				return (iterator(y));
+			}
+
+			const_iterator	lower_bound( const Key& key ) const
+			{ return (const_cast<intrusive_map*>(this)->lower_bound(key)); }
+
+			iterator	upper_bound( const Key& key )
+			{
+				link_type	x = header_.left;
+				link_type	y = end_();
+
+				while (x)
+				{
+					if (key_compare_(key, key_(x)))
+					{
+						y = x;
+						x = x->left;
+					}
+					else
+						x = x->right;
+				}
+				return (iterator(y));
+			}
+
+			const_iterator	upper_bound( const Key& key ) const
+			{ return (const_cast<intrusive_map*>(this)->upper_bound(key)); }
+
+		// Observers
+			key_compare	key_comp() const
+			{ return (compare_holder_::get()); }
+
+	private:
+		// not copyable: the objects can be linked in one map per hook
+		intrusive_map( const intrusive_map& );
+		intrusive_map&	operator=( const intrusive_map& );
+
+		// Member objects
+			// DUMMY node of rb_tree: left is the root, parent is begin, right is itself
+			rb_node_<void>	header_;
+			size_type		size_;
+
+			link_type	end_() const
+			{ return (const_cast<link_type>(&header_)); }
+
+			void	initialize_()
+			{
+				header_.color = rb_node_<void>::RED;
+				header_.left = NULL;
+				header_.parent = end_();
+				header_.right = end_();
+				header_.value = NULL;
+				size_ = 0;
+			}
+
+			void	relink_header_()
+			{
+				if (header_.left)
+					header_.left->parent = end_();
+				else
+					header_.parent = end_();
+			}
+
+			void	clear_process_( link_type node )
+			{
+				while (node)
+				{
+					clear_process_(node->right);
+					link_type	tmp = node->left;
+					static_cast<rb_hook*>(node)->unlink_();
+					node = tmp;
+				}
+			}
+
+			bool	key_compare_( const Key& lhs, const Key& rhs ) const
+			{ return (compare_holder_::get()(lhs, rhs)); }
+
+			static Key	key_( link_type x )
+			{ return (KeyOfValue()(*static_cast<const T*>(x->value))); }
+
+};	// class intrusive_map
+
+
+}	// namespace ft
+
+#endif
@@ -0,0 +1,398 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   mmap_vector.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// vector whose storage is a memory-mapped file (linux only: uses mremap)
+//  file layout:	[header (data_offset_ bytes)][elements ...]
+//  the file length is the capacity. reopening an existing file maps it as it is,
+//  so there is no parsing and no copy. T must be trivially copyable.
+
+#ifndef MMAP_VECTOR_HPP
+# define MMAP_VECTOR_HPP
+
+# include <cerrno>
+# include <cstring>
+# include <limits>
+# include <new>
+# include <stdexcept>
+# include <string>
+
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+
+# include "../utils/algorithm.hpp"
+# include "../utils/iterator.hpp"
+# include "../utils/random_access_iterator.hpp"
+# include "../utils/type_traits.hpp"
+
+namespace ft {
+
+
+template< typename T >
+class	mmap_vector
+{
+	public:
+		// Member types
+			typedef	T				value_type;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			typedef value_type&			reference;
+			typedef const value_type&	const_reference;
+			typedef value_type*			pointer;
+			typedef const value_type*	const_pointer;
+
+			typedef typename ft::random_access_iterator<value_type>			iterator;
+			typedef typename ft::random_access_iterator<const value_type>	const_iterator;
+			typedef ft::reverse_iterator<iterator>							reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>					const_reverse_iterator;
+
+	private:
+		// elements are written to the file as raw bytes
+		typedef char	value_type_must_be_trivially_copyable_[ft::is_trivially_copyable<T>::value ? 1 : -1];
+
+	public:
+		// Member functions
+			// constructors and canonical
+				mmap_vector()
+				: fd_(-1), map_(NULL), map_size_(0), first_(NULL), last_(NULL), reserved_last_(NULL)
+				{
+
+				}
+
+				explicit	mmap_vector( const char* path )
+				: fd_(-1), map_(NULL), map_size_(0), first_(NULL), last_(NULL), reserved_last_(NULL)
+				{
+					open(path);
+				}
+
+				~mmap_vector()
+				{
+					close();
+				}
+
+			// File
+				// map path (created if it does not exist)
+				void	open( const char* path )
+				{
+					struct stat	st;
+					bool		created;
+
+					close();
+					fd_ = ::open(path, O_RDWR | O_CREAT, 0644);
+					if (fd_ < 0)
+						fail_("mmap_vector::open: open");
+					if (::fstat(fd_, &st) != 0)
+						fail_("mmap_vector::open: fstat");
+
+					created = (st.st_size == 0);
+					map_size_ = st.st_size;
+					if (created)
+					{
+						map_size_ = file_size_(initial_capacity_());
+						if (::ftruncate(fd_, map_size_) != 0)
+							fail_("mmap_vector::open: ftruncate");
+					}
+					else if (map_size_ < data_offset_)
+						fail_("mmap_vector::open: broken file", EINVAL);
+
+					map_ = ::mmap(NULL, map_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+					if (map_ == MAP_FAILED)
+					{
+						map_ = NULL;
+						fail_("mmap_vector::open: mmap");
+					}
+
+					if (created)
+					{
+						std::memcpy(header_()->magic, magic_(), sizeof(header_()->magic));
+						header_()->value_size = sizeof(value_type);
+						header_()->size = 0;
+					}
+					else if (std::memcmp(header_()->magic, magic_(), sizeof(header_()->magic)) != 0
+							|| header_()->value_size != sizeof(value_type)
+							|| header_()->size > capacity_of_(map_size_))
+						fail_("mmap_vector::open: broken file", EINVAL);
+					set_pointers_(header_()->size);
+				}
+
+				// write the size to the header and unmap (the file is kept)
+				void	close()
+				{
+					if (map_ != NULL)
+					{
+						header_()->size = size();
+						::munmap(map_, map_size_);
+						map_ = NULL;
+						map_size_ = 0;
+					}
+					if (fd_ >= 0)
+						::close(fd_);
+					fd_ = -1;
+					first_ = last_ = reserved_last_ = NULL;
+				}
+
+				// write the mapped data back to the file synchronously
+				void	flush()
+				{
+					if (map_ == NULL)
+						return ;
+					header_()->size = size();
+					if (::msync(map_, map_size_, MS_SYNC) != 0)
+						throw std::runtime_error(std::string("mmap_vector::flush: msync: ") + std::strerror(errno));
+				}
+
+				bool	is_open() const
+				{ return (map_ != NULL); }
+
+			// Element access
+				reference	at( size_type pos )
+				{
+					if (pos >= size())
+						throw std::out_of_range("mmap_vector::at: out_of_range: pos >= this->size()");
+					return (first_[pos]);
+				}
+
+				const_reference		at( size_type pos ) const
+				{
+					if (pos >= size())
+						throw std::out_of_range("mmap_vector::at: out_of_range: pos >= this->size()");
+					return (first_[pos]);
+				}
+
+				reference	operator[]( size_type pos )
+				{ return (first_[pos]); }
+
+				const_reference		operator[]( size_type pos ) const
+				{ return (first_[pos]); }
+
+				reference	front()
+				{ return (*first_); }
+
+				const_reference		front() const
+				{ return (*first_); }
+
+				reference	back()
+				{ return (*(last_ - 1)); }
+
+				const_reference		back() const
+				{ return (*(last_ - 1)); }
+
+				value_type*		data()
+				{ return (first_); }
+
+				const value_type*	data() const
+				{ return (first_); }
+
+			// Iterators
+				iterator	begin()
+				{ return (first_); }
+
+				const_iterator	begin() const
+				{ return (first_); }
+
+				iterator	end()
+				{ return (last_); }
+
+				const_iterator	end() const
+				{ return (last_); }
+
+				reverse_iterator	rbegin()
+				{ return (reverse_iterator(last_)); }
+
+				const_reverse_iterator	rbegin() const
+				{ return (const_reverse_iterator(last_)); }
+
+				reverse_iterator	rend()
+				{ return (reverse_iterator(first_)); }
+
+				const_reverse_iterator	rend() const
+				{ return (const_reverse_iterator(first_)); }
+
+			// Capacity
+				bool	empty() const
+				{ return (first_ == last_); }
+
+				size_type	size() const
+				{ return size_type(last_ - first_); }
+
+				size_type	max_size() const
+				{ return (static_cast<size_type>(std::numeric_limits<difference_type>::max() - data_offset_) / sizeof(value_type)); }
+
+				// grow the file with ftruncate and remap it with mremap (the mapping may move)
+				void	reserve( size_type new_cap )
+				{
+					if (new_cap <= capacity())
+						return ;
+					if (map_ == NULL)
+						throw std::logic_error("mmap_vector::reserve: file is not opened");
+					if (new_cap > max_size())
+						throw std::length_error("mmap_vector::reserve: length_error: new_cap > max_size()");
+
+					size_type	old_size = size();
+					size_type	new_map_size = file_size_(new_cap);
+
+					if (::ftruncate(fd_, new_map_size) != 0)
+						throw std::runtime_error(std::string("mmap_vector::reserve: ftruncate: ") + std::strerror(errno));
+					void*	new_map = ::mremap(map_, map_size_, new_map_size, MREMAP_MAYMOVE);
+					if (new_map == MAP_FAILED)
+						throw std::runtime_error(std::string("mmap_vector::reserve: mremap: ") + std::strerror(errno));
+					map_ = new_map;
+					map_size_ = new_map_size;
+					set_pointers_(old_size);
+				}
+
+				size_type	capacity() const
+				{ return size_type(reserved_last_ - first_); }
+
+			// Modifiers
+				void	clear()
+				{ last_ = first_; }
+
+				void	push_back( const_reference value )
+				{
+					if (last_ == reserved_last_)
+					{
+						value_type	copy = value;	// value may live in the mapping
+
+						reserve(calc_new_capacity(size() + 1));
+						::new (static_cast<void*>(last_)) value_type(copy);
+					}
+					else
+						::new (static_cast<void*>(last_)) value_type(value);
+					++last_;
+				}
+
+				void	pop_back()
+				{ --last_; }
+
+				void	resize( size_type count, value_type value = value_type() )
+				{
+					if (count > capacity())
+						reserve(count);
+					if (count > size())
+						last_ = ft::uninitialized_fill_n(last_, count - size(), value);
+					else
+						last_ = first_ + count;
+				}
+
+
+	private:
+		struct	header_type_
+		{
+			char		magic[8];
+			size_type	value_size;
+			size_type	size;
+		};
+
+		static const size_type	data_offset_ = 64;	// header size, keeps elements cache line aligned
+
+		int			fd_;
+		void*		map_;
+		size_type	map_size_;
+		pointer		first_;
+		pointer		last_;
+		pointer		reserved_last_;
+
+		// not copyable: the mapping has only one owner
+		mmap_vector( const mmap_vector& );
+		mmap_vector&	operator=( const mmap_vector& );
+
+			static const char*	magic_()
+			{ return ("ftmmvec"); }
+
+			header_type_*	header_()
+			{ return (static_cast<header_type_*>(map_)); }
+
+			static size_type	file_size_( size_type cap )
+			{ return (data_offset_ + cap * sizeof(value_type)); }
+
+			static size_type	capacity_of_( size_type file_size )
+			{ return ((file_size - data_offset_) / sizeof(value_type)); }
+
+			static size_type	initial_capacity_()
+			{
+				size_type	page_size = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+				size_type	cap = capacity_of_(page_size);
+
+				return (cap == 0 ? 1 : cap);
+			}
+
+			void	set_pointers_( size_type size )
+			{
+				first_ = reinterpret_cast<pointer>(static_cast<char*>(map_) + data_offset_);
+				last_ = first_ + size;
+				reserved_last_ = first_ + capacity_of_(map_size_);
+			}
+
+			// only when (_require_cap > current_cap)
+			size_type	calc_new_capacity( size_type _require_cap ) const
+			{
+				size_type	_current_cap = capacity();
+				size_type	_max_size = max_size();
+
+				if (_require_cap > _max_size)
+					throw std::length_error("mmap_vector::reserve: length_error: new_cap > max_size()");
+				if (_current_cap > _require_cap / 2)
+					return (_current_cap <= _max_size / 2 ? _current_cap * 2 : _max_size);
+				return (_require_cap);
+			}
+
+			void	fail_( const char* what, int err = 0 )
+			{
+				if (err == 0)
+					err = errno;
+				if (map_ != NULL)	// unmapped first: close() must not write the header of a file refused
+				{
+					::munmap(map_, map_size_);
+					map_ = NULL;
+					map_size_ = 0;
+				}
+				close();
+				throw std::runtime_error(std::string(what) + ": " + std::strerror(err));
+			}
+
+};	// class mmap_vector
+
+
+// Non-member functions
+template< class T >
+bool	operator==( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return (lhs.size() == rhs.size()
+			&& ft::equal(lhs.begin(), lhs.end(), rhs.begin())); }
+
+template< class T >
+bool	operator!=( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return !(lhs == rhs); }
+
+template< class T >
+bool	operator<( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+										rhs.begin(), rhs.end())); }
+
+template< class T >
+bool	operator<=( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return !(rhs < lhs); }
+
+template< class T >
+bool	operator>( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return (rhs < lhs); }
+
+template< class T >
+bool	operator>=( const ft::mmap_vector<T>& lhs, const ft::mmap_vector<T>& rhs )
+{ return !(lhs < rhs); }
+
+
+}	// namespace ft
+
+#endif
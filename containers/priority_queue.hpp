@@ -0,0 +1,349 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   priority_queue.hpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// priority_queue:	https://en.cppreference.com/w/cpp/container/priority_queue
+//
+//	d-ary heap (Arity children per node, 4 by default). a wider node makes the heap shallower:
+//	sift down compares the Arity children, which are contiguous in memory (one cache line
+//	for small T), so there are fewer cache misses per level than with a binary heap.
+//	node i:	parent (i - 1) / Arity,	children Arity * i + 1 ... Arity * i + Arity
+
+#ifndef PRIORITY_QUEUE_HPP
+# define PRIORITY_QUEUE_HPP
+
+# include <functional>
+# include <stdexcept>
+
+# include "../utils/iterator.hpp"
+# include "./vector.hpp"
+
+namespace ft {
+
+
+// heap helpers: move value up from the hole, the hole is filled at the end
+template< std::size_t Arity, class RandomIt, class Compare >
+void	dary_sift_up_( RandomIt first, std::size_t hole,
+						typename ft::iterator_traits<RandomIt>::value_type value, Compare comp )
+{
+	while (hole > 0)
+	{
+		std::size_t	parent = (hole - 1) / Arity;
+
+		if (!comp(first[parent], value))
+			break ;
+		first[hole] = first[parent];
+		hole = parent;
+	}
+	first[hole] = value;
+}
+
+template< std::size_t Arity, class RandomIt, class Compare >
+void	dary_sift_down_( RandomIt first, std::size_t len, std::size_t hole,
+							typename ft::iterator_traits<RandomIt>::value_type value, Compare comp )
+{
+	while (true)
+	{
+		std::size_t	child = Arity * hole + 1;
+
+		if (child >= len)
+			break ;
+		std::size_t	last_child = (child + Arity < len ? child + Arity : len);
+		std::size_t	best = child;
+		for (++child; child < last_child; ++child)
+			if (comp(first[best], first[child]))
+				best = child;
+		if (!comp(value, first[best]))
+			break ;
+		first[hole] = first[best];
+		hole = best;
+	}
+	first[hole] = value;
+}
+
+// O(n): sift down every internal node, from the last one
+template< std::size_t Arity, class RandomIt, class Compare >
+void	dary_make_heap_( RandomIt first, RandomIt last, Compare comp )
+{
+	std::size_t	len = last - first;
+
+	if (len < 2)
+		return ;
+	for (std::size_t i = (len - 2) / Arity + 1; i-- > 0; )
+		dary_sift_down_<Arity>(first, len, i, first[i], comp);
+}
+
+
+template< class T, class Container = ft::vector<T>,
+			class Compare = std::less<typename Container::value_type>, std::size_t Arity = 4 >
+class	priority_queue
+{
+	public:
+		// Member types
+			typedef Container								container_type;
+			typedef Compare									value_compare;
+			typedef typename Container::value_type			value_type;
+			typedef typename Container::size_type			size_type;
+			typedef typename Container::reference			reference;
+			typedef typename Container::const_reference		const_reference;
+
+		// Member functions
+			// Constructors and canonical
+				explicit	priority_queue( const Compare& compare = Compare(),
+											const Container& cont = Container() )
+				: c(cont), comp(compare)
+				{
+					dary_make_heap_<Arity>(c.begin(), c.end(), comp);
+				}
+
+				template< class InputIt >
+				priority_queue( InputIt first, InputIt last,
+								const Compare& compare = Compare(),
+								const Container& cont = Container() )
+				: c(cont), comp(compare)
+				{
+					c.insert(c.end(), first, last);
+					dary_make_heap_<Arity>(c.begin(), c.end(), comp);
+				}
+
+				priority_queue( const priority_queue& other )
+				: c(other.c), comp(other.comp)
+				{
+
+				}
+
+				~priority_queue()
+				{
+
+				}
+
+				priority_queue&		operator=( const priority_queue& other )
+				{
+					if (this == &other)
+						return (*this);
+
+					c = other.c;
+					comp = other.comp;
+					return (*this);
+				}
+
+			// Element access
+				const_reference		top() const
+				{ return (c.front()); }
+
+			// Capacity
+				bool	empty() const
+				{ return (c.empty()); }
+
+				size_type	size() const
+				{ return (c.size()); }
+
+			// Modifiers
+				void	push( const value_type& value )
+				{
+					c.push_back(value);
+					dary_sift_up_<Arity>(c.begin(), c.size() - 1, c.back(), comp);
+				}
+
+				// move the last element to the root, and sift it down
+				void	pop()
+				{
+					value_type	last = c.back();
+
+					c.pop_back();
+					if (!c.empty())
+						dary_sift_down_<Arity>(c.begin(), c.size(), 0, last, comp);
+				}
+
+	protected:
+		container_type	c;
+		value_compare	comp;
+
+};	// class priority_queue
+
+
+// priority queue whose elements are addressed by a handle returned from push(),
+// for decrease_key / erase of any element (e.g. timers). O(log n) for both.
+//	values_[handle]: value, pos_[handle]: its place in heap_ (npos when not in the queue)
+template< class T, class Compare = std::less<T>, std::size_t Arity = 4 >
+class	indexed_priority_queue
+{
+	public:
+		// Member types
+			typedef T				value_type;
+			typedef Compare			value_compare;
+			typedef std::size_t		size_type;
+			typedef std::size_t		handle_type;
+
+			typedef const value_type&	const_reference;
+
+			static const size_type	npos = static_cast<size_type>(-1);
+
+		// Member functions
+			// Constructors and canonical
+				explicit	indexed_priority_queue( const Compare& compare = Compare() )
+				: comp(compare)
+				{
+
+				}
+
+			// Element access
+				const_reference		top() const
+				{ return (values_[heap_.front()]); }
+
+				handle_type		top_handle() const
+				{ return (heap_.front()); }
+
+				const_reference		value( handle_type handle ) const
+				{ return (values_[handle]); }
+
+				bool	contains( handle_type handle ) const
+				{ return (handle < pos_.size() && pos_[handle] != npos); }
+
+			// Capacity
+				bool	empty() const
+				{ return (heap_.empty()); }
+
+				size_type	size() const
+				{ return (heap_.size()); }
+
+			// Modifiers
+				// the handle stays valid until the element is popped or erased, then it is reused
+				handle_type		push( const value_type& value )
+				{
+					handle_type		handle;
+
+					if (free_handles_.empty())
+					{
+						handle = values_.size();
+						values_.push_back(value);
+						pos_.push_back(npos);
+					}
+					else
+					{
+						handle = free_handles_.back();
+						free_handles_.pop_back();
+						values_[handle] = value;
+					}
+					heap_.push_back(handle);
+					sift_up_(heap_.size() - 1, handle);
+					return (handle);
+				}
+
+				void	pop()
+				{ erase(heap_.front()); }
+
+				void	erase( handle_type handle )
+				{
+					if (!contains(handle))
+						throw std::out_of_range("indexed_priority_queue::erase: out_of_range: no such handle");
+
+					size_type		hole = pos_[handle];
+					handle_type		last = heap_.back();
+
+					heap_.pop_back();
+					pos_[handle] = npos;
+					free_handles_.push_back(handle);
+					if (hole < heap_.size())
+						fix_(hole, last);
+				}
+
+				// value must not be lower in priority than the current one: it only moves up
+				void	decrease_key( handle_type handle, const value_type& value )
+				{
+					if (!contains(handle))
+						throw std::out_of_range("indexed_priority_queue::decrease_key: out_of_range: no such handle");
+					values_[handle] = value;
+					sift_up_(pos_[handle], handle);
+				}
+
+				// any new value: moves up or down
+				void	update( handle_type handle, const value_type& value )
+				{
+					if (!contains(handle))
+						throw std::out_of_range("indexed_priority_queue::update: out_of_range: no such handle");
+					values_[handle] = value;
+					fix_(pos_[handle], handle);
+				}
+
+	protected:
+		ft::vector<handle_type>		heap_;
+		ft::vector<value_type>		values_;
+		ft::vector<size_type>		pos_;
+		ft::vector<handle_type>		free_handles_;
+		value_compare				comp;
+
+	private:
+			bool	less_( handle_type lhs, handle_type rhs ) const
+			{ return (comp(values_[lhs], values_[rhs])); }
+
+			void	place_( size_type pos, handle_type handle )
+			{
+				heap_[pos] = handle;
+				pos_[handle] = pos;
+			}
+
+			// put handle at hole, then move it to where it belongs
+			void	fix_( size_type hole, handle_type handle )
+			{
+				if (hole > 0 && less_(heap_[(hole - 1) / Arity], handle))
+					sift_up_(hole, handle);
+				else
+					sift_down_(hole, handle);
+			}
+
+			void	sift_up_( size_type hole, handle_type handle )
+			{
+				while (hole > 0)
+				{
+					size_type	parent = (hole - 1) / Arity;
+
+					if (!less_(heap_[parent], handle))
+						break ;
+					place_(hole, heap_[parent]);
+					hole = parent;
+				}
+				place_(hole, handle);
+			}
+
+			void	sift_down_( size_type hole, handle_type handle )
+			{
+				size_type	len = heap_.size();
+
+				while (true)
+				{
+					size_type	child = Arity * hole + 1;
+
+					if (child >= len)
+						break ;
+					size_type	last_child = (child + Arity < len ? child + Arity : len);
+					size_type	best = child;
+					for (++child; child < last_child; ++child)
+						if (less_(heap_[best], heap_[child]))
+							best = child;
+					if (!less_(handle, heap_[best]))
+						break ;
+					place_(hole, heap_[best]);
+					hole = best;
+				}
+				place_(hole, handle);
+			}
+
+};	// class indexed_priority_queue
+
+template< class T, class Compare, std::size_t Arity >
+const typename indexed_priority_queue<T, Compare, Arity>::size_type
+	indexed_priority_queue<T, Compare, Arity>::npos;
+
+
+}	// namespace ft
+
+#endif
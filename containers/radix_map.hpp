@@ -0,0 +1,1126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   radix_map.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// radix_map: an ordered map for integral keys on an adaptive radix tree
+// (Leis et al., "The Adaptive Radix Tree: ARTful Indexing for Main-Memory Databases")
+
+#ifndef RADIX_MAP_HPP
+# define RADIX_MAP_HPP
+
+# include <functional>
+# include <limits>
+# include <memory>
+# include <stdexcept>
+# ifdef __SSE2__
+#  include <emmintrin.h>
+# endif
+
+# include "../utils/algorithm.hpp"
+# include "../utils/iterator.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/type_traits.hpp"
+# include "../utils/util.hpp"
+
+namespace ft {
+
+/*
+	the key is turned into sizeof(Key) bytes that compare like the key
+	(big endian, sign bit flipped), and the tree branches on one byte per level.
+	inner nodes grow and shrink between 4, 16, 48 and 256 children,
+	and skip the levels where all their keys share the same byte (depth_ is absolute).
+
+		[node4 depth 0]
+		   |0x80       \0x81
+		[node16 depth 2]  (leaf 0x81000007)	<- bytes 1 of 0x80.. keys are all equal
+		 /     |     \
+	 (leaf) (leaf) (leaf)
+
+	leaves also form a doubly linked list in key order, closed by the sentinel of the map:
+	iteration never walks the tree, and lower_bound only has to find a neighbor.
+*/
+
+struct	radix_node_
+{
+	enum	{ LEAF, NODE4, NODE16, NODE48, NODE256 };
+
+	unsigned char	type;
+};
+
+struct	radix_inner_ : radix_node_
+{
+	unsigned char	depth;		// index of the byte this node branches on
+	unsigned short	count;
+	unsigned long	prefix;		// key bits of any leaf below: bytes [0, depth) are shared
+};
+
+struct	radix_node4_ : radix_inner_
+{
+	unsigned char	keys[4];	// sorted
+	radix_node_*	children[4];
+};
+
+struct	radix_node16_ : radix_inner_
+{
+	unsigned char	keys[16];	// sorted
+	radix_node_*	children[16];
+};
+
+struct	radix_node48_ : radix_inner_
+{
+	unsigned char	index[256];	// slot + 1 of the child, 0: no child
+	radix_node_*	children[48];
+};
+
+struct	radix_node256_ : radix_inner_
+{
+	radix_node_*	children[256];
+};
+
+struct	radix_leaf_base_ : radix_node_
+{
+	radix_leaf_base_*	prev;
+	radix_leaf_base_*	next;
+};
+
+template< typename Value >
+struct	radix_leaf_ : radix_leaf_base_
+{
+	unsigned long	bits;
+	Value			value;
+};
+
+
+template< typename T, typename Ref, typename Ptr >
+class	radix_map_iterator_
+{
+	public:
+		typedef T								value_type;
+		typedef Ref								reference;
+		typedef Ptr								pointer;
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::bidirectional_iterator_tag	iterator_category;
+
+	private:
+		typedef radix_map_iterator_<T, Ref, Ptr>	Self_;
+		typedef radix_map_iterator_<T, T&, T*>		iterator_;
+
+	public:
+		radix_map_iterator_()
+		: node(NULL)
+		{
+
+		}
+
+		explicit	radix_map_iterator_( radix_leaf_base_* x )
+		: node(x)
+		{
+
+		}
+
+		radix_map_iterator_( const iterator_& other )
+		: node(other.node)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (static_cast<radix_leaf_<T>*>(node)->value); }
+
+		pointer		operator->() const
+		{ return (&static_cast<radix_leaf_<T>*>(node)->value); }
+
+		Self_&	operator++()
+		{
+			node = node->next;
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			node = node->next;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			node = node->prev;
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			node = node->prev;
+			return (tmp);
+		}
+	// ~public:
+
+		radix_leaf_base_*	node;
+
+};	// class radix_map_iterator_
+
+
+// Non-member functions (radix_map_iterator_)
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator==( const radix_map_iterator_<T, R1, P1>& lhs, const radix_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node == rhs.node); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator!=( const radix_map_iterator_<T, R1, P1>& lhs, const radix_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node != rhs.node); }
+
+
+// same interface as ft::map, ordered by the value of the key (no Compare)
+template< class Key, class T, class Allocator = std::allocator<ft::pair<const Key, T> > >
+class	radix_map
+: private ft::ebo_holder_<Allocator, 0>
+{
+	public:
+		// Member types
+			typedef Key						key_type;
+			typedef T						mapped_type;
+			typedef ft::pair<const Key, T>	value_type;
+			typedef std::size_t				size_type;
+			typedef std::ptrdiff_t			difference_type;
+			typedef std::less<Key>			key_compare;
+			typedef Allocator				allocator_type;
+
+			typedef value_type&					reference;
+			typedef const value_type&			const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+			typedef radix_map_iterator_<value_type, value_type&, value_type*>				iterator;
+			typedef radix_map_iterator_<value_type, const value_type&, const value_type*>	const_iterator;
+			typedef ft::reverse_iterator<iterator>											reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>									const_reverse_iterator;
+
+	private:
+		typedef unsigned long				bits_type;
+		typedef radix_leaf_<value_type>		leaf_type_;
+
+		typedef ft::ebo_holder_<Allocator, 0>	alloc_holder_;	// an empty allocator takes no space
+
+		typedef char	key_must_be_integral_[ft::is_integral<Key>::value ? 1 : -1];
+		typedef char	key_must_fit_in_bits_type_[sizeof(Key) <= sizeof(bits_type) ? 1 : -1];
+
+		static const unsigned	key_bytes_ = sizeof(Key);
+
+	public:
+		// Member classes
+		class	value_compare : public std::binary_function<value_type, value_type, bool>
+		{
+			public:
+				// Friend classes
+					friend class	radix_map<Key, T, Allocator>;
+
+				// Constructors and canonical
+					value_compare( key_compare c )
+					: comp(c)
+					{
+
+					}
+
+					bool	operator()( const value_type& lhs, const value_type& rhs ) const
+					{ return (comp(lhs.first, rhs.first)); }
+
+			protected:
+				// Protected member objects
+					key_compare		comp;
+
+		};	// class value_compare
+
+		// Constructors and canonical
+			radix_map()
+			: alloc_holder_(), root_(NULL), size_(0)
+			{ initialize_(); }
+
+			explicit	radix_map( const Allocator& alloc )
+			: alloc_holder_(alloc), root_(NULL), size_(0)
+			{ initialize_(); }
+
+			template< class InputIt >
+			radix_map( InputIt first, InputIt last,
+						const Allocator& alloc = Allocator(),
+						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+			: alloc_holder_(alloc), root_(NULL), size_(0)
+			{
+				initialize_();
+				insert(first, last);
+			}
+
+			radix_map( const radix_map& other )
+			: alloc_holder_(other.alloc_()), root_(NULL), size_(0)
+			{
+				initialize_();
+				insert(other.begin(), other.end());
+			}
+
+			~radix_map()
+			{ clear(); }
+
+			radix_map&	operator=( const radix_map& other )
+			{
+				if (this == &other)
+					return (*this);
+				clear();
+				insert(other.begin(), other.end());
+				return (*this);
+			}
+
+			allocator_type	get_allocator() const
+			{ return (alloc_()); }
+
+		// Element access
+			T&	at( const Key& key )
+			{
+				iterator	i = find(key);
+				if (i == end())
+					throw std::out_of_range("radix_map::at: out_of_range: no such key");
+				return (i->second);
+			}
+
+			const T&	at( const Key& key ) const
+			{
+				const_iterator	i = find(key);
+				if (i == end())
+					throw std::out_of_range("radix_map::at: out_of_range: no such key");
+				return (i->second);
+			}
+
+			T&	operator[]( const Key& key )
+			{
+				leaf_type_*	leaf = find_leaf_(to_bits_(key));
+
+				if (leaf)
+					return (leaf->value.second);
+				return (insert(value_type(key, mapped_type())).first->second);
+			}
+
+		// Iterators
+			iterator	begin()
+			{ return (iterator(sentinel_.next)); }
+
+			const_iterator	begin() const
+			{ return (const_iterator(sentinel_.next)); }
+
+			iterator	end()
+			{ return (iterator(end_())); }
+
+			const_iterator	end() const
+			{ return (const_iterator(end_())); }
+
+			reverse_iterator	rbegin()
+			{ return (reverse_iterator(end())); }
+
+			const_reverse_iterator	rbegin() const
+			{ return (const_reverse_iterator(end())); }
+
+			reverse_iterator	rend()
+			{ return (reverse_iterator(begin())); }
+
+			const_reverse_iterator	rend() const
+			{ return (const_reverse_iterator(begin())); }
+
+		// Capacity
+			bool	empty() const
+			{ return (size_ == 0); }
+
+			size_type	size() const
+			{ return (size_); }
+
+			size_type	max_size() const
+			{
+				typename Allocator::template rebind<leaf_type_>::other	leaf_alloc(alloc_());
+
+				return (leaf_alloc.max_size());
+			}
+
+		// Modifiers
+			void	clear()
+			{
+				destroy_tree_(root_);
+				initialize_();
+			}
+
+			ft::pair<iterator, bool>	insert( const value_type& value )
+			{
+				const bits_type		bits = to_bits_(value.first);
+				radix_leaf_base_*	next = lower_bound_(bits);
+
+				if (next != end_() && leaf_(next)->bits == bits)
+					return (ft::make_pair(iterator(next), false));
+
+				leaf_type_*		leaf = create_leaf_(value, bits);
+
+				// into the tree first: insert_leaf_ changes nothing when an allocation throws
+				try
+				{
+					insert_leaf_(leaf);
+				}
+				catch (...)
+				{
+					destroy_leaf_(leaf);
+					throw ;
+				}
+				leaf->next = next;
+				leaf->prev = next->prev;
+				next->prev->next = leaf;
+				next->prev = leaf;
+				++size_;
+				return (ft::make_pair(iterator(leaf), true));
+			}
+
+			iterator	insert( iterator hint, const value_type& value )
+			{
+				(void)hint;
+				return (insert(value).first);
+			}
+
+			template< class InputIt >
+			void	insert( InputIt first, InputIt last,
+							typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL)
+			{
+				for (InputIt head = first; head != last; ++head)
+					insert(*head);
+			}
+
+			void	erase( iterator pos )
+			{
+				leaf_type_*		leaf = leaf_(pos.node);
+
+				erase_leaf_(leaf->bits);
+				leaf->prev->next = leaf->next;
+				leaf->next->prev = leaf->prev;
+				destroy_leaf_(leaf);
+				--size_;
+			}
+
+			void	erase( iterator first, iterator last )
+			{
+				if (first == begin() && last == end())
+					clear();
+				else
+					while (first != last)
+						erase(first++);
+			}
+
+			size_type	erase( const Key& key )
+			{
+				iterator	it = find(key);
+
+				if (it == end())
+					return (0);
+				erase(it);
+				return (1);
+			}
+
+			void	swap( radix_map& other )
+			{
+				std::swap(root_, other.root_);
+				std::swap(size_, other.size_);
+				std::swap(alloc_holder_::get(), other.alloc_holder_::get());
+				std::swap(sentinel_.prev, other.sentinel_.prev);
+				std::swap(sentinel_.next, other.sentinel_.next);
+				relink_sentinel_();
+				other.relink_sentinel_();
+			}
+
+		// Lookup
+			size_type	count( const Key& key ) const
+			{ return (find_leaf_(to_bits_(key)) != NULL); }
+
+			iterator	find( const Key& key )
+			{
+				leaf_type_*	leaf = find_leaf_(to_bits_(key));
+
+				return (leaf ? iterator(leaf) : end());
+			}
+
+			const_iterator	find( const Key& key ) const
+			{
+				leaf_type_*	leaf = find_leaf_(to_bits_(key));
+
+				return (leaf ? const_iterator(leaf) : end());
+			}
+
+			ft::pair<iterator,iterator>		equal_range( const Key& key )
+			{ return (ft::make_pair(lower_bound(key), upper_bound(key))); }
+
+			ft::pair<const_iterator,const_iterator>		equal_range( const Key& key ) const
+			{ return (ft::make_pair(lower_bound(key), upper_bound(key))); }
+
+			iterator	lower_bound( const Key& key )
+			{ return (iterator(lower_bound_(to_bits_(key)))); }
+
+			const_iterator	lower_bound( const Key& key ) const
+			{ return (const_iterator(lower_bound_(to_bits_(key)))); }
+
+			iterator	upper_bound( const Key& key )
+			{ return (iterator(upper_bound_(to_bits_(key)))); }
+
+			const_iterator	upper_bound( const Key& key ) const
+			{ return (const_iterator(upper_bound_(to_bits_(key)))); }
+
+		// Observers
+			key_compare	key_comp() const
+			{ return (key_compare()); }
+
+			value_compare	value_comp() const
+			{ return (value_compare(key_compare())); }
+
+	private:
+		// Member objects
+			radix_node_*		root_;
+			size_type			size_;
+			radix_leaf_base_	sentinel_;	// end(): prev is the last leaf, next the first
+
+			Allocator&	alloc_()
+			{ return (alloc_holder_::get()); }
+
+			const Allocator&	alloc_() const
+			{ return (alloc_holder_::get()); }
+
+		// Keys
+			// bits compare as unsigned like the keys do: flip the sign bit of signed keys
+			static bits_type	to_bits_( Key key )
+			{
+				const bits_type	width_mask = ~bits_type(0) >> (8 * (sizeof(bits_type) - key_bytes_));
+				const bits_type	sign_bit = (Key(-1) < Key(0)) ? bits_type(1) << (8 * key_bytes_ - 1) : 0;
+
+				return ((static_cast<bits_type>(key) & width_mask) ^ sign_bit);
+			}
+
+			static unsigned char	byte_( bits_type bits, unsigned depth )
+			{ return (static_cast<unsigned char>(bits >> (8 * (key_bytes_ - 1 - depth)))); }
+
+			// index of the first byte that differs, key_bytes_ when equal
+			static unsigned		mismatch_( bits_type lhs, bits_type rhs )
+			{
+				const bits_type	diff = lhs ^ rhs;
+
+				if (diff == 0)
+					return (key_bytes_);
+				return ((__builtin_clzl(diff) - 8 * (sizeof(bits_type) - key_bytes_)) / 8);
+			}
+
+			static leaf_type_*	leaf_( radix_node_* node )
+			{ return (static_cast<leaf_type_*>(static_cast<radix_leaf_base_*>(node))); }
+
+			static leaf_type_*	leaf_( radix_leaf_base_* node )
+			{ return (static_cast<leaf_type_*>(node)); }
+
+			radix_leaf_base_*	end_() const
+			{ return (const_cast<radix_leaf_base_*>(&sentinel_)); }
+
+			void	initialize_()
+			{
+				root_ = NULL;
+				size_ = 0;
+				sentinel_.type = radix_node_::LEAF;
+				sentinel_.prev = end_();
+				sentinel_.next = end_();
+			}
+
+			void	relink_sentinel_()
+			{
+				if (size_ == 0)
+				{
+					sentinel_.prev = end_();
+					sentinel_.next = end_();
+				}
+				else
+				{
+					sentinel_.prev->next = end_();
+					sentinel_.next->prev = end_();
+				}
+			}
+
+		// Nodes
+			template< typename Node >
+			Node*	create_node_( unsigned char type, unsigned depth, bits_type prefix )
+			{
+				typename Allocator::template rebind<Node>::other	node_alloc(alloc_());
+				Node*	node = node_alloc.allocate(1);
+
+				node_alloc.construct(node, Node());
+				node->type = type;
+				node->depth = static_cast<unsigned char>(depth);
+				node->count = 0;
+				node->prefix = prefix;
+				return (node);
+			}
+
+			template< typename Node >
+			void	destroy_node_( radix_node_* node )
+			{
+				typename Allocator::template rebind<Node>::other	node_alloc(alloc_());
+
+				node_alloc.deallocate(static_cast<Node*>(node), 1);
+			}
+
+			void	destroy_inner_( radix_node_* node )
+			{
+				switch (node->type)
+				{
+					case radix_node_::NODE4:	destroy_node_<radix_node4_>(node); break;
+					case radix_node_::NODE16:	destroy_node_<radix_node16_>(node); break;
+					case radix_node_::NODE48:	destroy_node_<radix_node48_>(node); break;
+					default:					destroy_node_<radix_node256_>(node); break;
+				}
+			}
+
+			leaf_type_*	create_leaf_( const value_type& value, bits_type bits )
+			{
+				typename Allocator::template rebind<leaf_type_>::other	leaf_alloc(alloc_());
+				leaf_type_*		leaf = leaf_alloc.allocate(1);
+
+				leaf->type = radix_node_::LEAF;
+				leaf->bits = bits;
+				try
+				{
+					alloc_().construct(&leaf->value, value);
+				}
+				catch (...)
+				{
+					leaf_alloc.deallocate(leaf, 1);
+					throw ;
+				}
+				return (leaf);
+			}
+
+			void	destroy_leaf_( leaf_type_* leaf )
+			{
+				typename Allocator::template rebind<leaf_type_>::other	leaf_alloc(alloc_());
+
+				alloc_().destroy(&leaf->value);
+				leaf_alloc.deallocate(leaf, 1);
+			}
+
+			void	destroy_tree_( radix_node_* node )
+			{
+				if (node == NULL)
+					return ;
+				if (node->type == radix_node_::LEAF)
+				{
+					destroy_leaf_(leaf_(node));
+					return ;
+				}
+				unsigned	key = 0;
+
+				for (radix_node_* child = first_child_(node, 0, key); child;
+						child = first_child_(node, key + 1, key))
+					destroy_tree_(child);
+				destroy_inner_(node);
+			}
+
+		// Children
+			// slot of the child for key, NULL when there is none
+			static radix_node_**	find_child_( radix_node_* node, unsigned char key )
+			{
+				switch (node->type)
+				{
+					case radix_node_::NODE4:
+					{
+						radix_node4_*	n = static_cast<radix_node4_*>(node);
+						for (unsigned i = 0; i < n->count; ++i)
+							if (n->keys[i] == key)
+								return (&n->children[i]);
+						return (NULL);
+					}
+					case radix_node_::NODE16:
+					{
+						radix_node16_*	n = static_cast<radix_node16_*>(node);
+#ifdef __SSE2__
+						const __m128i	cmp = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(key)),
+											_mm_loadu_si128(reinterpret_cast<const __m128i*>(n->keys)));
+						const unsigned	mask = _mm_movemask_epi8(cmp) & ((1u << n->count) - 1);
+
+						return (mask ? &n->children[__builtin_ctz(mask)] : NULL);
+#else
+						for (unsigned i = 0; i < n->count; ++i)
+							if (n->keys[i] == key)
+								return (&n->children[i]);
+						return (NULL);
+#endif
+					}
+					case radix_node_::NODE48:
+					{
+						radix_node48_*	n = static_cast<radix_node48_*>(node);
+						return (n->index[key] ? &n->children[n->index[key] - 1] : NULL);
+					}
+					default:
+					{
+						radix_node256_*	n = static_cast<radix_node256_*>(node);
+						return (n->children[key] ? &n->children[key] : NULL);
+					}
+				}
+			}
+
+			// child with the smallest key >= key (stored in found), NULL when there is none
+			static radix_node_*	first_child_( radix_node_* node, unsigned key, unsigned& found )
+			{
+				switch (node->type)
+				{
+					case radix_node_::NODE4:
+					{
+						radix_node4_*	n = static_cast<radix_node4_*>(node);
+						for (unsigned i = 0; i < n->count; ++i)
+							if (n->keys[i] >= key)
+							{
+								found = n->keys[i];
+								return (n->children[i]);
+							}
+						return (NULL);
+					}
+					case radix_node_::NODE16:
+					{
+						radix_node16_*	n = static_cast<radix_node16_*>(node);
+						for (unsigned i = 0; i < n->count; ++i)
+							if (n->keys[i] >= key)
+							{
+								found = n->keys[i];
+								return (n->children[i]);
+							}
+						return (NULL);
+					}
+					case radix_node_::NODE48:
+					{
+						radix_node48_*	n = static_cast<radix_node48_*>(node);
+						for (; key < 256; ++key)
+							if (n->index[key])
+							{
+								found = key;
+								return (n->children[n->index[key] - 1]);
+							}
+						return (NULL);
+					}
+					default:
+					{
+						radix_node256_*	n = static_cast<radix_node256_*>(node);
+						for (; key < 256; ++key)
+							if (n->children[key])
+							{
+								found = key;
+								return (n->children[key]);
+							}
+						return (NULL);
+					}
+				}
+			}
+
+			// child with the largest key
+			static radix_node_*	last_child_( radix_node_* node )
+			{
+				switch (node->type)
+				{
+					case radix_node_::NODE4:
+					{
+						radix_node4_*	n = static_cast<radix_node4_*>(node);
+						return (n->children[n->count - 1]);
+					}
+					case radix_node_::NODE16:
+					{
+						radix_node16_*	n = static_cast<radix_node16_*>(node);
+						return (n->children[n->count - 1]);
+					}
+					case radix_node_::NODE48:
+					{
+						radix_node48_*	n = static_cast<radix_node48_*>(node);
+						for (unsigned key = 256; key-- > 0; )
+							if (n->index[key])
+								return (n->children[n->index[key] - 1]);
+						return (NULL);
+					}
+					default:
+					{
+						radix_node256_*	n = static_cast<radix_node256_*>(node);
+						for (unsigned key = 256; key-- > 0; )
+							if (n->children[key])
+								return (n->children[key]);
+						return (NULL);
+					}
+				}
+			}
+
+			// add a child for a key that is not present, growing the node (through ref) when full
+			void	add_child_( radix_node_** ref, unsigned char key, radix_node_* child )
+			{
+				radix_node_*	node = *ref;
+
+				switch (node->type)
+				{
+					case radix_node_::NODE4:
+					{
+						radix_node4_*	n = static_cast<radix_node4_*>(node);
+						if (n->count < 4)
+							return (add_sorted_(n->keys, n->children, n->count, key, child));
+						radix_node16_*	bigger = create_node_<radix_node16_>(radix_node_::NODE16, n->depth, n->prefix);
+						for (unsigned i = 0; i < 4; ++i)
+						{
+							bigger->keys[i] = n->keys[i];
+							bigger->children[i] = n->children[i];
+						}
+						bigger->count = 4;
+						add_sorted_(bigger->keys, bigger->children, bigger->count, key, child);
+						destroy_node_<radix_node4_>(node);
+						*ref = bigger;
+						return ;
+					}
+					case radix_node_::NODE16:
+					{
+						radix_node16_*	n = static_cast<radix_node16_*>(node);
+						if (n->count < 16)
+							return (add_sorted_(n->keys, n->children, n->count, key, child));
+						radix_node48_*	bigger = create_node_<radix_node48_>(radix_node_::NODE48, n->depth, n->prefix);
+						for (unsigned i = 0; i < 16; ++i)
+						{
+							bigger->index[n->keys[i]] = static_cast<unsigned char>(i + 1);
+							bigger->children[i] = n->children[i];
+						}
+						bigger->index[key] = 17;
+						bigger->children[16] = child;
+						bigger->count = 17;
+						destroy_node_<radix_node16_>(node);
+						*ref = bigger;
+						return ;
+					}
+					case radix_node_::NODE48:
+					{
+						radix_node48_*	n = static_cast<radix_node48_*>(node);
+						if (n->count < 48)
+						{
+							unsigned	slot = 0;
+							while (n->children[slot])
+								++slot;
+							n->children[slot] = child;
+							n->index[key] = static_cast<unsigned char>(slot + 1);
+							++n->count;
+							return ;
+						}
+						radix_node256_*	bigger = create_node_<radix_node256_>(radix_node_::NODE256, n->depth, n->prefix);
+						for (unsigned k = 0; k < 256; ++k)
+							if (n->index[k])
+								bigger->children[k] = n->children[n->index[k] - 1];
+						bigger->children[key] = child;
+						bigger->count = 49;
+						destroy_node_<radix_node48_>(node);
+						*ref = bigger;
+						return ;
+					}
+					default:
+					{
+						radix_node256_*	n = static_cast<radix_node256_*>(node);
+						n->children[key] = child;
+						++n->count;
+						return ;
+					}
+				}
+			}
+
+			static void	add_sorted_( unsigned char* keys, radix_node_** children, unsigned short& count,
+										unsigned char key, radix_node_* child )
+			{
+				unsigned	i = count;
+
+				for (; i > 0 && keys[i - 1] > key; --i)
+				{
+					keys[i] = keys[i - 1];
+					children[i] = children[i - 1];
+				}
+				keys[i] = key;
+				children[i] = child;
+				++count;
+			}
+
+			static void	remove_sorted_( unsigned char* keys, radix_node_** children, unsigned short& count,
+											unsigned char key )
+			{
+				unsigned	i = 0;
+
+				while (keys[i] != key)
+					++i;
+				for (--count; i < count; ++i)
+				{
+					keys[i] = keys[i + 1];
+					children[i] = children[i + 1];
+				}
+			}
+
+			// remove the child for key, shrinking the node (through ref) when it gets sparse:
+			// 256 -> 48 at 37 children, 48 -> 16 at 12, 16 -> 4 at 3, and a node4 with one child
+			// is replaced by that child (depth_ and prefix of the child do not depend on the parent).
+			// the smaller node is allocated before the key is removed: a throw leaves the node as it was
+			void	remove_child_( radix_node_** ref, unsigned char key )
+			{
+				radix_node_*	node = *ref;
+
+				switch (node->type)
+				{
+					case radix_node_::NODE4:
+					{
+						radix_node4_*	n = static_cast<radix_node4_*>(node);
+						remove_sorted_(n->keys, n->children, n->count, key);
+						if (n->count == 1)
+						{
+							*ref = n->children[0];
+							destroy_node_<radix_node4_>(node);
+						}
+						return ;
+					}
+					case radix_node_::NODE16:
+					{
+						radix_node16_*	n = static_cast<radix_node16_*>(node);
+						radix_node4_*	smaller = n->count - 1 > 3 ? NULL
+											: create_node_<radix_node4_>(radix_node_::NODE4, n->depth, n->prefix);
+						remove_sorted_(n->keys, n->children, n->count, key);
+						if (smaller == NULL)
+							return ;
+						for (unsigned i = 0; i < n->count; ++i)
+						{
+							smaller->keys[i] = n->keys[i];
+							smaller->children[i] = n->children[i];
+						}
+						smaller->count = n->count;
+						destroy_node_<radix_node16_>(node);
+						*ref = smaller;
+						return ;
+					}
+					case radix_node_::NODE48:
+					{
+						radix_node48_*	n = static_cast<radix_node48_*>(node);
+						radix_node16_*	smaller = n->count - 1 > 12 ? NULL
+											: create_node_<radix_node16_>(radix_node_::NODE16, n->depth, n->prefix);
+						n->children[n->index[key] - 1] = NULL;
+						n->index[key] = 0;
+						--n->count;
+						if (smaller == NULL)
+							return ;
+						for (unsigned k = 0; k < 256; ++k)
+							if (n->index[k])
+							{
+								smaller->keys[smaller->count] = static_cast<unsigned char>(k);
+								smaller->children[smaller->count++] = n->children[n->index[k] - 1];
+							}
+						destroy_node_<radix_node48_>(node);
+						*ref = smaller;
+						return ;
+					}
+					default:
+					{
+						radix_node256_*	n = static_cast<radix_node256_*>(node);
+						radix_node48_*	smaller = n->count - 1 > 37 ? NULL
+											: create_node_<radix_node48_>(radix_node_::NODE48, n->depth, n->prefix);
+						n->children[key] = NULL;
+						--n->count;
+						if (smaller == NULL)
+							return ;
+						for (unsigned k = 0; k < 256; ++k)
+							if (n->children[k])
+							{
+								smaller->children[smaller->count++] = n->children[k];
+								smaller->index[k] = static_cast<unsigned char>(smaller->count);
+							}
+						destroy_node_<radix_node256_>(node);
+						*ref = smaller;
+						return ;
+					}
+				}
+			}
+
+		// Tree
+			leaf_type_*	find_leaf_( bits_type bits ) const
+			{
+				radix_node_*	node = root_;
+
+				while (node && node->type != radix_node_::LEAF)
+				{
+					radix_node_**	slot = find_child_(node, byte_(bits, static_cast<radix_inner_*>(node)->depth));
+
+					node = slot ? *slot : NULL;
+				}
+				if (node && leaf_(node)->bits == bits)
+					return (leaf_(node));
+				return (NULL);
+			}
+
+			static radix_leaf_base_*	min_leaf_( radix_node_* node )
+			{
+				unsigned	key;
+
+				while (node->type != radix_node_::LEAF)
+					node = first_child_(node, 0, key);
+				return (leaf_(node));
+			}
+
+			static radix_leaf_base_*	max_leaf_( radix_node_* node )
+			{
+				while (node->type != radix_node_::LEAF)
+					node = last_child_(node);
+				return (leaf_(node));
+			}
+
+			// first leaf with bits >= bits (the sentinel when there is none)
+			radix_leaf_base_*	lower_bound_( bits_type bits ) const
+			{
+				radix_node_*	node = root_;
+
+				if (node == NULL)
+					return (end_());
+				while (node->type != radix_node_::LEAF)
+				{
+					radix_inner_*	inner = static_cast<radix_inner_*>(node);
+					const unsigned	mismatch = mismatch_(bits, inner->prefix);
+
+					if (mismatch < inner->depth)
+					{
+						// every key below differs from bits before this node branches
+						if (byte_(bits, mismatch) < byte_(inner->prefix, mismatch))
+							return (min_leaf_(node));
+						return (max_leaf_(node)->next);
+					}
+
+					const unsigned char	key = byte_(bits, inner->depth);
+					radix_node_**		slot = find_child_(node, key);
+
+					if (slot)
+						node = *slot;
+					else
+					{
+						unsigned		found;
+						radix_node_*	greater = first_child_(node, key + 1u, found);
+
+						if (greater)
+							return (min_leaf_(greater));
+						return (max_leaf_(node)->next);
+					}
+				}
+				if (leaf_(node)->bits >= bits)
+					return (leaf_(node));
+				return (leaf_(node)->next);
+			}
+
+			radix_leaf_base_*	upper_bound_( bits_type bits ) const
+			{
+				radix_leaf_base_*	it = lower_bound_(bits);
+
+				if (it != end_() && leaf_(it)->bits == bits)
+					return (it->next);
+				return (it);
+			}
+
+			// the key of leaf is not in the tree yet
+			void	insert_leaf_( leaf_type_* leaf )
+			{
+				const bits_type		bits = leaf->bits;
+				radix_node_**		ref = &root_;
+
+				while (*ref)
+				{
+					radix_node_*	node = *ref;
+
+					if (node->type == radix_node_::LEAF)
+					{
+						// two leaves: a node4 branches where they first differ
+						const bits_type		other = leaf_(node)->bits;
+						const unsigned		depth = mismatch_(bits, other);
+						radix_node4_*		split = create_node_<radix_node4_>(radix_node_::NODE4, depth, bits);
+
+						add_sorted_(split->keys, split->children, split->count, byte_(other, depth), node);
+						add_sorted_(split->keys, split->children, split->count, byte_(bits, depth), leaf);
+						*ref = split;
+						return ;
+					}
+
+					radix_inner_*	inner = static_cast<radix_inner_*>(node);
+					const unsigned	mismatch = mismatch_(bits, inner->prefix);
+
+					if (mismatch < inner->depth)
+					{
+						// the compressed path differs: a node4 branches above this node
+						radix_node4_*	split = create_node_<radix_node4_>(radix_node_::NODE4, mismatch, bits);
+
+						add_sorted_(split->keys, split->children, split->count, byte_(inner->prefix, mismatch), node);
+						add_sorted_(split->keys, split->children, split->count, byte_(bits, mismatch), leaf);
+						*ref = split;
+						return ;
+					}
+
+					const unsigned char	key = byte_(bits, inner->depth);
+					radix_node_**		slot = find_child_(node, key);
+
+					if (slot == NULL)
+						return (add_child_(ref, key, leaf));
+					ref = slot;
+				}
+				*ref = leaf;
+			}
+
+			// the key is in the tree
+			void	erase_leaf_( bits_type bits )
+			{
+				radix_node_**	ref = &root_;
+				radix_node_**	parent_ref = NULL;
+
+				while ((*ref)->type != radix_node_::LEAF)
+				{
+					parent_ref = ref;
+					ref = find_child_(*ref, byte_(bits, static_cast<radix_inner_*>(*ref)->depth));
+				}
+				if (parent_ref == NULL)
+					root_ = NULL;
+				else
+					remove_child_(parent_ref, byte_(bits, static_cast<radix_inner_*>(*parent_ref)->depth));
+			}
+
+};	// class radix_map
+
+
+// Non-member functions
+	// Operators
+		template< class Key, class T, class Alloc >
+		bool	operator==( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin())); }
+
+		template< class Key, class T, class Alloc >
+		bool	operator!=( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return !(lhs == rhs); }
+
+		template< class Key, class T, class Alloc >
+		bool	operator<( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end())); }
+
+		template< class Key, class T, class Alloc >
+		bool	operator<=( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return !(rhs < lhs); }
+
+		template< class Key, class T, class Alloc >
+		bool	operator>( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return (rhs < lhs); }
+
+		template< class Key, class T, class Alloc >
+		bool	operator>=( const ft::radix_map<Key,T,Alloc>& lhs,
+							const ft::radix_map<Key,T,Alloc>& rhs )
+		{ return !(lhs < rhs); }
+
+
+}	// namespace ft
+
+#endif
@@ -0,0 +1,509 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   segmented_vector.hpp                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// sequence for stacks which must not stall on push:
+// storage is a fixed table of segments whose sizes double (chunk, 2 * chunk, 4 * chunk, ...).
+// a full segment is never copied, the next one is just allocated, so push_back is O(1) in the
+// worst case (ft::vector copies everything when it grows). elements never move.
+//
+//	segments_:	[0]-> chunk       index [0, chunk)
+//				[1]-> 2 * chunk   index [chunk, 3 * chunk)
+//				[2]-> 4 * chunk   index [3 * chunk, 7 * chunk)
+//				...
+
+#ifndef SEGMENTED_VECTOR_HPP
+# define SEGMENTED_VECTOR_HPP
+
+# include <algorithm>
+# include <climits>
+# include <limits>
+# include <stdexcept>
+
+# include "../utils/algorithm.hpp"
+# include "../utils/iterator.hpp"
+# include "../utils/type_traits.hpp"
+# include "../utils/util.hpp"
+
+namespace ft {
+
+
+// elements in the first segment
+template< typename T >
+inline std::size_t	segment_chunk_size_()
+{ return (sizeof(T) < 512 ? 512 / sizeof(T) : 1); }
+
+// segment which holds index, and the first index of that segment
+template< typename T >
+inline std::size_t	segment_of_( std::size_t index, std::size_t* seg_first )
+{
+	const std::size_t	chunk = segment_chunk_size_<T>();
+	std::size_t			seg = (sizeof(unsigned long) * CHAR_BIT - 1)
+								- __builtin_clzl(static_cast<unsigned long>(index / chunk + 1));
+
+	*seg_first = chunk * ((static_cast<std::size_t>(1) << seg) - 1);
+	return (seg);
+}
+
+template< typename T >
+inline T*	segment_at_( T* const* segments, std::size_t index )
+{
+	std::size_t	seg_first;
+	std::size_t	seg = segment_of_<T>(index, &seg_first);
+
+	return (segments[seg] + (index - seg_first));
+}
+
+
+template< typename T, typename Ref, typename Ptr >
+class	segmented_iterator_
+{
+	public:
+		typedef T								value_type;
+		typedef Ref								reference;
+		typedef Ptr								pointer;
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::random_access_iterator_tag	iterator_category;
+
+	private:
+		typedef segmented_iterator_<T, Ref, Ptr>	Self_;
+		typedef segmented_iterator_<T, T&, T*>		iterator_;
+
+	public:
+		segmented_iterator_()
+		: segments(NULL), index(0)
+		{
+
+		}
+
+		segmented_iterator_( T* const* segs, std::size_t i )
+		: segments(segs), index(i)
+		{
+
+		}
+
+		segmented_iterator_( const iterator_& other )
+		: segments(other.segments), index(other.index)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (*segment_at_(segments, index)); }
+
+		pointer		operator->() const
+		{ return (segment_at_(segments, index)); }
+
+		reference	operator[]( difference_type n ) const
+		{ return (*segment_at_(segments, index + n)); }
+
+		Self_&	operator++()
+		{
+			++index;
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			++index;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			--index;
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			--index;
+			return (tmp);
+		}
+
+		Self_&	operator+=( difference_type n )
+		{
+			index += n;
+			return (*this);
+		}
+
+		Self_&	operator-=( difference_type n )
+		{
+			index -= n;
+			return (*this);
+		}
+
+		Self_	operator+( difference_type n ) const
+		{ return (Self_(segments, index + n)); }
+
+		Self_	operator-( difference_type n ) const
+		{ return (Self_(segments, index - n)); }
+	// ~public:
+
+		T* const*	segments;
+		std::size_t	index;
+
+};	// class segmented_iterator_
+
+
+// Non-member functions (segmented_iterator_)
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator==( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index == rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator!=( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index != rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator<( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index < rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator>( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index > rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator<=( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index <= rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator>=( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (lhs.index >= rhs.index); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+std::ptrdiff_t	operator-( const segmented_iterator_<T, R1, P1>& lhs, const segmented_iterator_<T, R2, P2>& rhs )
+{ return (static_cast<std::ptrdiff_t>(lhs.index - rhs.index)); }
+
+template< class T, class Ref, class Ptr >
+segmented_iterator_<T, Ref, Ptr>	operator+( std::ptrdiff_t n, const segmented_iterator_<T, Ref, Ptr>& it )
+{ return (it + n); }
+
+
+template< typename T, typename Allocator = std::allocator<T> >
+class	segmented_vector : private ft::ebo_holder_<Allocator>
+{
+	public:
+		// Member types
+			typedef T				value_type;
+			typedef Allocator		allocator_type;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			typedef value_type&							reference;
+			typedef const value_type&					const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+			typedef segmented_iterator_<T, T&, T*>					iterator;
+			typedef segmented_iterator_<T, const T&, const T*>		const_iterator;
+			typedef ft::reverse_iterator<iterator>					reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>			const_reverse_iterator;
+
+		// Member functions
+			// constructors and canonical
+				segmented_vector()
+				: alloc_holder_(), segments_(NULL), num_segments_(0), size_(0),
+					cur_(NULL), cur_begin_(NULL), cur_end_(NULL), cur_segment_(0)
+				{
+
+				}
+
+				explicit	segmented_vector( const Allocator& alloc )
+				: alloc_holder_(alloc), segments_(NULL), num_segments_(0), size_(0),
+					cur_(NULL), cur_begin_(NULL), cur_end_(NULL), cur_segment_(0)
+				{
+
+				}
+
+				segmented_vector( const segmented_vector& other )
+				: alloc_holder_(other.alloc_()), segments_(NULL), num_segments_(0), size_(0),
+					cur_(NULL), cur_begin_(NULL), cur_end_(NULL), cur_segment_(0)
+				{
+					*this = other;
+				}
+
+				~segmented_vector()
+				{
+					clear();
+					for (size_type i = 0; i < num_segments_; ++i)
+						alloc_().deallocate(segments_[i], segment_size_(i));
+					if (segments_ != NULL)
+						table_allocator_type(alloc_()).deallocate(segments_, max_segments_);
+				}
+
+				segmented_vector&	operator=( const segmented_vector& other )
+				{
+					if (this == &other)
+						return (*this);
+					clear();
+					reserve(other.size());
+					for (const_iterator it = other.begin(); it != other.end(); ++it)
+						push_back(*it);
+					return (*this);
+				}
+
+				allocator_type	get_allocator() const
+				{ return allocator_type(alloc_()); }
+
+			// Element access
+				reference	at( size_type pos )
+				{
+					if (pos >= size())
+						throw std::out_of_range("segmented_vector::at: out_of_range: pos >= this->size()");
+					return (*segment_at_(segments_, pos));
+				}
+
+				const_reference		at( size_type pos ) const
+				{
+					if (pos >= size())
+						throw std::out_of_range("segmented_vector::at: out_of_range: pos >= this->size()");
+					return (*segment_at_(segments_, pos));
+				}
+
+				reference	operator[]( size_type pos )
+				{ return (*segment_at_(segments_, pos)); }
+
+				const_reference		operator[]( size_type pos ) const
+				{ return (*segment_at_(segments_, pos)); }
+
+				reference	front()
+				{ return (*segments_[0]); }
+
+				const_reference		front() const
+				{ return (*segments_[0]); }
+
+				reference	back()
+				{ return (*(cur_ - 1)); }
+
+				const_reference		back() const
+				{ return (*(cur_ - 1)); }
+
+			// Iterators
+				iterator	begin()
+				{ return (iterator(segments_, 0)); }
+
+				const_iterator	begin() const
+				{ return (const_iterator(segments_, 0)); }
+
+				iterator	end()
+				{ return (iterator(segments_, size_)); }
+
+				const_iterator	end() const
+				{ return (const_iterator(segments_, size_)); }
+
+				reverse_iterator	rbegin()
+				{ return (reverse_iterator(end())); }
+
+				const_reverse_iterator	rbegin() const
+				{ return (const_reverse_iterator(end())); }
+
+				reverse_iterator	rend()
+				{ return (reverse_iterator(begin())); }
+
+				const_reverse_iterator	rend() const
+				{ return (const_reverse_iterator(begin())); }
+
+			// Capacity
+				bool	empty() const
+				{ return (size_ == 0); }
+
+				size_type	size() const
+				{ return (size_); }
+
+				size_type	max_size() const
+				{
+					return std::min(static_cast<size_type>(std::numeric_limits<difference_type>::max() / sizeof(value_type)),
+									alloc_().max_size());
+				}
+
+				// allocate segments up front, so that pushes up to new_cap never call the allocator
+				void	reserve( size_type new_cap )
+				{
+					if (new_cap > max_size())
+						throw std::length_error("segmented_vector::reserve: length_error: new_cap > max_size()");
+					while (capacity() < new_cap)
+						allocate_segment_();
+				}
+
+				size_type	capacity() const
+				{ return (segment_chunk_size_<T>() * ((static_cast<size_type>(1) << num_segments_) - 1)); }
+
+			// Modifiers
+				// keeps the segments (like ft::vector keeps its capacity)
+				void	clear()
+				{
+					while (size_ != 0)
+						pop_back();
+				}
+
+				void	push_back( const value_type& value )
+				{
+					if (cur_ == cur_end_)
+					{
+						const size_type	old_segment = cur_segment_;
+
+						next_segment_();
+						try
+						{
+							alloc_().construct(cur_, value);
+						}
+						catch (...)
+						{	// back to the end of the full segment (the new one is kept as spare)
+							if (cur_segment_ != old_segment)
+								prev_segment_();
+							throw ;
+						}
+					}
+					else
+						alloc_().construct(cur_, value);
+					++cur_;
+					++size_;
+				}
+
+				void	pop_back()
+				{
+					--cur_;
+					--size_;
+					alloc_().destroy(cur_);
+					if (cur_ == cur_begin_ && cur_segment_ != 0)
+						prev_segment_();
+				}
+
+				void	resize( size_type count, value_type value = value_type() )
+				{
+					while (size_ > count)
+						pop_back();
+					if (size_ < count)
+						reserve(count);
+					while (size_ < count)
+						push_back(value);
+				}
+
+				void	swap( segmented_vector& other )
+				{
+					std::swap(alloc_(), other.alloc_());
+					std::swap(segments_, other.segments_);
+					std::swap(num_segments_, other.num_segments_);
+					std::swap(size_, other.size_);
+					std::swap(cur_, other.cur_);
+					std::swap(cur_begin_, other.cur_begin_);
+					std::swap(cur_end_, other.cur_end_);
+					std::swap(cur_segment_, other.cur_segment_);
+				}
+
+
+	private:
+		typedef typename Allocator::template rebind<T*>::other	table_allocator_type;
+		typedef ft::ebo_holder_<Allocator>						alloc_holder_;
+
+		// enough for every size: the capacity doubles with each segment
+		static const size_type	max_segments_ = sizeof(size_type) * CHAR_BIT;
+
+		pointer*	segments_;
+		size_type	num_segments_;	// allocated segments
+		size_type	size_;
+		// segment of the back: the next element goes to cur_
+		pointer		cur_;
+		pointer		cur_begin_;
+		pointer		cur_end_;
+		size_type	cur_segment_;
+
+			allocator_type&		alloc_()
+			{ return (alloc_holder_::get()); }
+
+			const allocator_type&	alloc_() const
+			{ return (alloc_holder_::get()); }
+
+			static size_type	segment_size_( size_type seg )
+			{ return (segment_chunk_size_<T>() << seg); }
+
+			void	allocate_segment_()
+			{
+				if (segments_ == NULL)
+					segments_ = table_allocator_type(alloc_()).allocate(max_segments_);
+				segments_[num_segments_] = alloc_().allocate(segment_size_(num_segments_));
+				++num_segments_;
+				if (num_segments_ == 1)
+					set_segment_(0, 0);
+			}
+
+			void	set_segment_( size_type seg, size_type used )
+			{
+				cur_segment_ = seg;
+				cur_begin_ = segments_[seg];
+				cur_end_ = cur_begin_ + segment_size_(seg);
+				cur_ = cur_begin_ + used;
+			}
+
+			// back segment is full (or there is no segment yet)
+			void	next_segment_()
+			{
+				if (num_segments_ == 0 || cur_segment_ + 1 == num_segments_)
+					allocate_segment_();
+				if (size_ != 0)
+					set_segment_(cur_segment_ + 1, 0);
+			}
+
+			// back segment became empty: the back is the end of the previous one
+			void	prev_segment_()
+			{ set_segment_(cur_segment_ - 1, segment_size_(cur_segment_ - 1)); }
+
+};	// class segmented_vector
+
+
+// Non-member functions
+template< class T, class Alloc >
+bool	operator==( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return (lhs.size() == rhs.size()
+			&& ft::equal(lhs.begin(), lhs.end(), rhs.begin())); }
+
+template< class T, class Alloc >
+bool	operator!=( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return !(lhs == rhs); }
+
+template< class T, class Alloc >
+bool	operator<( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(),
+										rhs.begin(), rhs.end())); }
+
+template< class T, class Alloc >
+bool	operator<=( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return !(rhs < lhs); }
+
+template< class T, class Alloc >
+bool	operator>( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return (rhs < lhs); }
+
+template< class T, class Alloc >
+bool	operator>=( const ft::segmented_vector<T,Alloc>& lhs,
+					const ft::segmented_vector<T,Alloc>& rhs )
+{ return !(lhs < rhs); }
+
+
+template< class T, class Alloc >
+void	swap( ft::segmented_vector<T,Alloc>& lhs,
+				ft::segmented_vector<T,Alloc>& rhs )
+{ lhs.swap(rhs); }
+
+
+}	// namespace ft
+
+#endif
@@ -0,0 +1,450 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   set.hpp                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// set: https://en.cppreference.com/w/cpp/container/set
+// multiset: https://en.cppreference.com/w/cpp/container/multiset
+
+#ifndef SET_HPP
+# define SET_HPP
+
+# include "../utils/rb_tree.hpp"
+
+namespace ft {
+
+
+// nodes hold the key only (KeyOfValue is _Identity)
+template< class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+class	set
+{
+	public:
+		// Member types
+			typedef Key						key_type;
+			typedef Key						value_type;
+			typedef std::size_t				size_type;
+			typedef std::ptrdiff_t			difference_type;
+			typedef Compare					key_compare;
+			typedef Compare					value_compare;
+			typedef Allocator				allocator_type;
+
+			typedef value_type&					reference;
+			typedef const value_type&			const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+	private:
+		// Data
+			typedef rb_tree<key_type, value_type, ft::_Identity<value_type>,
+							key_compare, allocator_type>	storage_type_;
+
+			storage_type_	storage_;
+
+	public:
+		// Member types (elements of a set are immutable: both iterators are const)
+			typedef typename storage_type_::const_iterator			iterator;
+			typedef typename storage_type_::const_iterator			const_iterator;
+			typedef typename storage_type_::const_reverse_iterator	reverse_iterator;
+			typedef typename storage_type_::const_reverse_iterator	const_reverse_iterator;
+
+		// Constructors and canonical
+			set()
+			: storage_()
+			{
+
+			}
+
+			explicit set( const Compare& comp,
+							const Allocator& alloc = Allocator() )
+			: storage_(comp, alloc)
+			{
+
+			}
+
+			template< class InputIt >
+			set( InputIt first, InputIt last,
+					const Compare& comp = Compare(),
+					const Allocator& alloc = Allocator(),
+					typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+			: storage_(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			set( const set& other )
+			: storage_(other.storage_)
+			{
+
+			}
+
+			~set()
+			{
+
+			}
+
+			set&	operator=( const set& other )
+			{
+				if (this == &other)
+					return (*this);
+				storage_ = other.storage_;
+				return (*this);
+			}
+
+			allocator_type	get_allocator() const
+			{ return (storage_.get_allocator()); }
+
+		// Iterators
+			iterator	begin() const
+			{ return (storage_.begin()); }
+
+			iterator	end() const
+			{ return (storage_.end()); }
+
+			reverse_iterator	rbegin() const
+			{ return (storage_.rbegin()); }
+
+			reverse_iterator	rend() const
+			{ return (storage_.rend()); }
+
+		// Capacity
+			bool	empty() const
+			{ return (storage_.size() == 0); }
+
+			size_type	size() const
+			{ return (storage_.size()); }
+
+			size_type	max_size() const
+			{ return (storage_.max_size()); }
+
+		// Modifiers
+			void	clear()
+			{ storage_.clear(); }
+
+			ft::pair<iterator, bool>	insert( const value_type& value )
+			{ return (storage_.insert(value)); }
+
+			iterator	insert( iterator hint, const value_type& value )
+			{
+				(void)hint;
+				return (insert(value).first);
+			}
+
+			template< class InputIt >
+			void	insert( InputIt first, InputIt last,
+							typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL)
+			{
+				for (InputIt head = first; head != last; ++head)
+					insert(*head);
+			}
+
+			void	erase( iterator pos )
+			{ storage_.erase(pos); }
+
+			void	erase( iterator first, iterator last )
+			{
+				if (first == begin() && last == end())
+					clear();
+				else
+					while (first != last)
+						erase(first++);
+			}
+
+			size_type	erase( const Key& key )
+			{ return (storage_.erase(key)); }
+
+			void	swap( set& other )
+			{ storage_.swap(other.storage_); }
+
+		// Lookup
+			size_type	count( const Key& key ) const
+			{ return (storage_.find(key) != storage_.end()); }
+
+			iterator	find( const Key& key ) const
+			{ return (storage_.find(key)); }
+
+			ft::pair<iterator,iterator>		equal_range( const Key& key ) const
+			{ return (storage_.equal_range(key)); }
+
+			iterator	lower_bound( const Key& key ) const
+			{ return (storage_.lower_bound(key)); }
+
+			iterator	upper_bound( const Key& key ) const
+			{ return (storage_.upper_bound(key)); }
+
+		// Observers
+			key_compare	key_comp() const
+			{ return (storage_.key_comp()); }
+
+			value_compare	value_comp() const
+			{ return (storage_.key_comp()); }
+
+		// set friend
+					template< class K1, class C1, class A1 >
+					friend bool		operator==( const set<K1,C1,A1>& lhs,
+												const set<K1,C1,A1>& rhs );
+
+					template< class K1, class C1, class A1 >
+					friend bool		operator<( const set<K1,C1,A1>& lhs,
+												const set<K1,C1,A1>& rhs );
+
+};	// class set
+
+
+// same as set, but equal keys are kept (in insertion order)
+template< class Key, class Compare = std::less<Key>, class Allocator = std::allocator<Key> >
+class	multiset
+{
+	public:
+		// Member types
+			typedef Key						key_type;
+			typedef Key						value_type;
+			typedef std::size_t				size_type;
+			typedef std::ptrdiff_t			difference_type;
+			typedef Compare					key_compare;
+			typedef Compare					value_compare;
+			typedef Allocator				allocator_type;
+
+			typedef value_type&					reference;
+			typedef const value_type&			const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+	private:
+		// Data
+			typedef rb_tree<key_type, value_type, ft::_Identity<value_type>,
+							key_compare, allocator_type>	storage_type_;
+
+			storage_type_	storage_;
+
+	public:
+		// Member types
+			typedef typename storage_type_::const_iterator			iterator;
+			typedef typename storage_type_::const_iterator			const_iterator;
+			typedef typename storage_type_::const_reverse_iterator	reverse_iterator;
+			typedef typename storage_type_::const_reverse_iterator	const_reverse_iterator;
+
+		// Constructors and canonical
+			multiset()
+			: storage_()
+			{
+
+			}
+
+			explicit multiset( const Compare& comp,
+								const Allocator& alloc = Allocator() )
+			: storage_(comp, alloc)
+			{
+
+			}
+
+			template< class InputIt >
+			multiset( InputIt first, InputIt last,
+						const Compare& comp = Compare(),
+						const Allocator& alloc = Allocator(),
+						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+			: storage_(comp, alloc)
+			{
+				insert(first, last);
+			}
+
+			multiset( const multiset& other )
+			: storage_(other.storage_)
+			{
+
+			}
+
+			~multiset()
+			{
+
+			}
+
+			multiset&	operator=( const multiset& other )
+			{
+				if (this == &other)
+					return (*this);
+				storage_ = other.storage_;
+				return (*this);
+			}
+
+			allocator_type	get_allocator() const
+			{ return (storage_.get_allocator()); }
+
+		// Iterators
+			iterator	begin() const
+			{ return (storage_.begin()); }
+
+			iterator	end() const
+			{ return (storage_.end()); }
+
+			reverse_iterator	rbegin() const
+			{ return (storage_.rbegin()); }
+
+			reverse_iterator	rend() const
+			{ return (storage_.rend()); }
+
+		// Capacity
+			bool	empty() const
+			{ return (storage_.size() == 0); }
+
+			size_type	size() const
+			{ return (storage_.size()); }
+
+			size_type	max_size() const
+			{ return (storage_.max_size()); }
+
+		// Modifiers
+			void	clear()
+			{ storage_.clear(); }
+
+			iterator	insert( const value_type& value )
+			{ return (storage_.insert_equal(value)); }
+
+			iterator	insert( iterator hint, const value_type& value )
+			{
+				(void)hint;
+				return (insert(value));
+			}
+
+			template< class InputIt >
+			void	insert( InputIt first, InputIt last,
+							typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL)
+			{
+				for (InputIt head = first; head != last; ++head)
+					insert(*head);
+			}
+
+			void	erase( iterator pos )
+			{ storage_.erase(pos); }
+
+			void	erase( iterator first, iterator last )
+			{
+				if (first == begin() && last == end())
+					clear();
+				else
+					while (first != last)
+						erase(first++);
+			}
+
+			size_type	erase( const Key& key )
+			{ return (storage_.erase(key)); }
+
+			void	swap( multiset& other )
+			{ storage_.swap(other.storage_); }
+
+		// Lookup
+			size_type	count( const Key& key ) const
+			{ return (storage_.count(key)); }
+
+			iterator	find( const Key& key ) const
+			{ return (storage_.find(key)); }
+
+			ft::pair<iterator,iterator>		equal_range( const Key& key ) const
+			{ return (storage_.equal_range(key)); }
+
+			iterator	lower_bound( const Key& key ) const
+			{ return (storage_.lower_bound(key)); }
+
+			iterator	upper_bound( const Key& key ) const
+			{ return (storage_.upper_bound(key)); }
+
+		// Observers
+			key_compare	key_comp() const
+			{ return (storage_.key_comp()); }
+
+			value_compare	value_comp() const
+			{ return (storage_.key_comp()); }
+
+		// set friend
+					template< class K1, class C1, class A1 >
+					friend bool		operator==( const multiset<K1,C1,A1>& lhs,
+												const multiset<K1,C1,A1>& rhs );
+
+					template< class K1, class C1, class A1 >
+					friend bool		operator<( const multiset<K1,C1,A1>& lhs,
+												const multiset<K1,C1,A1>& rhs );
+
+};	// class multiset
+
+
+// Non-member functions
+	// Operators
+		template< class Key, class Compare, class Alloc >
+		bool	operator==( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return (lhs.storage_ == rhs.storage_); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator!=( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return !(lhs == rhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator<( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return (lhs.storage_ < rhs.storage_); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator<=( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return !(rhs < lhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator>( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return (rhs < lhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator>=( const ft::set<Key,Compare,Alloc>& lhs,
+							const ft::set<Key,Compare,Alloc>& rhs )
+		{ return !(lhs < rhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator==( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return (lhs.storage_ == rhs.storage_); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator!=( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return !(lhs == rhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator<( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return (lhs.storage_ < rhs.storage_); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator<=( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return !(rhs < lhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator>( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return (rhs < lhs); }
+
+		template< class Key, class Compare, class Alloc >
+		bool	operator>=( const ft::multiset<Key,Compare,Alloc>& lhs,
+							const ft::multiset<Key,Compare,Alloc>& rhs )
+		{ return !(lhs < rhs); }
+
+	// Specialized algorithms
+		template< class Key, class Compare, class Alloc >
+		void	swap( ft::set<Key,Compare,Alloc>& lhs, ft::set<Key,Compare,Alloc>& rhs )
+		{ lhs.swap(rhs); }
+
+		template< class Key, class Compare, class Alloc >
+		void	swap( ft::multiset<Key,Compare,Alloc>& lhs, ft::multiset<Key,Compare,Alloc>& rhs )
+		{ lhs.swap(rhs); }
+
+
+}	// namespace ft
+
+#endif
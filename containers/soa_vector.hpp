@@ -0,0 +1,641 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   soa_vector.hpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// soa_vector: a vector of records stored as a struct of arrays, one contiguous column per field
+
+#ifndef SOA_VECTOR_HPP
+# define SOA_VECTOR_HPP
+
+# include <cstddef>
+# include <stdexcept>
+
+# include "../utils/iterator.hpp"
+# include "vector.hpp"
+
+namespace ft {
+
+/*
+	ft::soa_vector<T0, T1, ..., T7> keeps up to 8 fields, each in its own ft::vector, so a scan
+	which reads one field touches only that column instead of dragging whole records through cache.
+
+	a record is a soa_row<T0, ..., T7>, which is built as a cons list: soa_row<T0, T1, ...> holds
+	head (T0) and derives from soa_row<T1, ..., soa_none_>, down to the empty soa_row<soa_none_, ...>.
+	the columns (soa_columns_) have the same shape with ft::vector<Ti> as head, so
+	soa_element_<I, Row> walks both and every operation recurses over the fields once.
+
+	rows are reached through a zipped iterator whose reference (soa_reference_) is a proxy:
+	ref.get<I>() is the field itself, and the proxy converts to / is assigned from a soa_row.
+	column<I>() returns a soa_span over the contiguous array of field I for tight (vectorizable) loops.
+*/
+
+struct	soa_none_
+{
+
+};
+
+template< typename T0, typename T1 = soa_none_, typename T2 = soa_none_, typename T3 = soa_none_,
+			typename T4 = soa_none_, typename T5 = soa_none_, typename T6 = soa_none_,
+			typename T7 = soa_none_ >
+struct	soa_row;
+
+// field I of a soa_row, or column I of a soa_columns_
+template< int I, typename Cons >
+struct	soa_element_
+{
+	typedef typename Cons::tail_type								tail_type;
+	typedef typename soa_element_<I - 1, tail_type>::type			type;
+
+	static type&	get( Cons& cons )
+	{ return (soa_element_<I - 1, tail_type>::get(cons)); }
+
+	static const type&	get( const Cons& cons )
+	{ return (soa_element_<I - 1, tail_type>::get(cons)); }
+};
+
+template< typename Cons >
+struct	soa_element_<0, Cons>
+{
+	typedef typename Cons::head_type	type;
+
+	static type&	get( Cons& cons )
+	{ return (cons.head); }
+
+	static const type&	get( const Cons& cons )
+	{ return (cons.head); }
+};
+
+
+template< typename T0, typename T1, typename T2, typename T3,
+			typename T4, typename T5, typename T6, typename T7 >
+struct	soa_row : public soa_row<T1, T2, T3, T4, T5, T6, T7, soa_none_>
+{
+	typedef T0													head_type;
+	typedef soa_row<T1, T2, T3, T4, T5, T6, T7, soa_none_>		tail_type;
+
+	soa_row()
+	: tail_type(), head()
+	{
+
+	}
+
+	soa_row( const T0& a0, const T1& a1 = T1(), const T2& a2 = T2(), const T3& a3 = T3(),
+				const T4& a4 = T4(), const T5& a5 = T5(), const T6& a6 = T6(), const T7& a7 = T7() )
+	: tail_type(a1, a2, a3, a4, a5, a6, a7, soa_none_()), head(a0)
+	{
+
+	}
+
+	template< int I >
+	typename soa_element_<I, soa_row>::type&	get()
+	{ return (soa_element_<I, soa_row>::get(*this)); }
+
+	template< int I >
+	const typename soa_element_<I, soa_row>::type&	get() const
+	{ return (soa_element_<I, soa_row>::get(*this)); }
+
+	T0	head;
+};
+
+template<>
+struct	soa_row<soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_>
+{
+	soa_row()
+	{
+
+	}
+
+	soa_row( const soa_none_&, const soa_none_&, const soa_none_&, const soa_none_&,
+				const soa_none_&, const soa_none_&, const soa_none_&, const soa_none_& )
+	{
+
+	}
+};
+
+
+// the columns: ft::vector<T0> as head, the columns of T1, ... as base
+template< typename T0, typename T1, typename T2, typename T3,
+			typename T4, typename T5, typename T6, typename T7 >
+struct	soa_columns_ : public soa_columns_<T1, T2, T3, T4, T5, T6, T7, soa_none_>
+{
+	typedef ft::vector<T0>												head_type;
+	typedef soa_columns_<T1, T2, T3, T4, T5, T6, T7, soa_none_>			tail_type;
+	typedef soa_row<T0, T1, T2, T3, T4, T5, T6, T7>						row_type;
+
+	// with the room reserved (reserve_push), only a copy can throw: the columns pushed are popped
+	void	push_back( const row_type& row )
+	{
+		head.push_back(row.head);
+		try
+		{
+			tail_type::push_back(row);
+		}
+		catch (...)
+		{
+			head.pop_back();
+			throw ;
+		}
+	}
+
+	// room for one more row in every column (each checks its own capacity)
+	void	reserve_push()
+	{
+		if (head.size() == head.capacity())
+			head.reserve(head.empty() ? 1 : head.size() * 2);
+		tail_type::reserve_push();
+	}
+
+	void	pop_back()
+	{
+		head.pop_back();
+		tail_type::pop_back();
+	}
+
+	void	clear()
+	{
+		head.clear();
+		tail_type::clear();
+	}
+
+	void	reserve( std::size_t n )
+	{
+		head.reserve(n);
+		tail_type::reserve(n);
+	}
+
+	// a column which throws shrinks the columns already grown back (shrinking cannot throw)
+	void	resize( std::size_t n, const row_type& row )
+	{
+		const std::size_t	old_size = head.size();
+
+		head.resize(n, row.head);
+		try
+		{
+			tail_type::resize(n, row);
+		}
+		catch (...)
+		{
+			head.resize(old_size, row.head);
+			throw ;
+		}
+	}
+
+	void	swap( soa_columns_& other )
+	{
+		head.swap(other.head);
+		tail_type::swap(other);
+	}
+
+	void	load( row_type& row, std::size_t pos ) const
+	{
+		row.head = head[pos];
+		tail_type::load(row, pos);
+	}
+
+	void	store( std::size_t pos, const row_type& row )
+	{
+		head[pos] = row.head;
+		tail_type::store(pos, row);
+	}
+
+	head_type	head;
+};
+
+template<>
+struct	soa_columns_<soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_>
+{
+	typedef soa_row<soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_, soa_none_>	row_type;
+
+	void	push_back( const row_type& ) {}
+	void	reserve_push() {}
+	void	pop_back() {}
+	void	clear() {}
+	void	reserve( std::size_t ) {}
+	void	resize( std::size_t, const row_type& ) {}
+	void	swap( soa_columns_& ) {}
+	void	load( row_type&, std::size_t ) const {}
+	void	store( std::size_t, const row_type& ) {}
+};
+
+
+// a contiguous column: T is const for the columns of a const soa_vector
+template< typename T >
+class	soa_span
+{
+	public:
+		typedef T				value_type;
+		typedef T*				iterator;
+		typedef T&				reference;
+		typedef std::size_t		size_type;
+
+		soa_span( T* data, size_type size )
+		: data_(data), size_(size)
+		{
+
+		}
+
+		T*	data() const
+		{ return (data_); }
+
+		size_type	size() const
+		{ return (size_); }
+
+		bool	empty() const
+		{ return (size_ == 0); }
+
+		iterator	begin() const
+		{ return (data_); }
+
+		iterator	end() const
+		{ return (data_ + size_); }
+
+		reference	operator[]( size_type pos ) const
+		{ return (data_[pos]); }
+
+	private:
+		T*			data_;
+		size_type	size_;
+};
+
+
+// field I of a soa_vector row, seen through Soa (which is const for const_reference)
+template< typename Soa, int I >
+struct	soa_field_
+{
+	typedef typename soa_element_<I, typename Soa::value_type>::type&		type;
+};
+
+template< typename Soa, int I >
+struct	soa_field_<const Soa, I>
+{
+	typedef const typename soa_element_<I, typename Soa::value_type>::type&	type;
+};
+
+// proxy for a row: Soa is soa_vector for reference, const soa_vector for const_reference
+template< typename Soa >
+class	soa_reference_
+{
+	public:
+		typedef typename Soa::value_type	value_type;
+		typedef std::size_t					size_type;
+
+		soa_reference_( Soa* soa, size_type index )
+		: soa_(soa), index_(index)
+		{
+
+		}
+
+		template< int I >
+		typename soa_field_<Soa, I>::type	get() const
+		{ return (soa_->template column<I>()[index_]); }
+
+		operator value_type() const
+		{
+			value_type	row;
+
+			soa_->columns_.load(row, index_);
+			return (row);
+		}
+
+		soa_reference_&		operator=( const value_type& row )
+		{
+			soa_->columns_.store(index_, row);
+			return (*this);
+		}
+
+		soa_reference_&		operator=( const soa_reference_& other )
+		{ return (*this = value_type(other)); }
+
+	private:
+		Soa*		soa_;
+		size_type	index_;
+};
+
+// random access by index: Soa is soa_vector for iterator, const soa_vector for const_iterator
+template< typename Soa >
+class	soa_iterator_
+{
+	public:
+		typedef typename Soa::value_type		value_type;
+		typedef soa_reference_<Soa>				reference;
+		typedef void							pointer;	// a row is a proxy: nothing to point to
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::random_access_iterator_tag	iterator_category;
+
+	private:
+		typedef soa_iterator_<Soa>		Self_;
+
+	public:
+		soa_iterator_()
+		: soa(NULL), index(0)
+		{
+
+		}
+
+		soa_iterator_( Soa* x, std::size_t y )
+		: soa(x), index(y)
+		{
+
+		}
+
+		// iterator to const_iterator
+		template< typename Other >
+		soa_iterator_( const soa_iterator_<Other>& other )
+		: soa(other.soa), index(other.index)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (reference(soa, index)); }
+
+		reference	operator[]( difference_type n ) const
+		{ return (reference(soa, index + n)); }
+
+		Self_&	operator++()
+		{
+			++index;
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			++index;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			--index;
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			--index;
+			return (tmp);
+		}
+
+		Self_&	operator+=( difference_type n )
+		{
+			index += n;
+			return (*this);
+		}
+
+		Self_&	operator-=( difference_type n )
+		{
+			index -= n;
+			return (*this);
+		}
+
+		Self_	operator+( difference_type n ) const
+		{ return (Self_(soa, index + n)); }
+
+		Self_	operator-( difference_type n ) const
+		{ return (Self_(soa, index - n)); }
+	// ~public:
+
+		Soa*		soa;
+		std::size_t	index;
+
+};	// class soa_iterator_
+
+template< typename S1, typename S2 >
+std::ptrdiff_t	operator-( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (std::ptrdiff_t(lhs.index) - std::ptrdiff_t(rhs.index)); }
+
+template< typename Soa >
+ft::soa_iterator_<Soa>	operator+( std::ptrdiff_t n, const ft::soa_iterator_<Soa>& it )
+{ return (it + n); }
+
+template< typename S1, typename S2 >
+bool	operator==( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index == rhs.index); }
+
+template< typename S1, typename S2 >
+bool	operator!=( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index != rhs.index); }
+
+template< typename S1, typename S2 >
+bool	operator<( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index < rhs.index); }
+
+template< typename S1, typename S2 >
+bool	operator<=( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index <= rhs.index); }
+
+template< typename S1, typename S2 >
+bool	operator>( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index > rhs.index); }
+
+template< typename S1, typename S2 >
+bool	operator>=( const ft::soa_iterator_<S1>& lhs, const ft::soa_iterator_<S2>& rhs )
+{ return (lhs.index >= rhs.index); }
+
+
+template< typename T0, typename T1 = soa_none_, typename T2 = soa_none_, typename T3 = soa_none_,
+			typename T4 = soa_none_, typename T5 = soa_none_, typename T6 = soa_none_,
+			typename T7 = soa_none_ >
+class	soa_vector
+{
+	private:
+		typedef soa_columns_<T0, T1, T2, T3, T4, T5, T6, T7>	columns_type_;
+
+	public:
+		// Member types
+			typedef soa_row<T0, T1, T2, T3, T4, T5, T6, T7>		value_type;
+			typedef std::size_t									size_type;
+			typedef std::ptrdiff_t								difference_type;
+
+			typedef soa_reference_<soa_vector>					reference;
+			typedef soa_reference_<const soa_vector>			const_reference;
+
+			typedef soa_iterator_<soa_vector>					iterator;
+			typedef soa_iterator_<const soa_vector>				const_iterator;
+			typedef ft::reverse_iterator<iterator>				reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>		const_reverse_iterator;
+
+			// type of field I
+			template< int I >
+			struct	field
+			{
+				typedef typename soa_element_<I, value_type>::type	type;
+			};
+
+		// Member functions
+			// constructors and canonical
+				soa_vector()
+				: columns_()
+				{
+
+				}
+
+				explicit	soa_vector( size_type count, const value_type& value = value_type() )
+				: columns_()
+				{
+					resize(count, value);
+				}
+
+				soa_vector( const soa_vector& other )
+				: columns_(other.columns_)
+				{
+
+				}
+
+				~soa_vector()
+				{
+
+				}
+
+				soa_vector&		operator=( const soa_vector& other )
+				{
+					if (this == &other)
+						return (*this);
+					columns_ = other.columns_;
+					return (*this);
+				}
+
+			// Element access
+				reference	at( size_type pos )
+				{
+					if (pos >= size())
+						throw std::out_of_range("soa_vector::at: out_of_range: pos >= this->size()");
+					return (reference(this, pos));
+				}
+
+				const_reference		at( size_type pos ) const
+				{
+					if (pos >= size())
+						throw std::out_of_range("soa_vector::at: out_of_range: pos >= this->size()");
+					return (const_reference(this, pos));
+				}
+
+				reference	operator[]( size_type pos )
+				{ return (reference(this, pos)); }
+
+				const_reference		operator[]( size_type pos ) const
+				{ return (const_reference(this, pos)); }
+
+				reference	front()
+				{ return (reference(this, 0)); }
+
+				const_reference		front() const
+				{ return (const_reference(this, 0)); }
+
+				reference	back()
+				{ return (reference(this, size() - 1)); }
+
+				const_reference		back() const
+				{ return (const_reference(this, size() - 1)); }
+
+				// the contiguous array of field I
+				template< int I >
+				soa_span<typename field<I>::type>	column()
+				{
+					ft::vector<typename field<I>::type>&	col = soa_element_<I, columns_type_>::get(columns_);
+
+					return (soa_span<typename field<I>::type>(col.data(), col.size()));
+				}
+
+				template< int I >
+				soa_span<const typename field<I>::type>	column() const
+				{
+					const ft::vector<typename field<I>::type>&	col = soa_element_<I, columns_type_>::get(columns_);
+
+					return (soa_span<const typename field<I>::type>(col.data(), col.size()));
+				}
+
+			// Iterators
+				iterator	begin()
+				{ return (iterator(this, 0)); }
+
+				const_iterator	begin() const
+				{ return (const_iterator(this, 0)); }
+
+				iterator	end()
+				{ return (iterator(this, size())); }
+
+				const_iterator	end() const
+				{ return (const_iterator(this, size())); }
+
+				reverse_iterator	rbegin()
+				{ return (reverse_iterator(end())); }
+
+				const_reverse_iterator	rbegin() const
+				{ return (const_reverse_iterator(end())); }
+
+				reverse_iterator	rend()
+				{ return (reverse_iterator(begin())); }
+
+				const_reverse_iterator	rend() const
+				{ return (const_reverse_iterator(begin())); }
+
+			// Capacity
+				bool	empty() const
+				{ return (columns_.head.empty()); }
+
+				size_type	size() const
+				{ return (columns_.head.size()); }
+
+				void	reserve( size_type new_cap )
+				{ columns_.reserve(new_cap); }
+
+				size_type	capacity() const
+				{ return (columns_.head.capacity()); }
+
+			// Modifiers
+				void	clear()
+				{ columns_.clear(); }
+
+				// strong guarantee: every column grows before any of them is written, and a
+				// field copy which throws pops the fields already pushed
+				void	push_back( const value_type& value )
+				{
+					columns_.reserve_push();
+					columns_.push_back(value);
+				}
+
+				void	pop_back()
+				{ columns_.pop_back(); }
+
+				// strong guarantee, as push_back: every column has the room before any of them grows
+				void	resize( size_type count, const value_type& value = value_type() )
+				{
+					if (count > size())
+						reserve(count);
+					columns_.resize(count, value);
+				}
+
+				void	swap( soa_vector& other )
+				{ columns_.swap(other.columns_); }
+
+	private:
+		columns_type_	columns_;
+
+		template< typename > friend class soa_reference_;
+
+};	// class soa_vector
+
+
+template< typename T0, typename T1, typename T2, typename T3,
+			typename T4, typename T5, typename T6, typename T7 >
+void	swap( ft::soa_vector<T0, T1, T2, T3, T4, T5, T6, T7>& lhs,
+				ft::soa_vector<T0, T1, T2, T3, T4, T5, T6, T7>& rhs )
+{ lhs.swap(rhs); }
+
+
+}	// namespace ft
+
+#endif
@@ -11,6 +11,7 @@
 /* ************************************************************************** */
 
 // stack:	https://en.cppreference.com/w/cpp/container/stack
+//	for worst-case O(1) push, use ft::segmented_vector as Container (see segmented_vector.hpp)
 
 #ifndef STACK_HPP
 # define STACK_HPP
@@ -77,10 +78,29 @@ class	stack
 				void	push( const value_type& value )
 				{ return (c.push_back(value)); }
 
+				// only when container_type has reserve() (ft::vector, ft::segmented_vector)
+				void	reserve( size_type new_cap )
+				{ c.reserve(new_cap); }
+
 			// Modifiers
 				void	pop()
 				{ c.pop_back(); }
 
+				// push every element of [first, last), last one on the top
+				template< class InputIt >
+				void	push_range( InputIt first, InputIt last )
+				{
+					for (; first != last; ++first)
+						c.push_back(*first);
+				}
+
+				// pop count elements (count <= size())
+				void	pop_n( size_type count )
+				{
+					for (; count != 0; --count)
+						c.pop_back();
+				}
+
 	protected:
 		container_type	c;
 
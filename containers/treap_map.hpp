@@ -0,0 +1,772 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   treap_map.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// treap_map: a self-adjusting ordered map on a treap (Seidel and Aragon, "Randomized Search Trees")
+
+#ifndef TREAP_MAP_HPP
+# define TREAP_MAP_HPP
+
+# include <functional>
+# include <memory>
+# include <stdexcept>
+
+# include "../utils/algorithm.hpp"
+# include "../utils/iterator.hpp"
+# include "../utils/pair.hpp"
+# include "../utils/type_traits.hpp"
+# include "../utils/util.hpp"
+
+namespace ft {
+
+/*
+	a binary search tree on the keys and a max-heap on random priorities.
+	every access (insert, find, lower_bound, ...) draws a new random number and keeps it
+	as the priority of the node when it is larger, then rotates the node up to restore the heap:
+	after k accesses a node has the best of k draws, so frequently used keys rise near the root
+	(expected depth O(log(total accesses / accesses of the key))), and the tree changes less and less
+	once it has adapted (the k-th access rotates with probability 1 / k).
+	lookups through a const map cannot restructure the tree and do not adapt it.
+
+	the header plays the DUMMY of rb_tree: header.left is the root, header.right is the header itself,
+	and end() is the header. nodes are only rotated, so iterators stay valid when the tree adapts.
+*/
+
+struct	treap_node_base_
+{
+	treap_node_base_*	parent;
+	treap_node_base_*	left;
+	treap_node_base_*	right;
+	unsigned			priority;
+
+	treap_node_base_*	leftest()
+	{
+		treap_node_base_*	tmp = this;
+
+		while (tmp->left)
+			tmp = tmp->left;
+		return (tmp);
+	}
+
+	treap_node_base_*	rightest()
+	{
+		treap_node_base_*	tmp = this;
+
+		while (tmp->right)
+			tmp = tmp->right;
+		return (tmp);
+	}
+
+	bool	isHeader() const
+	{ return (right == this); }
+};
+
+template< typename Value >
+struct	treap_node_ : treap_node_base_
+{
+	Value	value;
+};
+
+inline treap_node_base_*	treap_tree_increment_( treap_node_base_* node )
+{
+	if (node->right)
+		return (node->right->leftest());
+	while (node == node->parent->right)
+		node = node->parent;
+	return (node->parent);
+}
+
+inline treap_node_base_*	treap_tree_decrement_( treap_node_base_* node )
+{
+	if (node->isHeader())
+		return (node->left->rightest());
+	if (node->left)
+		return (node->left->rightest());
+	while (node == node->parent->left)
+		node = node->parent;
+	return (node->parent);
+}
+
+
+template< typename T, typename Ref, typename Ptr >
+class	treap_map_iterator_
+{
+	public:
+		typedef T								value_type;
+		typedef Ref								reference;
+		typedef Ptr								pointer;
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::bidirectional_iterator_tag	iterator_category;
+
+	private:
+		typedef treap_map_iterator_<T, Ref, Ptr>	Self_;
+		typedef treap_map_iterator_<T, T&, T*>		iterator_;
+
+	public:
+		treap_map_iterator_()
+		: node(NULL)
+		{
+
+		}
+
+		explicit	treap_map_iterator_( treap_node_base_* x )
+		: node(x)
+		{
+
+		}
+
+		treap_map_iterator_( const iterator_& other )
+		: node(other.node)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (static_cast<treap_node_<T>*>(node)->value); }
+
+		pointer		operator->() const
+		{ return (&static_cast<treap_node_<T>*>(node)->value); }
+
+		Self_&	operator++()
+		{
+			node = treap_tree_increment_(node);
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			node = treap_tree_increment_(node);
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			node = treap_tree_decrement_(node);
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			node = treap_tree_decrement_(node);
+			return (tmp);
+		}
+	// ~public:
+
+		treap_node_base_*	node;
+
+};	// class treap_map_iterator_
+
+
+// Non-member functions (treap_map_iterator_)
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator==( const treap_map_iterator_<T, R1, P1>& lhs, const treap_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node == rhs.node); }
+
+template< class T, class R1, class P1, class R2, class P2 >
+bool	operator!=( const treap_map_iterator_<T, R1, P1>& lhs, const treap_map_iterator_<T, R2, P2>& rhs )
+{ return (lhs.node != rhs.node); }
+
+
+// same interface as ft::map
+template< class Key, class T, class Compare = std::less<Key>, class Allocator = std::allocator<ft::pair<const Key, T> > >
+class	treap_map
+: private ft::ebo_holder_<Allocator, 0>,
+	private ft::ebo_holder_<Compare, 1>
+{
+	public:
+		// Member types
+			typedef Key						key_type;
+			typedef T						mapped_type;
+			typedef ft::pair<const Key, T>	value_type;
+			typedef std::size_t				size_type;
+			typedef std::ptrdiff_t			difference_type;
+			typedef Compare					key_compare;
+			typedef Allocator				allocator_type;
+
+			typedef value_type&					reference;
+			typedef const value_type&			const_reference;
+			typedef typename Allocator::pointer			pointer;
+			typedef typename Allocator::const_pointer	const_pointer;
+
+			typedef treap_map_iterator_<value_type, value_type&, value_type*>				iterator;
+			typedef treap_map_iterator_<value_type, const value_type&, const value_type*>	const_iterator;
+			typedef ft::reverse_iterator<iterator>											reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>									const_reverse_iterator;
+
+	private:
+		typedef treap_node_base_*				link_type;
+		typedef treap_node_<value_type>			node_type;
+		typedef typename Allocator::template rebind<node_type>::other	node_allocator_type;
+
+		typedef ft::ebo_holder_<Allocator, 0>	alloc_holder_;
+		typedef ft::ebo_holder_<Compare, 1>		compare_holder_;
+
+	public:
+		// Member classes
+		class	value_compare : public std::binary_function<value_type, value_type, bool>
+		{
+			public:
+				// Friend classes
+					friend class	treap_map<Key, T, Compare, Allocator>;
+
+				// Constructors and canonical
+					value_compare( Compare c )
+					: comp(c)
+					{
+
+					}
+
+					bool	operator()( const value_type& lhs, const value_type& rhs ) const
+					{ return (comp(lhs.first, rhs.first)); }
+
+			protected:
+				// Protected member objects
+					Compare		comp;
+
+		};	// class value_compare
+
+		// Constructors and canonical
+			treap_map()
+			: alloc_holder_(), compare_holder_()
+			{ initialize_(); }
+
+			explicit	treap_map( const Compare& comp,
+									const Allocator& alloc = Allocator() )
+			: alloc_holder_(alloc), compare_holder_(comp)
+			{ initialize_(); }
+
+			template< class InputIt >
+			treap_map( InputIt first, InputIt last,
+						const Compare& comp = Compare(),
+						const Allocator& alloc = Allocator(),
+						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+			: alloc_holder_(alloc), compare_holder_(comp)
+			{
+				initialize_();
+				insert(first, last);
+			}
+
+			// the copy keeps the shape of other, so its hot keys stay near the root
+			treap_map( const treap_map& other )
+			: alloc_holder_(other.alloc_()), compare_holder_(other.compare_())
+			{
+				initialize_();
+				copy_from_(other);
+			}
+
+			~treap_map()
+			{ clear(); }
+
+			treap_map&	operator=( const treap_map& other )
+			{
+				if (this == &other)
+					return (*this);
+				clear();
+				compare_holder_::get() = other.compare_();
+				copy_from_(other);
+				return (*this);
+			}
+
+			allocator_type	get_allocator() const
+			{ return (alloc_()); }
+
+		// Element access
+			T&	at( const Key& key )
+			{
+				iterator	i = find(key);
+				if (i == end())
+					throw std::out_of_range("treap_map::at: out_of_range: no such key");
+				return (i->second);
+			}
+
+			const T&	at( const Key& key ) const
+			{
+				const_iterator	i = find(key);
+				if (i == end())
+					throw std::out_of_range("treap_map::at: out_of_range: no such key");
+				return (i->second);
+			}
+
+			T&	operator[]( const Key& key )
+			{ return (insert(value_type(key, mapped_type())).first->second); }
+
+		// Iterators
+			iterator	begin()
+			{ return (iterator(header_.parent)); }
+
+			const_iterator	begin() const
+			{ return (const_iterator(header_.parent)); }
+
+			iterator	end()
+			{ return (iterator(end_())); }
+
+			const_iterator	end() const
+			{ return (const_iterator(end_())); }
+
+			reverse_iterator	rbegin()
+			{ return (reverse_iterator(end())); }
+
+			const_reverse_iterator	rbegin() const
+			{ return (const_reverse_iterator(end())); }
+
+			reverse_iterator	rend()
+			{ return (reverse_iterator(begin())); }
+
+			const_reverse_iterator	rend() const
+			{ return (const_reverse_iterator(begin())); }
+
+		// Capacity
+			bool	empty() const
+			{ return (size_ == 0); }
+
+			size_type	size() const
+			{ return (size_); }
+
+			size_type	max_size() const
+			{ return (node_allocator_type(alloc_()).max_size()); }
+
+		// Modifiers
+			void	clear()
+			{
+				clear_process_(header_.left);
+				initialize_();
+			}
+
+			ft::pair<iterator, bool>	insert( const value_type& value )
+			{
+				link_type	parent = end_();
+				link_type	current_node = header_.left;
+				bool		insert_left = true;
+
+				while (current_node)
+				{
+					parent = current_node;
+					if (key_compare_(value.first, key_(current_node)))
+					{
+						insert_left = true;
+						current_node = current_node->left;
+					}
+					else if (key_compare_(key_(current_node), value.first))
+					{
+						insert_left = false;
+						current_node = current_node->right;
+					}
+					else
+					{
+						access_(current_node);
+						return (ft::make_pair(iterator(current_node), false));
+					}
+				}
+
+				link_type	new_node = create_node_(value);
+
+				new_node->parent = parent;
+				if (parent == end_())
+					header_.left = new_node;
+				else if (insert_left)
+					parent->left = new_node;
+				else
+					parent->right = new_node;
+				if (parent == end_() || (insert_left && parent == header_.parent))
+					header_.parent = new_node;
+				++size_;
+				new_node->priority = random_();
+				sift_up_(new_node);
+				return (ft::make_pair(iterator(new_node), true));
+			}
+
+			iterator	insert( iterator hint, const value_type& value )
+			{
+				(void)hint;
+				return (insert(value).first);
+			}
+
+			template< class InputIt >
+			void	insert( InputIt first, InputIt last,
+							typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL)
+			{
+				for (InputIt head = first; head != last; ++head)
+					insert(*head);
+			}
+
+			// the node is rotated down (under its child of higher priority) until it is a leaf
+			void	erase( iterator pos )
+			{
+				link_type	node = pos.node;
+
+				if (node == header_.parent)
+					header_.parent = treap_tree_increment_(node);
+				while (node->left || node->right)
+				{
+					if (node->right == NULL || (node->left && node->left->priority > node->right->priority))
+						rotate_(node->left);
+					else
+						rotate_(node->right);
+				}
+				if (node->parent == end_() || node->parent->left == node)
+					node->parent->left = NULL;
+				else
+					node->parent->right = NULL;
+				destroy_node_(node);
+				--size_;
+			}
+
+			void	erase( iterator first, iterator last )
+			{
+				if (first == begin() && last == end())
+					clear();
+				else
+					while (first != last)
+						erase(first++);
+			}
+
+			size_type	erase( const Key& key )
+			{
+				iterator	it = find(key);
+
+				if (it == end())
+					return (0);
+				erase(it);
+				return (1);
+			}
+
+			void	swap( treap_map& other )
+			{
+				std::swap(header_.left, other.header_.left);
+				std::swap(header_.parent, other.header_.parent);
+				std::swap(size_, other.size_);
+				std::swap(alloc_holder_::get(), other.alloc_holder_::get());
+				std::swap(compare_holder_::get(), other.compare_holder_::get());
+				relink_header_();
+				other.relink_header_();
+			}
+
+		// Lookup
+			size_type	count( const Key& key ) const
+			{ return (find(key) != end()); }
+
+			iterator	find( const Key& key )
+			{
+				link_type	node = header_.left;
+
+				while (node)
+				{
+					if (key_compare_(key, key_(node)))
+						node = node->left;
+					else if (key_compare_(key_(node), key))
+						node = node->right;
+					else
+					{
+						access_(node);
+						return (iterator(node));
+					}
+				}
+				return (end());
+			}
+
+			const_iterator	find( const Key& key ) const
+			{
+				link_type	node = header_.left;
+
+				while (node)
+				{
+					if (key_compare_(key, key_(node)))
+						node = node->left;
+					else if (key_compare_(key_(node), key))
+						node = node->right;
+					else
+						return (const_iterator(node));
+				}
+				return (end());
+			}
+
+			ft::pair<iterator,iterator>		equal_range( const Key& key )
+			{
+				iterator	lower = lower_bound(key);
+
+				if (lower != end() && !key_compare_(key, lower->first))
+				{
+					iterator	upper = lower;
+					return (ft::make_pair(lower, ++upper));
+				}
+				return (ft::make_pair(lower, lower));
+			}
+
+			ft::pair<const_iterator,const_iterator>		equal_range( const Key& key ) const
+			{ return (ft::make_pair(lower_bound(key), upper_bound(key))); }
+
+			iterator	lower_bound( const Key& key )
+			{ return (access_result_(const_cast<const treap_map*>(this)->lower_bound(key).node)); }
+
+			const_iterator	lower_bound( const Key& key ) const
+			{
+				link_type	x = header_.left;
+				link_type	y = end_();
+
+				while (x)
+				{
+					if (!key_compare_(key_(x), key))
+					{
+						y = x;
+						x = x->left;
+					}
+					else
+						x = x->right;
+				}
+				return (const_iterator(y));
+			}
+
+			iterator	upper_bound( const Key& key )
+			{ return (access_result_(const_cast<const treap_map*>(this)->upper_bound(key).node)); }
+
+			const_iterator	upper_bound( const Key& key ) const
+			{
+				link_type	x = header_.left;
+				link_type	y = end_();
+
+				while (x)
+				{
+					if (key_compare_(key, key_(x)))
+					{
+						y = x;
+						x = x->left;
+					}
+					else
+						x = x->right;
+				}
+				return (const_iterator(y));
+			}
+
+		// Observers
+			key_compare	key_comp() const
+			{ return (compare_()); }
+
+			value_compare	value_comp() const
+			{ return (value_compare(compare_())); }
+
+	private:
+		// Member objects
+			treap_node_base_	header_;	// left: root, parent: begin, right: itself
+			size_type			size_;
+			unsigned			rng_;		// xorshift32 state of the priorities
+
+			const Allocator&	alloc_() const
+			{ return (alloc_holder_::get()); }
+
+			const Compare&	compare_() const
+			{ return (compare_holder_::get()); }
+
+			bool	key_compare_( const Key& lhs, const Key& rhs ) const
+			{ return (compare_holder_::get()(lhs, rhs)); }
+
+			static const Key&	key_( link_type x )
+			{ return (static_cast<node_type*>(x)->value.first); }
+
+			link_type	end_() const
+			{ return (const_cast<link_type>(&header_)); }
+
+			void	initialize_()
+			{
+				header_.left = NULL;
+				header_.parent = end_();
+				header_.right = end_();
+				size_ = 0;
+				rng_ = 2463534242u;
+			}
+
+			void	relink_header_()
+			{
+				if (header_.left)
+					header_.left->parent = end_();
+				else
+					header_.parent = end_();
+			}
+
+		// Nodes
+			link_type	create_node_( const value_type& value )
+			{
+				node_allocator_type	node_alloc(alloc_());
+				Allocator			value_alloc(alloc_());
+				node_type*			node = node_alloc.allocate(1);
+
+				node->left = NULL;
+				node->right = NULL;
+				try
+				{
+					value_alloc.construct(&node->value, value);
+				}
+				catch (...)
+				{
+					node_alloc.deallocate(node, 1);
+					throw ;
+				}
+				return (node);
+			}
+
+			void	destroy_node_( link_type node )
+			{
+				node_allocator_type	node_alloc(alloc_());
+				Allocator			value_alloc(alloc_());
+
+				value_alloc.destroy(&static_cast<node_type*>(node)->value);
+				node_alloc.deallocate(static_cast<node_type*>(node), 1);
+			}
+
+			void	clear_process_( link_type node )
+			{
+				while (node)
+				{
+					clear_process_(node->right);
+					link_type	tmp = node->left;
+					destroy_node_(node);
+					node = tmp;
+				}
+			}
+
+			// a copy which throws frees the nodes of the subtree already built
+			link_type	copy_tree_( link_type src, link_type parent )
+			{
+				link_type	node = create_node_(static_cast<node_type*>(src)->value);
+
+				node->parent = parent;
+				node->priority = src->priority;
+				try
+				{
+					if (src->left)
+						node->left = copy_tree_(src->left, node);
+					if (src->right)
+						node->right = copy_tree_(src->right, node);
+				}
+				catch (...)
+				{
+					clear_process_(node);
+					throw ;
+				}
+				return (node);
+			}
+
+			void	copy_from_( const treap_map& other )
+			{
+				if (other.header_.left == NULL)
+					return ;
+				header_.left = copy_tree_(other.header_.left, end_());
+				header_.parent = header_.left->leftest();
+				size_ = other.size_;
+			}
+
+		// Priorities
+			// x takes the place of its parent, which becomes its child
+			void	rotate_( link_type x )
+			{
+				link_type	parent = x->parent;
+				link_type	grandparent = parent->parent;
+
+				if (x == parent->left)
+				{
+					parent->left = x->right;
+					if (x->right)
+						x->right->parent = parent;
+					x->right = parent;
+				}
+				else
+				{
+					parent->right = x->left;
+					if (x->left)
+						x->left->parent = parent;
+					x->left = parent;
+				}
+				parent->parent = x;
+				x->parent = grandparent;
+				if (grandparent == end_() || grandparent->left == parent)
+					grandparent->left = x;
+				else
+					grandparent->right = x;
+			}
+
+			iterator	access_result_( link_type node )
+			{
+				if (node != end_())
+					access_(node);
+				return (iterator(node));
+			}
+
+			void	sift_up_( link_type x )
+			{
+				while (x->parent != end_() && x->parent->priority < x->priority)
+					rotate_(x);
+			}
+
+			void	access_( link_type x )
+			{
+				const unsigned	r = random_();
+				if (r > x->priority)
+				{
+					x->priority = r;
+					sift_up_(x);
+				}
+			}
+
+			unsigned	random_()
+			{
+				rng_ ^= rng_ << 13;
+				rng_ ^= rng_ >> 17;
+				rng_ ^= rng_ << 5;
+				return (rng_);
+			}
+
+};	// class treap_map
+
+
+// Non-member functions
+	// Operators
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator==( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return (lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin())); }
+
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator!=( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return !(lhs == rhs); }
+
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator<( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return (ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end())); }
+
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator<=( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return !(rhs < lhs); }
+
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator>( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return (rhs < lhs); }
+
+		template< class Key, class T, class Compare, class Alloc >
+		bool	operator>=( const ft::treap_map<Key,T,Compare,Alloc>& lhs,
+							const ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ return !(lhs < rhs); }
+
+	// Specialized algorithms
+		template< class Key, class T, class Compare, class Alloc >
+		void	swap( ft::treap_map<Key,T,Compare,Alloc>& lhs, ft::treap_map<Key,T,Compare,Alloc>& rhs )
+		{ lhs.swap(rhs); }
+
+
+}	// namespace ft
+
+#endif
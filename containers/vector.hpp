@@ -11,12 +11,17 @@
 /* ************************************************************************** */
 
 //reference https://en.cppreference.com/w/cpp/container/vector
+//          https://en.cppreference.com/w/cpp/container/vector_bool
 
 #ifndef VECTOR_HPP
 # define VECTOR_HPP
 
+# include <climits>
 # include <iostream>
 # include <limits>
+# include <new>
+# include <algorithm>
+# include <stdexcept>
 
 # include "../utils/algorithm.hpp"
 # include "../utils/iterator.hpp"
@@ -27,7 +32,7 @@ namespace ft {
 
 
 template< typename T, typename Allocator = std::allocator<T> >
-class	vector
+class	vector : private ft::ebo_holder_<Allocator>
 {
 	public:
 		// Member types
@@ -49,13 +54,13 @@ class	vector
 		// Member functions
 			// constructors and canonical
 				vector()
-				: first_(NULL), last_(NULL), reserved_last_(NULL), alloc_(allocator_type())
+				: alloc_holder_(), first_(NULL), last_(NULL), reserved_last_(NULL)
 				{
 
 				}
 
 				explicit	vector( const Allocator& alloc )
-				: first_(NULL), last_(NULL), reserved_last_(NULL), alloc_(alloc)
+				: alloc_holder_(alloc), first_(NULL), last_(NULL), reserved_last_(NULL)
 				{
 
 				}
@@ -63,34 +68,46 @@ class	vector
 				explicit	vector( size_type count,
 									const value_type& value = value_type(),
 									const Allocator& alloc = Allocator() )
-				: first_(NULL), last_(NULL), reserved_last_(NULL), alloc_(alloc)
+				: alloc_holder_(alloc), first_(NULL), last_(NULL), reserved_last_(NULL)
 				{
-					resize(count, value);
+					try
+					{
+						resize(count, value);
+					}
+					catch (...)
+					{
+						clear();
+						deallocate();
+						throw ;
+					}
 				}
 
 				template< class InputIt >
 				vector( InputIt first, InputIt last,
 						const Allocator& alloc = Allocator(),
 						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
-				: first_(NULL), last_(NULL), reserved_last_(NULL), alloc_(alloc)	// *check* first_, last_, reserved_last_ を代入するかどうか
+				: alloc_holder_(alloc), first_(NULL), last_(NULL), reserved_last_(NULL)
 				{
-					first_ = allocate(ft::distance(first, last));
-					last_ = first_;
-					for (InputIt i = first; i != last; ++i)
+					// no destructor runs for a constructor which throws: free what was built here
+					try
+					{
+						range_initialize(first, last, ft::iterator_category(first));
+					}
+					catch (...)
 					{
-						construct(last_, *i);
-						++last_;
+						clear();
+						deallocate();
+						throw ;
 					}
-					reserved_last_ = last_;
 				}
 
 				vector( const vector& other )
-				: first_(NULL), last_(NULL), reserved_last_(NULL), alloc_(other.alloc_)
+				: alloc_holder_(other.alloc_()), first_(NULL), last_(NULL), reserved_last_(NULL)
 				{
 					*this = other;
 				}
 
-				virtual		~vector()
+				~vector()
 				{
 					clear();
 					deallocate();
@@ -113,22 +130,19 @@ class	vector
 						first_ = allocate(count);
 						reserved_last_ = first_ + count;
 						last_ = first_;
-						for (size_type i = 0; i < count; ++i, ++last_)
-							construct(last_, value);
+						last_ = uninitialized_fill_n_a_(first_, count, value);
 					}
 					else
 					{	// enough capacity
-						pointer		ptr = first_;
-						size_type	i = 0;
 						size_type	_size = size();
 
-						for (; i < _size; ++i, ++ptr)
-							*ptr = value;
 						if (count > _size)
-							for (; i < count; ++i, ++last_)
-								construct(last_, value);
+						{
+							ft::fill(first_, last_, value);
+							last_ = uninitialized_fill_n_a_(last_, count - _size, value);
+						}
 						else
-							destroy_until(first_ + count);
+							destroy_until(ft::fill_n(first_, count, value));
 					}
 				}
 
@@ -136,37 +150,10 @@ class	vector
 				void	assign( InputIt first, InputIt last,
 								typename ft::enable_if<!ft::is_integral<InputIt>::value,
 														InputIt>::type* = NULL	)
-				{
-					size_type	count = ft::distance(first, last);
-
-					if (count > capacity())
-					{	// less capacity
-						clear();
-						deallocate();
-						first_ = allocate(count);
-						reserved_last_ = first_ + count;
-						last_ = first_;
-						for (InputIt itr = first; itr != last; ++itr, ++last_)
-							construct(last_, *itr);
-					}
-					else
-					{	// enough capacity
-						pointer		dest = first_;
-						size_type	_size = size();
-						size_type	i = 0;
-
-						for (; i < _size && first != last; ++i, ++dest, ++first)
-							*dest = *first;
-						if (count > _size && first != last)
-							for (; i < count; ++i, ++last_, ++first)
-								construct(last_, *first);
-						else
-							destroy_until(first_ + count);
-					}
-				}
+				{ range_assign(first, last, ft::iterator_category(first)); }
 
 				allocator_type	get_allocator() const
-				{ return allocator_type(alloc_); }
+				{ return allocator_type(alloc_()); }
 
 			// Element access
 				reference	at( size_type pos )
@@ -242,7 +229,7 @@ class	vector
 				size_type	max_size() const
 				{
 					return std::min(static_cast<size_type>(std::numeric_limits<difference_type>::max() / sizeof(value_type)),
-									alloc_.max_size());
+									alloc_().max_size());
 				}
 
 				void	reserve( size_type new_cap )
@@ -252,7 +239,7 @@ class	vector
 						size_type old_size = size();
 						pointer new_first = allocate(new_cap);
 
-						construct_and_copy(first_, last_, new_first);
+						uninitialized_copy_a_(first_, last_, new_first);
 						clear();
 						deallocate();
 						set_pointers_(new_first, new_first + old_size, new_first + new_cap);
@@ -278,43 +265,39 @@ class	vector
 				{
 					// if (count < 0)  // always true when size_type = size_t, and get warning(which is treated as errors) by c++(no warning by clang++)
 					// 	throw std::length_error("vector::insert: length_error: count < 0");
-					size_type	new_size = size() + count;
+					if (count == 0)
+						return ;
+
+					const value_type	value_copy = value;	// value may live in this vector
+					size_type			new_size = size() + count;
 
 					if (new_size <= capacity())	// enough capacity
 					{
-						iterator	src = last_, dest = last_ + count;
-
-						while (src != pos && dest != end())
-							construct(&*(--dest), *--src);
-						if (src != pos)
-						{	// count < data(to move) num
-							while (src != pos)
-								*--dest = *--src;
-							while (dest != pos)
-								*--dest = value;
+						pointer		dest = pos.base();
+						pointer		old_last = last_;
+						size_type	elems_after = old_last - dest;
+
+						if (elems_after > count)
+						{
+							last_ = uninitialized_copy_a_(old_last - count, old_last, old_last);
+							ft::copy_backward(dest, old_last - count, old_last);
+							ft::fill(dest, dest + count, value_copy);
 						}
 						else
 						{
-							while (dest != end())
-								construct(&*(--dest), value);
-							while (dest != pos)
-								*--dest = value;
+							last_ = uninitialized_fill_n_a_(old_last, count - elems_after, value_copy);
+							last_ = uninitialized_copy_a_(dest, old_last, last_);
+							ft::fill(dest, old_last, value_copy);
 						}
-						last_ += count;
 					}
 					else	// less capacity
 					{
 						new_size = calc_new_capacity(new_size);
 						pointer new_first = allocate(new_size);
-						pointer new_last = new_first;
-
-						iterator	src = first_;
-						for (; src != pos; ++src, ++new_last)
-							construct(new_last, *src);
-						for (size_type i = 0; i < count; ++i, ++new_last)
-							construct(new_last, value);
-						for (; src != end(); ++src, ++new_last)
-							construct(new_last, *src);
+						pointer new_last = uninitialized_copy_a_(first_, pos.base(), new_first);
+
+						new_last = uninitialized_fill_n_a_(new_last, count, value_copy);
+						new_last = uninitialized_copy_a_(pos.base(), last_, new_last);
 						clear();
 						deallocate();
 						set_pointers_(new_first, new_last, new_first + new_size);
@@ -325,50 +308,7 @@ class	vector
 				void	insert( iterator pos, InputIt it_first, InputIt it_last,
 								typename ft::enable_if<!ft::is_integral<InputIt>::value,
 														InputIt>::type* = NULL)
-				{
-					size_type		count = ft::distance(it_first, it_last);
-					size_type		new_size = size() + count;
-
-					if (new_size <= capacity())	// enough capacity
-					{
-						iterator	src = last_, dest = last_ + count;
-
-						while (src != pos && dest != end())
-							construct(&*(--dest), *--src);
-						if (src != pos)
-						{	// count < data(to move) num
-							while (src != pos)
-								*--dest = *--src;
-							while (dest != pos)
-								*--dest = *--it_last;
-						}
-						else
-						{
-							while (dest != end())
-								construct(&*(--dest), *--it_last);
-							while (dest != pos)
-								*--dest = *--it_last;
-						}
-						last_ += count;
-					}
-					else	// less capacity
-					{
-						new_size = calc_new_capacity(new_size);
-						pointer	new_first = allocate(new_size);
-						pointer	new_last = new_first;
-
-						iterator	src = first_;
-						for (; src != pos; ++src, ++new_last)
-							construct(new_last, *src);
-						for (size_type i = 0; i < count; ++i, ++new_last, ++it_first)
-							construct(new_last, *it_first);
-						for (; src != end(); ++src, ++new_last)
-							construct(new_last, *src);
-						clear();
-						deallocate();
-						set_pointers_(new_first, new_last, new_first + new_size);
-					}
-				}
+				{ range_insert(pos, it_first, it_last, ft::iterator_category(it_first)); }
 
 				iterator	erase( iterator pos )
 				{ return (erase(pos, pos + 1)); }
@@ -377,15 +317,50 @@ class	vector
 				{
 					if (first_ == last_)
 						return (NULL);
-					difference_type	head_offset = ft::distance(begin(), first);
+					difference_type	head_offset = first - begin();
 
-					for (iterator head = first, tail = last; tail < end(); ++head, ++tail)
-						*head = *tail;
-					destroy_until(last_ - ft::distance(first, last));
+					destroy_until(ft::copy(last.base(), last_, first.base()));
 					return (first_ + head_offset);
 				}
 
 
+				// O(1) erase which does not keep the order: the last element is moved to pos
+				iterator	erase_unordered( iterator pos )
+				{
+					pointer		p = pos.base();
+
+					if (p != last_ - 1)
+					{
+						using std::swap;
+						swap(*p, *(last_ - 1));
+					}
+					pop_back();
+					return (pos);
+				}
+
+				// erase all elements which satisfy pred in a single pass (order is kept),
+				// and return the number of erased elements
+				template< class UnaryPredicate >
+				size_type	erase_if( UnaryPredicate pred )
+				{
+					pointer		dest = first_;
+
+					while (dest != last_ && !pred(*dest))
+						++dest;
+					if (dest == last_)
+						return (0);
+					for (pointer src = dest + 1; src != last_; ++src)
+						if (!pred(*src))
+						{
+							*dest = *src;
+							++dest;
+						}
+
+					size_type	erased = last_ - dest;
+					destroy_until(dest);
+					return (erased);
+				}
+
 				void	push_back( const_reference value )
 				{
 					if (size() >= capacity())	// less capacity
@@ -402,16 +377,27 @@ class	vector
 					size_type	_size = size();
 
 					if (count < _size)
+						destroy_until(first_ + count);
+					else if (count > _size)
 					{
-						last_ = first_ + count;
-						destroy_until(last_);
+						reserve(count);
+						last_ = uninitialized_fill_n_a_(last_, count - _size, value);
 					}
+				}
+
+				// same as resize(), but new elements are default-initialized, not copied from T().
+				// for trivial types the new region is left untouched (no store is issued),
+				// so the caller can fill it with read()/memcpy() right after.
+				void	resize_default_init( size_type count )
+				{
+					size_type	_size = size();
+
+					if (count < _size)
+						destroy_until(first_ + count);
 					else if (count > _size)
 					{
-						difference_type diff = count - _size;
 						reserve(count);
-						for (difference_type i = 0; i < diff; i++, ++last_)
-							construct(last_, value);
+						construct_default_n(count - _size, ft::is_trivial<value_type>());
 					}
 				}
 
@@ -420,25 +406,34 @@ class	vector
 					pointer			tmp_first = first_;
 					pointer			tmp_last = last_;
 					pointer			tmp_reserved_last_ = reserved_last_;
-					allocator_type	tmp_alloc = alloc_;
+					allocator_type	tmp_alloc = alloc_();
 
 					first_ = other.first_;
 					last_ = other.last_;
 					reserved_last_ = other.reserved_last_;
-					alloc_ = other.alloc_;
+					alloc_() = other.alloc_();
 
 					other.first_ = tmp_first;
 					other.last_ = tmp_last;
 					other.reserved_last_ = tmp_reserved_last_;
-					other.alloc_ = tmp_alloc;
+					other.alloc_() = tmp_alloc;
 				}
 
 
 	protected:
+		// no vptr, and an empty allocator takes no space (ebo_holder_):
+		// sizeof(ft::vector<T>) == 3 * sizeof(void*)
 		pointer			first_;
 		pointer			last_;
 		pointer			reserved_last_;
-		allocator_type	alloc_;
+
+		typedef ft::ebo_holder_<Allocator>	alloc_holder_;
+
+		allocator_type&		alloc_()
+		{ return (alloc_holder_::get()); }
+
+		const allocator_type&	alloc_() const
+		{ return (alloc_holder_::get()); }
 
 
 	private:
@@ -477,47 +472,209 @@ class	vector
 			pointer		allocate(size_type n) {
 				if (n > max_size())
 					throw std::length_error("vector::allocate: length_error: new_cap > max_size()");
-				return alloc_.allocate(n);
+				return alloc_().allocate(n);
 			}
 
 			void	deallocate()
-			{ alloc_.deallocate(first_, capacity()); }
+			{ alloc_().deallocate(first_, capacity()); }
 
 			void	construct(pointer ptr)
-			{ alloc_.construct(ptr, 0); }
+			{ alloc_().construct(ptr, 0); }
 
 			void	construct(pointer ptr, const_reference value)
-			{ alloc_.construct(ptr, value); }
+			{ alloc_().construct(ptr, value); }
 
 			void	destroy(pointer ptr)
-			{ alloc_.destroy(ptr); }
+			{ alloc_().destroy(ptr); }
+
+			// append n default-initialized elements (capacity must be enough)
+			void	construct_default_n( size_type n, ft::true_type )
+			{ last_ += n; }
+
+			void	construct_default_n( size_type n, ft::false_type )
+			{
+				for (; n != 0; --n, ++last_)
+					::new (static_cast<void*>(last_)) value_type;
+			}
 
 			void	destroy_until( pointer new_last )
 			{
 				while (last_ != new_last)
-				 	alloc_.destroy(--last_);
+				 	alloc_().destroy(--last_);
+			}
+
+			// range operations, dispatched by iterator category
+			//  input iterator: can be walked only once, so grow while reading
+			//  forward iterator: count first, then allocate exactly once
+			template<typename InputIt>
+			void	range_initialize( InputIt first, InputIt last, ft::input_iterator_tag )
+			{
+				for (; first != last; ++first)
+					push_back(*first);
+			}
+
+			template<typename ForwardIt>
+			void	range_initialize( ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
+			{
+				size_type	count = ft::distance(first, last);
+
+				first_ = allocate(count);
+				last_ = first_;
+				reserved_last_ = first_ + count;
+				last_ = uninitialized_copy_a_(first, last, first_);
 			}
 
-			template<typename InputIt, typename ForwardIt>
-			void	construct_and_copy(InputIt src_first, InputIt src_last, ForwardIt dest)
+			template<typename InputIt>
+			void	range_assign( InputIt first, InputIt last, ft::input_iterator_tag )
 			{
-				while (src_first != src_last)
+				pointer		dest = first_;
+
+				for (; dest != last_ && first != last; ++dest, ++first)
+					*dest = *first;
+				if (first == last)
+					destroy_until(dest);
+				else
+					for (; first != last; ++first)
+						push_back(*first);
+			}
+
+			template<typename ForwardIt>
+			void	range_assign( ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
+			{
+				size_type	count = ft::distance(first, last);
+
+				if (count > capacity())
+				{	// less capacity
+					clear();
+					deallocate();
+					first_ = allocate(count);
+					reserved_last_ = first_ + count;
+					last_ = first_;
+					last_ = uninitialized_copy_a_(first, last, first_);
+				}
+				else if (count > size())
+				{	// enough capacity, grows
+					ForwardIt	mid = first;
+
+					ft::advance(mid, size());
+					ft::copy(first, mid, first_);
+					last_ = uninitialized_copy_a_(mid, last, last_);
+				}
+				else	// enough capacity, shrinks
+					destroy_until(ft::copy(first, last, first_));
+			}
+
+			template<typename InputIt>
+			void	range_insert( iterator pos, InputIt first, InputIt last, ft::input_iterator_tag )
+			{
+				if (pos == end())
 				{
-					construct(dest, *src_first);
-					++dest; ++src_first;
+					for (; first != last; ++first)
+						push_back(*first);
+					return ;
 				}
+				vector	tmp(first, last, alloc_());
+				range_insert(pos, tmp.begin(), tmp.end(), ft::forward_iterator_tag());
 			}
 
-			template<typename InputIt, typename Size_type, typename ForwardIt>
-			void	construct_and_copy(InputIt src_first, typename ft::enable_if<ft::is_integral<Size_type>::valule, Size_type>::type src_size, ForwardIt dest)
+			template<typename ForwardIt>
+			void	range_insert( iterator pos, ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
 			{
-				while (src_size-- != 0)
+				size_type	count = ft::distance(first, last);
+				size_type	new_size = size() + count;
+
+				if (new_size <= capacity())	// enough capacity
 				{
-					construct(dest, *src_first);
-					++dest; ++src_first;
+					pointer		dest = pos.base();
+					pointer		old_last = last_;
+					size_type	elems_after = old_last - dest;
+
+					if (elems_after > count)
+					{
+						last_ = uninitialized_copy_a_(old_last - count, old_last, old_last);
+						ft::copy_backward(dest, old_last - count, old_last);
+						ft::copy(first, last, dest);
+					}
+					else
+					{
+						ForwardIt	mid = first;
+
+						ft::advance(mid, elems_after);
+						last_ = uninitialized_copy_a_(mid, last, old_last);
+						last_ = uninitialized_copy_a_(dest, old_last, last_);
+						ft::copy(first, mid, dest);
+					}
+				}
+				else	// less capacity
+				{
+					new_size = calc_new_capacity(new_size);
+					pointer	new_first = allocate(new_size);
+					pointer	new_last = uninitialized_copy_a_(first_, pos.base(), new_first);
+
+					new_last = uninitialized_copy_a_(first, last, new_last);
+					new_last = uninitialized_copy_a_(pos.base(), last_, new_last);
+					clear();
+					deallocate();
+					set_pointers_(new_first, new_last, new_first + new_size);
 				}
 			}
 
+			// build elements in raw memory at dest. std::allocator::construct() is a placement new,
+			// so the ft algorithms build them (one memmove / memset for trivial types);
+			// any other allocator gets its construct() called for each element
+			typedef ft::is_same<Allocator, std::allocator<T> >	plain_allocator_;
+
+			template<typename InputIt>
+			pointer		uninitialized_copy_a_( InputIt first, InputIt last, pointer dest )
+			{ return (uninitialized_copy_a_(first, last, dest, plain_allocator_())); }
+
+			template<typename InputIt>
+			pointer		uninitialized_copy_a_( InputIt first, InputIt last, pointer dest, ft::true_type )
+			{ return (ft::uninitialized_copy(first, last, dest)); }
+
+			template<typename InputIt>
+			pointer		uninitialized_copy_a_( InputIt first, InputIt last, pointer dest, ft::false_type )
+			{
+				pointer		current = dest;
+
+				try
+				{
+					for (; first != last; ++first, ++current)
+						construct(current, *first);
+				}
+				catch (...)
+				{
+					for (; dest != current; ++dest)
+						destroy(dest);
+					throw ;
+				}
+				return (current);
+			}
+
+			pointer		uninitialized_fill_n_a_( pointer dest, size_type count, const_reference value )
+			{ return (uninitialized_fill_n_a_(dest, count, value, plain_allocator_())); }
+
+			pointer		uninitialized_fill_n_a_( pointer dest, size_type count, const_reference value, ft::true_type )
+			{ return (ft::uninitialized_fill_n(dest, count, value)); }
+
+			pointer		uninitialized_fill_n_a_( pointer dest, size_type count, const_reference value, ft::false_type )
+			{
+				pointer		current = dest;
+
+				try
+				{
+					for (; count != 0; --count, ++current)
+						construct(current, value);
+				}
+				catch (...)
+				{
+					for (; dest != current; ++dest)
+						destroy(dest);
+					throw ;
+				}
+				return (current);
+			}
+
 };	// class vector
 
 
@@ -562,6 +719,683 @@ void	swap( ft::vector<T,Alloc>& lhs,
         		ft::vector<T,Alloc>& rhs )
 { lhs.swap(rhs); }
 
+// vector<bool>: bits are packed into words, a proxy (bit_reference_) stands for a bool&.
+// bits past size() are always zero, so count() / find_first() / operator== and the
+// bulk &= |= ^= run a word (64 bits) at a time without masking the tail.
+
+typedef unsigned long	bit_word_;
+
+enum { bit_word_bits_ = sizeof(bit_word_) * CHAR_BIT };
+
+class	bit_reference_
+{
+	public:
+		bit_reference_( bit_word_* word, bit_word_ mask )
+		: word_(word), mask_(mask)
+		{
+
+		}
+
+		operator bool() const
+		{ return ((*word_ & mask_) != 0); }
+
+		bit_reference_&		operator=( bool x )
+		{
+			if (x)
+				*word_ |= mask_;
+			else
+				*word_ &= ~mask_;
+			return (*this);
+		}
+
+		bit_reference_&		operator=( const bit_reference_& x )
+		{ return (*this = bool(x)); }
+
+		bool	operator~() const
+		{ return (!bool(*this)); }
+
+		void	flip()
+		{ *word_ ^= mask_; }
+
+	private:
+		bit_word_*	word_;
+		bit_word_	mask_;
+};	// class bit_reference_
+
+// Ref is bit_reference_ for iterator and bool for const_iterator;
+// no bit can be addressed, so pointer is void (there is no operator->)
+template< typename Ref >
+class	bit_iterator_
+{
+	public:
+		typedef bool							value_type;
+		typedef Ref								reference;
+		typedef void							pointer;
+		typedef std::ptrdiff_t					difference_type;
+		typedef ft::random_access_iterator_tag	iterator_category;
+
+	private:
+		typedef bit_iterator_<Ref>				Self_;
+		typedef bit_iterator_<bit_reference_>	iterator_;
+
+	public:
+		bit_iterator_()
+		: word(NULL), offset(0)
+		{
+
+		}
+
+		bit_iterator_( bit_word_* x, unsigned y )
+		: word(x), offset(y)
+		{
+
+		}
+
+		bit_iterator_( const iterator_& other )
+		: word(other.word), offset(other.offset)
+		{
+
+		}
+
+		reference	operator*() const
+		{ return (reference(bit_reference_(word, bit_word_(1) << offset))); }
+
+		reference	operator[]( difference_type n ) const
+		{ return (*(*this + n)); }
+
+		Self_&	operator++()
+		{
+			if (++offset == bit_word_bits_)
+			{
+				offset = 0;
+				++word;
+			}
+			return (*this);
+		}
+
+		Self_	operator++( int )
+		{
+			Self_	tmp = *this;
+
+			++*this;
+			return (tmp);
+		}
+
+		Self_&	operator--()
+		{
+			if (offset-- == 0)
+			{
+				offset = bit_word_bits_ - 1;
+				--word;
+			}
+			return (*this);
+		}
+
+		Self_	operator--( int )
+		{
+			Self_	tmp = *this;
+
+			--*this;
+			return (tmp);
+		}
+
+		Self_&	operator+=( difference_type n )
+		{
+			difference_type	bit = n + difference_type(offset);
+			difference_type	words = bit >= 0 ? bit / bit_word_bits_
+											: -((-bit - 1) / bit_word_bits_) - 1;
+
+			word += words;
+			offset = static_cast<unsigned>(bit - words * bit_word_bits_);
+			return (*this);
+		}
+
+		Self_&	operator-=( difference_type n )
+		{ return (*this += -n); }
+
+		Self_	operator+( difference_type n ) const
+		{
+			Self_	tmp = *this;
+
+			return (tmp += n);
+		}
+
+		Self_	operator-( difference_type n ) const
+		{
+			Self_	tmp = *this;
+
+			return (tmp -= n);
+		}
+	// ~public:
+
+		bit_word_*	word;
+		unsigned	offset;
+
+};	// class bit_iterator_
+
+template< typename R1, typename R2 >
+std::ptrdiff_t	operator-( const ft::bit_iterator_<R1>& lhs,
+							const ft::bit_iterator_<R2>& rhs )
+{
+	return ((lhs.word - rhs.word) * std::ptrdiff_t(bit_word_bits_)
+			+ std::ptrdiff_t(lhs.offset) - std::ptrdiff_t(rhs.offset));
+}
+
+template< typename Ref >
+ft::bit_iterator_<Ref>	operator+( std::ptrdiff_t n, const ft::bit_iterator_<Ref>& it )
+{ return (it + n); }
+
+template< typename R1, typename R2 >
+bool	operator==( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return (lhs.word == rhs.word && lhs.offset == rhs.offset); }
+
+template< typename R1, typename R2 >
+bool	operator!=( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return !(lhs == rhs); }
+
+template< typename R1, typename R2 >
+bool	operator<( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return (lhs - rhs < 0); }
+
+template< typename R1, typename R2 >
+bool	operator<=( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return !(rhs < lhs); }
+
+template< typename R1, typename R2 >
+bool	operator>( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return (rhs < lhs); }
+
+template< typename R1, typename R2 >
+bool	operator>=( const ft::bit_iterator_<R1>& lhs,
+					const ft::bit_iterator_<R2>& rhs )
+{ return !(lhs < rhs); }
+
+
+template< typename Allocator >
+class	vector<bool, Allocator>
+: private ft::ebo_holder_<typename Allocator::template rebind<bit_word_>::other>
+{
+	public:
+		// Member types
+			typedef bool			value_type;
+			typedef Allocator		allocator_type;
+			typedef std::size_t		size_type;
+			typedef std::ptrdiff_t	difference_type;
+
+			typedef bit_reference_		reference;
+			typedef bool				const_reference;
+			typedef void				pointer;		// the bits cannot be addressed
+			typedef void				const_pointer;
+
+			typedef ft::bit_iterator_<reference>						iterator;
+			typedef ft::bit_iterator_<const_reference>					const_iterator;
+			typedef ft::reverse_iterator<iterator>						reverse_iterator;
+			typedef ft::reverse_iterator<const_iterator>				const_reverse_iterator;
+
+			// returned by find_first() / find_next() when there is no set bit
+			static const size_type	npos = static_cast<size_type>(-1);
+
+		// Member functions
+			// constructors and canonical
+				vector()
+				: alloc_holder_(), words_(NULL), size_(0), capacity_(0)
+				{
+
+				}
+
+				explicit	vector( const Allocator& alloc )
+				: alloc_holder_(word_allocator_type(alloc)), words_(NULL), size_(0), capacity_(0)
+				{
+
+				}
+
+				explicit	vector( size_type count,
+									const bool& value = false,
+									const Allocator& alloc = Allocator() )
+				: alloc_holder_(word_allocator_type(alloc)), words_(NULL), size_(0), capacity_(0)
+				{
+					resize(count, value);
+				}
+
+				template< class InputIt >
+				vector( InputIt first, InputIt last,
+						const Allocator& alloc = Allocator(),
+						typename ft::enable_if<!ft::is_integral<InputIt>::value, InputIt>::type* = NULL )
+				: alloc_holder_(word_allocator_type(alloc)), words_(NULL), size_(0), capacity_(0)
+				{
+					range_append_(first, last, ft::iterator_category(first));
+				}
+
+				vector( const vector& other )
+				: alloc_holder_(other.alloc_()), words_(NULL), size_(0), capacity_(0)
+				{
+					*this = other;
+				}
+
+				~vector()
+				{ deallocate_(); }
+
+				vector&		operator=( const vector& other )
+				{
+					if (this == &other)
+						return (*this);
+					clear();
+					reserve(other.size_);
+					ft::copy(other.words_, other.words_ + words_for_(other.size_), words_);
+					size_ = other.size_;
+					return (*this);
+				}
+
+				void	assign( size_type count, const bool& value )
+				{
+					clear();
+					resize(count, value);
+				}
+
+				template< class InputIt >
+				void	assign( InputIt first, InputIt last,
+								typename ft::enable_if<!ft::is_integral<InputIt>::value,
+														InputIt>::type* = NULL	)
+				{
+					clear();
+					range_append_(first, last, ft::iterator_category(first));
+				}
+
+				allocator_type	get_allocator() const
+				{ return allocator_type(alloc_()); }
+
+			// Element access
+				reference	at( size_type pos )
+				{
+					if (pos >= size())
+						throw std::out_of_range("vector::at: out_of_range: pos >= this->size()");
+					return ((*this)[pos]);
+				}
+
+				const_reference		at( size_type pos ) const
+				{
+					if (pos >= size())
+						throw std::out_of_range("vector::at: out_of_range: pos >= this->size()");
+					return ((*this)[pos]);
+				}
+
+				reference	operator[]( size_type pos )
+				{ return (*iterator_at_(pos)); }
+
+				const_reference		operator[]( size_type pos ) const
+				{ return (*iterator_at_(pos)); }
+
+				reference	front()
+				{ return (*begin()); }
+
+				const_reference		front() const
+				{ return (*begin()); }
+
+				reference	back()
+				{ return (*(end() - 1)); }
+
+				const_reference		back() const
+				{ return (*(end() - 1)); }
+
+			// Iterators
+				iterator	begin()
+				{ return (iterator(words_, 0)); }
+
+				const_iterator	begin() const
+				{ return (const_iterator(iterator(words_, 0))); }
+
+				iterator	end()
+				{ return (iterator_at_(size_)); }
+
+				const_iterator	end() const
+				{ return (iterator_at_(size_)); }
+
+				reverse_iterator	rbegin()
+				{ return (reverse_iterator(end())); }
+
+				const_reverse_iterator	rbegin() const
+				{ return (const_reverse_iterator(end())); }
+
+				reverse_iterator	rend()
+				{ return (reverse_iterator(begin())); }
+
+				const_reverse_iterator	rend() const
+				{ return (const_reverse_iterator(begin())); }
+
+			// Capacity
+				bool	empty() const
+				{ return (size_ == 0); }
+
+				size_type	size() const
+				{ return (size_); }
+
+				size_type	max_size() const
+				{
+					const size_type	diff_max = std::numeric_limits<difference_type>::max();
+					const size_type	word_max = alloc_().max_size();
+
+					if (word_max > diff_max / bit_word_bits_)
+						return (diff_max);
+					return (word_max * bit_word_bits_);
+				}
+
+				void	reserve( size_type new_cap )
+				{
+					if (new_cap > max_size())
+						throw std::length_error("vector::reserve: length_error: new_cap > max_size()");
+					if (new_cap > capacity())
+					{
+						size_type	new_words = words_for_(new_cap);
+						bit_word_*	new_first = alloc_().allocate(new_words);
+						size_type	used = words_for_(size_);
+
+						ft::copy(words_, words_ + used, new_first);
+						ft::fill(new_first + used, new_first + new_words, bit_word_(0));
+						deallocate_();
+						words_ = new_first;
+						capacity_ = new_words;
+					}
+				}
+
+				size_type	capacity() const
+				{ return (capacity_ * bit_word_bits_); }
+
+			// Modifiers
+				void	clear()
+				{ shrink_to_(0); }
+
+				iterator	insert( iterator pos, const bool& value )
+				{
+					size_type	offset = pos - begin();
+
+					insert_gap_(offset, 1);
+					(*this)[offset] = value;
+					return (iterator_at_(offset));
+				}
+
+				void	insert( iterator pos, size_type count, const bool& value )
+				{
+					size_type	offset = pos - begin();
+
+					insert_gap_(offset, count);
+					fill_(offset, offset + count, value);
+				}
+
+				template< class InputIt >
+				void	insert( iterator pos, InputIt first, InputIt last,
+								typename ft::enable_if<!ft::is_integral<InputIt>::value,
+														InputIt>::type* = NULL)
+				{ range_insert_(pos - begin(), first, last, ft::iterator_category(first)); }
+
+				iterator	erase( iterator pos )
+				{ return (erase(pos, pos + 1)); }
+
+				iterator	erase( iterator first, iterator last )
+				{
+					size_type	offset = first - begin();
+					size_type	count = last - first;
+
+					for (iterator src = last, stop = end(); src != stop; ++src, ++first)
+						*first = *src;
+					shrink_to_(size_ - count);
+					return (iterator_at_(offset));
+				}
+
+				void	push_back( const bool& value )
+				{
+					if (size_ == capacity())
+						reserve(calc_new_capacity_(size_ + 1));
+					if (value)
+						words_[size_ / bit_word_bits_] |= bit_word_(1) << (size_ % bit_word_bits_);
+					++size_;
+				}
+
+				void	pop_back()
+				{ shrink_to_(size_ - 1); }
+
+				void	resize( size_type count, bool value = false )
+				{
+					size_type	old_size = size_;
+
+					if (count < old_size)
+						shrink_to_(count);
+					else if (count > old_size)
+					{
+						reserve(count);
+						size_ = count;
+						if (value)
+							fill_(old_size, count, true);
+					}
+				}
+
+				void	swap( vector& other )
+				{
+					std::swap(words_, other.words_);
+					std::swap(size_, other.size_);
+					std::swap(capacity_, other.capacity_);
+					std::swap(alloc_(), other.alloc_());
+				}
+
+				static void	swap( reference x, reference y )
+				{
+					bool	tmp = x;
+
+					x = y;
+					y = tmp;
+				}
+
+				void	flip()
+				{
+					size_type	n = words_for_(size_);
+
+					for (size_type i = 0; i < n; ++i)
+						words_[i] = ~words_[i];
+					clear_tail_();
+				}
+
+			// Bit operations (a word at a time)
+				// number of set bits
+				size_type	count() const
+				{
+					size_type	n = words_for_(size_);
+					size_type	result = 0;
+
+					for (size_type i = 0; i < n; ++i)
+						result += __builtin_popcountl(words_[i]);
+					return (result);
+				}
+
+				// index of the first set bit, or npos
+				size_type	find_first() const
+				{ return (find_from_(0)); }
+
+				// index of the first set bit after pos, or npos
+				size_type	find_next( size_type pos ) const
+				{ return (pos < size_ ? find_from_(pos + 1) : npos); }
+
+				// the operands must have the same size
+				vector&		operator&=( const vector& other )
+				{
+					check_same_size_(other, "vector<bool>::operator&=: size mismatch");
+					for (size_type i = 0, n = words_for_(size_); i < n; ++i)
+						words_[i] &= other.words_[i];
+					return (*this);
+				}
+
+				vector&		operator|=( const vector& other )
+				{
+					check_same_size_(other, "vector<bool>::operator|=: size mismatch");
+					for (size_type i = 0, n = words_for_(size_); i < n; ++i)
+						words_[i] |= other.words_[i];
+					return (*this);
+				}
+
+				vector&		operator^=( const vector& other )
+				{
+					check_same_size_(other, "vector<bool>::operator^=: size mismatch");
+					for (size_type i = 0, n = words_for_(size_); i < n; ++i)
+						words_[i] ^= other.words_[i];
+					return (*this);
+				}
+
+				friend bool	operator==( const vector& lhs, const vector& rhs )
+				{
+					return (lhs.size_ == rhs.size_
+							&& std::equal(lhs.words_, lhs.words_ + words_for_(lhs.size_), rhs.words_));
+				}
+
+
+	private:
+		typedef typename Allocator::template rebind<bit_word_>::other	word_allocator_type;
+		typedef ft::ebo_holder_<word_allocator_type>					alloc_holder_;
+
+		// sizeof(ft::vector<bool>) == 3 * sizeof(void*), as the primary template
+		bit_word_*	words_;
+		size_type	size_;		// in bits
+		size_type	capacity_;	// in words
+
+		word_allocator_type&	alloc_()
+		{ return (alloc_holder_::get()); }
+
+		const word_allocator_type&	alloc_() const
+		{ return (alloc_holder_::get()); }
+
+		static size_type	words_for_( size_type bits )
+		{ return ((bits + bit_word_bits_ - 1) / bit_word_bits_); }
+
+		iterator	iterator_at_( size_type pos ) const
+		{ return (iterator(words_ + pos / bit_word_bits_, pos % bit_word_bits_)); }
+
+		void	deallocate_()
+		{
+			if (words_ != NULL)
+				alloc_().deallocate(words_, capacity_);
+			words_ = NULL;
+			capacity_ = 0;
+		}
+
+		// only when (_require_cap > current_cap), same growth as the primary template
+		size_type	calc_new_capacity_( size_type require_cap ) const
+		{
+			size_type	current_cap = capacity();
+			size_type	max = max_size();
+
+			if (require_cap > max || current_cap == max)
+				throw std::length_error("vector::allocate: length_error: new_cap > max_size()");
+			if (current_cap > require_cap / 2)
+				return (current_cap <= max / 2 ? current_cap * 2 : max);
+			return (require_cap);
+		}
+
+		// zero the bits past the end of the last word in use
+		void	clear_tail_()
+		{
+			if (size_ % bit_word_bits_ != 0)
+				words_[size_ / bit_word_bits_] &= (bit_word_(1) << (size_ % bit_word_bits_)) - 1;
+		}
+
+		// drop the bits [new_size, size_) and zero them
+		void	shrink_to_( size_type new_size )
+		{
+			size_type	first_word = words_for_(new_size);
+
+			ft::fill(words_ + first_word, words_ + words_for_(size_), bit_word_(0));
+			size_ = new_size;
+			clear_tail_();
+		}
+
+		// set the bits [first, last) word by word
+		void	fill_( size_type first, size_type last, bool value )
+		{
+			const bit_word_	fill_word = value ? ~bit_word_(0) : bit_word_(0);
+
+			for (; first != last && first % bit_word_bits_ != 0; ++first)
+				(*this)[first] = value;
+			for (; last - first >= size_type(bit_word_bits_); first += bit_word_bits_)
+				words_[first / bit_word_bits_] = fill_word;
+			for (; first != last; ++first)
+				(*this)[first] = value;
+		}
+
+		// open a gap of count bits at pos, moving [pos, size_) to the right (the caller fills it)
+		void	insert_gap_( size_type pos, size_type count )
+		{
+			size_type	old_size = size_;
+
+			if (count == 0)
+				return ;
+			if (old_size + count > capacity())
+				reserve(calc_new_capacity_(old_size + count));
+			size_ = old_size + count;
+			for (iterator src = iterator_at_(old_size), dest = end(), stop = iterator_at_(pos); src != stop; )
+				*--dest = *--src;
+		}
+
+		size_type	find_from_( size_type pos ) const
+		{
+			size_type	i = pos / bit_word_bits_;
+			size_type	n = words_for_(size_);
+			bit_word_	word;
+
+			if (pos >= size_)
+				return (npos);
+			word = words_[i] & (~bit_word_(0) << (pos % bit_word_bits_));
+			while (word == 0)
+			{
+				if (++i == n)
+					return (npos);
+				word = words_[i];
+			}
+			return (i * bit_word_bits_ + __builtin_ctzl(word));
+		}
+
+		void	check_same_size_( const vector& other, const char* what ) const
+		{
+			if (size_ != other.size_)
+				throw std::invalid_argument(what);
+		}
+
+		template<typename InputIt>
+		void	range_append_( InputIt first, InputIt last, ft::input_iterator_tag )
+		{
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		template<typename ForwardIt>
+		void	range_append_( ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
+		{
+			reserve(size_ + ft::distance(first, last));
+			for (; first != last; ++first)
+				push_back(*first);
+		}
+
+		template<typename InputIt>
+		void	range_insert_( size_type pos, InputIt first, InputIt last, ft::input_iterator_tag )
+		{
+			vector	tmp(first, last, get_allocator());
+
+			range_insert_(pos, tmp.begin(), tmp.end(), ft::forward_iterator_tag());
+		}
+
+		template<typename ForwardIt>
+		void	range_insert_( size_type pos, ForwardIt first, ForwardIt last, ft::forward_iterator_tag )
+		{
+			insert_gap_(pos, ft::distance(first, last));
+			for (iterator dest = iterator_at_(pos); first != last; ++first, ++dest)
+				*dest = *first;
+		}
+
+};	// class vector<bool>
+
+template< typename Allocator >
+const typename vector<bool, Allocator>::size_type	vector<bool, Allocator>::npos;
+
 
 }	// namespace ft
 
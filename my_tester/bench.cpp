@@ -0,0 +1,1316 @@
+// benchmarks for ft only extensions
+// usage: ./bench [name ...]	(run all benchmarks with no argument)
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <queue>
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/wait.h>
+
+#include "../containers/concurrent_stack.hpp"
+#include "../containers/deque.hpp"
+#include "../containers/intrusive_map.hpp"
+#include "../containers/map.hpp"
+#include "../containers/mmap_vector.hpp"
+#include "../containers/priority_queue.hpp"
+#include "../containers/radix_map.hpp"
+#include "../containers/segmented_vector.hpp"
+#include "../containers/soa_vector.hpp"
+#include "../containers/stack.hpp"
+#include "../containers/treap_map.hpp"
+#include "../containers/vector.hpp"
+#include "../utils/execution.hpp"
+
+class Timer
+{
+public:
+	Timer() { reset(); }
+
+	void reset() { clock_gettime(CLOCK_MONOTONIC, &start_); }
+
+	double ms() const
+	{
+		struct timespec now;
+		clock_gettime(CLOCK_MONOTONIC, &now);
+		return ((now.tv_sec - start_.tv_sec) * 1e3 + (now.tv_nsec - start_.tv_nsec) / 1e6);
+	}
+
+private:
+	struct timespec start_;
+};
+
+void report(const std::string& name, double ms)
+{ std::cout << "  " << std::left << std::setw(40) << name << std::right << std::setw(10) << std::fixed << std::setprecision(3) << ms << " ms" << std::endl; }
+
+// keep the optimizer from removing the measured work
+volatile size_t g_sink;
+
+double now_ns()
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec * 1e9 + now.tv_nsec);
+}
+
+// samples: latency of each operation in ns (sorted in place)
+void report_latency(const std::string& name, ft::vector<double>& samples)
+{
+	double total = 0;
+	for (size_t i = 0; i < samples.size(); ++i)
+		total += samples[i];
+	std::sort(samples.data(), samples.data() + samples.size());
+	std::cout << "  " << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(3)
+		<< std::setw(10) << total / 1e6 << " ms"
+		<< "  p99 " << std::setw(8) << std::setprecision(0) << samples[samples.size() * 99 / 100] << " ns"
+		<< "  p999 " << std::setw(8) << samples[samples.size() * 999 / 1000] << " ns"
+		<< "  max " << std::setw(10) << samples.back() << " ns" << std::endl;
+}
+
+
+// erase_if / erase_unordered vs repeated erase
+struct Connection
+{
+	int id;
+	int state;
+	char payload[56];
+};
+
+bool is_closed(const Connection& c) { return (c.state == 0); }
+
+void fill_connections(ft::vector<Connection>& v, size_t n)
+{
+	Connection c;
+	std::memset(&c, 0, sizeof(c));
+	v.clear();
+	for (size_t i = 0; i < n; ++i)
+	{
+		c.id = static_cast<int>(i);
+		c.state = (rand() % 32 != 0);	// drop about 3%
+		v.push_back(c);
+	}
+}
+
+void bench_erase()
+{
+	const size_t n = 200000;
+	ft::vector<Connection> v;
+	Timer t;
+
+	std::cout << "erase: drop ~3% of " << n << " connections" << std::endl;
+	srand(42);
+	fill_connections(v, n);
+	t.reset();
+	for (ft::vector<Connection>::iterator it = v.begin(); it != v.end(); )
+		it = is_closed(*it) ? v.erase(it) : it + 1;
+	report("repeated erase", t.ms());
+	g_sink = v.size();
+
+	srand(42);
+	fill_connections(v, n);
+	t.reset();
+	for (ft::vector<Connection>::iterator it = v.begin(); it != v.end(); )
+		it = is_closed(*it) ? v.erase_unordered(it) : it + 1;
+	report("repeated erase_unordered", t.ms());
+	g_sink = v.size();
+
+	srand(42);
+	fill_connections(v, n);
+	t.reset();
+	v.erase_if(is_closed);
+	report("erase_if", t.ms());
+	g_sink = v.size();
+}
+
+
+// startup of a table stored in a file: read into ft::vector vs reopen ft::mmap_vector
+struct Record
+{
+	int key;
+	int value;
+	char payload[56];
+};
+
+void bench_mmap()
+{
+	const size_t n = 1000000;
+	const char* raw_path = "/tmp/ft_bench_records.raw";
+	const char* mmap_path = "/tmp/ft_bench_records.mmap";
+	Record r;
+	Timer t;
+
+	std::cout << "mmap: load a table of " << n << " records (" << n * sizeof(Record) / (1024 * 1024) << " MB)" << std::endl;
+	std::memset(&r, 0, sizeof(r));
+	unlink(mmap_path);
+	{
+		FILE* raw = std::fopen(raw_path, "wb");
+		ft::mmap_vector<Record> table(mmap_path);
+		for (size_t i = 0; i < n; ++i)
+		{
+			r.key = static_cast<int>(i);
+			std::fwrite(&r, sizeof(r), 1, raw);
+			table.push_back(r);
+		}
+		std::fclose(raw);
+	}
+
+	t.reset();
+	{
+		ft::vector<Record> table;
+		FILE* raw = std::fopen(raw_path, "rb");
+		while (std::fread(&r, sizeof(r), 1, raw) == 1)
+			table.push_back(r);
+		std::fclose(raw);
+		g_sink = table.size();
+	}
+	report("read into ft::vector", t.ms());
+
+	t.reset();
+	{
+		ft::mmap_vector<Record> table(mmap_path);
+		g_sink = table.size();
+	}
+	report("reopen ft::mmap_vector", t.ms());
+
+	t.reset();
+	{
+		ft::mmap_vector<Record> table(mmap_path);
+		size_t sum = 0;
+		for (ft::mmap_vector<Record>::const_iterator it = table.begin(); it != table.end(); ++it)
+			sum += it->key;
+		g_sink = sum;
+	}
+	report("reopen ft::mmap_vector + full scan", t.ms());
+	unlink(raw_path);
+	unlink(mmap_path);
+}
+
+
+// push_back / pop_back latency of sequence containers
+struct Item
+{
+	char data[64];
+};
+
+template<typename Container>
+void bench_push_pop_latency(const std::string& name, size_t n)
+{
+	Container c;
+	Item item;
+	ft::vector<double> samples(n);
+	double start;
+
+	std::memset(&item, 0, sizeof(item));
+	{	// warm up the heap
+		Container warm;
+		for (size_t i = 0; i < n; ++i)
+			warm.push_back(item);
+	}
+	for (size_t i = 0; i < n; ++i)
+	{
+		start = now_ns();
+		c.push_back(item);
+		samples[i] = now_ns() - start;
+	}
+	report_latency(name + " push_back", samples);
+	for (size_t i = 0; i < n; ++i)
+	{
+		start = now_ns();
+		c.pop_back();
+		samples[i] = now_ns() - start;
+	}
+	report_latency(name + " pop_back", samples);
+}
+
+void bench_deque()
+{
+	const size_t n = 2000000;
+
+	std::cout << "deque: push / pop " << n << " items of " << sizeof(Item) << " bytes" << std::endl;
+	bench_push_pop_latency<ft::vector<Item> >("ft::vector", n);
+	bench_push_pop_latency<ft::deque<Item> >("ft::deque", n);
+	bench_push_pop_latency<std::deque<Item> >("std::deque", n);
+}
+
+
+// push latency of request-scoped work stacks (tail latency)
+template<typename Stack>
+void bench_stack_push_latency(const std::string& name, size_t n)
+{
+	Item item;
+	ft::vector<double> samples(n);
+	double start;
+
+	std::memset(&item, 0, sizeof(item));
+	{	// warm up the heap
+		Stack warm;
+		for (size_t i = 0; i < n; ++i)
+			warm.push(item);
+	}
+	Stack stack;
+	for (size_t i = 0; i < n; ++i)
+	{
+		start = now_ns();
+		stack.push(item);
+		samples[i] = now_ns() - start;
+	}
+	report_latency(name, samples);
+}
+
+void bench_stack()
+{
+	const size_t n = 4000000;
+
+	std::cout << "stack: push " << n << " items of " << sizeof(Item) << " bytes" << std::endl;
+	bench_stack_push_latency<ft::stack<Item> >("ft::stack<ft::vector>", n);
+	bench_stack_push_latency<ft::stack<Item, ft::deque<Item> > >("ft::stack<ft::deque>", n);
+	bench_stack_push_latency<ft::stack<Item, ft::segmented_vector<Item> > >("ft::stack<ft::segmented_vector>", n);
+}
+
+
+// shared LIFO of task pointers: ft::concurrent_stack vs ft::stack + mutex
+const size_t g_ops_per_thread = 1000000;
+
+struct LockedStack
+{
+	pthread_mutex_t mutex;
+	ft::stack<void*> stack;
+};
+
+void* locked_stack_worker(void* arg)
+{
+	LockedStack* s = static_cast<LockedStack*>(arg);
+	void* task = s;
+
+	for (size_t i = 0; i < g_ops_per_thread; ++i)
+	{
+		pthread_mutex_lock(&s->mutex);
+		s->stack.push(task);
+		pthread_mutex_unlock(&s->mutex);
+		pthread_mutex_lock(&s->mutex);
+		if (!s->stack.empty())
+		{
+			task = s->stack.top();
+			s->stack.pop();
+		}
+		pthread_mutex_unlock(&s->mutex);
+	}
+	return (NULL);
+}
+
+void* concurrent_stack_worker(void* arg)
+{
+	ft::concurrent_stack<void*>* s = static_cast<ft::concurrent_stack<void*>*>(arg);
+	void* task = s;
+
+	for (size_t i = 0; i < g_ops_per_thread; ++i)
+	{
+		s->push(task);
+		s->pop(task);
+	}
+	return (NULL);
+}
+
+double run_threads(size_t n, void* (*worker)(void*), void* arg)
+{
+	ft::vector<pthread_t> threads(n);
+	Timer t;
+
+	for (size_t i = 0; i < n; ++i)
+		pthread_create(&threads[i], NULL, worker, arg);
+	for (size_t i = 0; i < n; ++i)
+		pthread_join(threads[i], NULL);
+	return (t.ms());
+}
+
+void bench_concurrent_stack()
+{
+	const size_t max_threads = 8;
+
+	std::cout << "concurrent_stack: " << g_ops_per_thread << " push + pop per thread (Mops/s)" << std::endl;
+	for (size_t n = 1; n <= max_threads; n *= 2)
+	{
+		LockedStack locked;
+		pthread_mutex_init(&locked.mutex, NULL);
+		double locked_ms = run_threads(n, locked_stack_worker, &locked);
+		pthread_mutex_destroy(&locked.mutex);
+
+		ft::concurrent_stack<void*> lock_free(n * 2);
+		double lock_free_ms = run_threads(n, concurrent_stack_worker, &lock_free);
+
+		double ops = 2.0 * n * g_ops_per_thread / 1e3;
+		std::cout << "  threads " << std::setw(2) << n << std::fixed << std::setprecision(1)
+			<< "   ft::stack + mutex " << std::setw(8) << ops / locked_ms
+			<< "   ft::concurrent_stack " << std::setw(8) << ops / lock_free_ms << std::endl;
+	}
+}
+
+
+// priority_queue: push n random keys, then pop all, by arity
+template<typename Queue>
+void bench_priority_queue_one(const std::string& name, const ft::vector<int>& keys)
+{
+	Queue q;
+	Timer t;
+
+	for (size_t i = 0; i < keys.size(); ++i)
+		q.push(keys[i]);
+	double push_ms = t.ms();
+	t.reset();
+	size_t sum = 0;
+	while (!q.empty())
+	{
+		sum += q.top();
+		q.pop();
+	}
+	g_sink = sum;
+	report(name + " push", push_ms);
+	report(name + " pop", t.ms());
+}
+
+void bench_priority_queue()
+{
+	const size_t n = 4000000;
+	ft::vector<int> keys;
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(rand());
+	std::cout << "priority_queue: push / pop " << n << " random ints" << std::endl;
+	bench_priority_queue_one<std::priority_queue<int> >("std::priority_queue", keys);
+	bench_priority_queue_one<ft::priority_queue<int, ft::vector<int>, std::less<int>, 2> >("ft::priority_queue arity 2", keys);
+	bench_priority_queue_one<ft::priority_queue<int, ft::vector<int>, std::less<int>, 4> >("ft::priority_queue arity 4", keys);
+	bench_priority_queue_one<ft::priority_queue<int, ft::vector<int>, std::less<int>, 8> >("ft::priority_queue arity 8", keys);
+	bench_priority_queue_one<ft::priority_queue<int, ft::vector<int>, std::less<int>, 16> >("ft::priority_queue arity 16", keys);
+}
+
+
+// the hook sits next to the key: a lookup touches one cache line per level
+struct Session
+{
+	int id;
+	ft::rb_hook by_id;
+	char payload[56];
+};
+
+struct SessionId
+{
+	const int& operator()(const Session& s) const { return s.id; }
+};
+
+typedef ft::intrusive_map<int, Session, &Session::by_id, SessionId> SessionIndex;
+
+void bench_intrusive_map()
+{
+	const size_t n = 1000000;
+	ft::vector<Session> pool(n);
+	ft::vector<int> order;
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+	{
+		pool[i].id = rand();
+		order.push_back(pool[i].id);
+	}
+	std::random_shuffle(order.begin(), order.end());
+	std::cout << "intrusive_map: insert / find / erase " << n << " pooled sessions" << std::endl;
+	{
+		ft::map<int, Session*> index;
+		Timer t;
+		for (size_t i = 0; i < n; ++i)
+			index.insert(ft::make_pair(pool[i].id, &pool[i]));
+		report("ft::map<int, Session*> insert", t.ms());
+		t.reset();
+		size_t sum = 0;
+		for (size_t i = 0; i < n; ++i)
+			sum += index.find(order[i])->second->payload[0];
+		report("ft::map<int, Session*> find", t.ms());
+		t.reset();
+		for (size_t i = 0; i < n; ++i)
+			index.erase(order[i]);
+		report("ft::map<int, Session*> erase", t.ms());
+		g_sink = sum;
+	}
+	{
+		SessionIndex index;
+		Timer t;
+		for (size_t i = 0; i < n; ++i)
+			index.insert(pool[i]);
+		report("ft::intrusive_map insert", t.ms());
+		t.reset();
+		size_t sum = 0;
+		for (size_t i = 0; i < n; ++i)
+			sum += index.find(order[i])->payload[0];
+		report("ft::intrusive_map find", t.ms());
+		t.reset();
+		for (size_t i = 0; i < n; ++i)
+			index.erase(order[i]);
+		report("ft::intrusive_map erase", t.ms());
+		g_sink = sum;
+	}
+}
+
+template <class Map>
+void bench_int_map_one(const std::string& name, const ft::vector<int>& keys, const ft::vector<int>& lookups)
+{
+	Map m;
+	Timer t;
+
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	report(name + " insert", t.ms());
+	t.reset();
+	size_t sum = 0;
+	for (size_t i = 0; i < lookups.size(); ++i)
+		sum += m.find(lookups[i])->second;
+	report(name + " find", t.ms());
+	t.reset();
+	for (size_t i = 0; i < lookups.size(); i += 4)
+		sum += m.lower_bound(lookups[i] + 1)->first;
+	report(name + " lower_bound (1/4)", t.ms());
+	t.reset();
+	for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->second;
+	report(name + " iterate", t.ms());
+	g_sink = sum;
+}
+
+void bench_radix_map()
+{
+	const size_t sizes[] = { 1000000, 10000000 };	// 100M ft::map<int, int> needs ~8 GB
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+	{
+		const size_t n = sizes[s];
+		ft::vector<int> keys;
+		ft::vector<int> lookups;
+
+		for (size_t i = 0; i < n; ++i)
+			keys.push_back(static_cast<int>(i));
+		lookups = keys;
+		std::random_shuffle(lookups.begin(), lookups.end());
+		std::cout << "radix_map: " << n << " sequential keys, random lookups" << std::endl;
+		bench_int_map_one<ft::map<int, int> >("ft::map", keys, lookups);
+		bench_int_map_one<ft::radix_map<int, int> >("ft::radix_map", keys, lookups);
+
+		srand(42);
+		for (size_t i = 0; i < n; ++i)
+			keys[i] = rand() - RAND_MAX / 2;
+		lookups = keys;
+		std::random_shuffle(lookups.begin(), lookups.end());
+		std::cout << "radix_map: " << n << " random keys, random lookups" << std::endl;
+		bench_int_map_one<ft::map<int, int> >("ft::map", keys, lookups);
+		bench_int_map_one<ft::radix_map<int, int> >("ft::radix_map", keys, lookups);
+	}
+}
+
+// ranks drawn with probability ~ 1 / rank^skew (inverse transform over the cumulative weights)
+void zipf_lookups(ft::vector<int>& out, const ft::vector<int>& keys, double skew, size_t count)
+{
+	ft::vector<double> cumulative(keys.size());
+	double total = 0;
+
+	for (size_t rank = 0; rank < keys.size(); ++rank)
+	{
+		total += 1.0 / std::pow(static_cast<double>(rank + 1), skew);
+		cumulative[rank] = total;
+	}
+	out.clear();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const double u = (rand() + 0.5) / (RAND_MAX + 1.0) * total;
+		const double* first = cumulative.data();
+		out.push_back(keys[std::lower_bound(first, first + cumulative.size(), u) - first]);
+	}
+}
+
+template <class Map>
+void bench_zipf_one(const std::string& name, const ft::vector<int>& keys, const ft::vector<int>& lookups)
+{
+	Map m;
+
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(ft::make_pair(keys[i], static_cast<int>(i)));
+	Timer t;
+	size_t sum = 0;
+	for (size_t i = 0; i < lookups.size(); ++i)
+		sum += m.find(lookups[i])->second;
+	report(name + " find", t.ms());
+	g_sink = sum;
+}
+
+// each map is built in a child process, so all of them start from the same heap
+// (nodes freed by a previous map would otherwise scatter the next one)
+template <class Map>
+void bench_zipf_isolated(const std::string& name, const ft::vector<int>& keys, const ft::vector<int>& lookups)
+{
+	std::cout.flush();
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		bench_zipf_one<Map>(name, keys, lookups);
+		std::cout.flush();
+		_exit(0);
+	}
+	waitpid(pid, NULL, 0);
+}
+
+void bench_treap_map()
+{
+	const size_t n = 1000000;
+	const size_t count = 10000000;
+	const double skews[] = { 0.0, 0.8, 0.99, 1.2, 1.5 };
+	ft::vector<int> keys;
+	ft::vector<int> lookups;
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		keys.push_back(rand());
+	std::random_shuffle(keys.begin(), keys.end());	// hot keys are spread over the key space
+	for (size_t s = 0; s < sizeof(skews) / sizeof(skews[0]); ++s)
+	{
+		zipf_lookups(lookups, keys, skews[s], count);
+		std::cout << "treap_map: " << count << " zipf lookups in " << n << " keys, skew " << skews[s] << std::endl;
+		bench_zipf_isolated<ft::map<int, int> >("ft::map", keys, lookups);
+		bench_zipf_isolated<ft::treap_map<int, int> >("ft::treap_map", keys, lookups);
+	}
+}
+
+// packed ft::vector<bool> vs one byte per flag (std::vector<bool> for reference)
+template <class Bits>
+void bench_bits_one(const std::string& name, size_t n)
+{
+	Bits a, b;
+	Timer t;
+
+	unsigned seed = 42;
+	for (size_t i = 0; i < n; ++i)
+	{
+		seed = seed * 1103515245 + 12345;	// rand() would dominate the fill
+		a.push_back((seed >> 16) % 8 == 0);
+		b.push_back((seed >> 20) % 2 == 0);
+	}
+	report(name + " push_back x2", t.ms());
+	t.reset();
+	size_t sum = 0;
+	for (int r = 0; r < 10; ++r)
+		sum += std::count(a.begin(), a.end(), true);
+	report(name + " count (10 passes)", t.ms());
+	t.reset();
+	for (int r = 0; r < 10; ++r)
+		for (size_t i = 0; i < n; ++i)
+			a[i] = a[i] ^ b[i];
+	report(name + " xor (10 passes)", t.ms());
+	t.reset();
+	for (size_t i = 0; i < n; ++i)
+		if (a[i])
+			sum += i;
+	report(name + " walk set bits", t.ms());
+	g_sink = sum;
+}
+
+void bench_packed_bits(size_t n)
+{
+	ft::vector<bool> a, b;
+	Timer t;
+
+	unsigned seed = 42;
+	for (size_t i = 0; i < n; ++i)
+	{
+		seed = seed * 1103515245 + 12345;	// rand() would dominate the fill
+		a.push_back((seed >> 16) % 8 == 0);
+		b.push_back((seed >> 20) % 2 == 0);
+	}
+	report("ft::vector<bool> push_back x2", t.ms());
+	t.reset();
+	size_t sum = 0;
+	for (int r = 0; r < 10; ++r)
+		sum += a.count();
+	report("ft::vector<bool> count (10 passes)", t.ms());
+	t.reset();
+	for (int r = 0; r < 10; ++r)
+		a ^= b;
+	report("ft::vector<bool> xor (10 passes)", t.ms());
+	t.reset();
+	for (size_t i = a.find_first(); i != ft::vector<bool>::npos; i = a.find_next(i))
+		sum += i;
+	report("ft::vector<bool> walk set bits", t.ms());
+	g_sink = sum;
+}
+
+void bench_vector_bool()
+{
+	const size_t n = size_t(1) << 28;
+
+	std::cout << "vector<bool>: " << n << " flags, " << n / 8 / 1024 / 1024 << " MB packed vs "
+		<< n / 1024 / 1024 << " MB as bytes" << std::endl;
+	bench_bits_one<ft::vector<unsigned char> >("ft::vector<unsigned char>", n);
+	bench_bits_one<std::vector<bool> >("std::vector<bool>", n);
+	bench_packed_bits(n);
+}
+
+// single field scans: ft::vector of 64 byte records vs ft::soa_vector of the same fields
+struct Order
+{
+	long id;
+	double price;
+	double qty;
+	double fee;
+	double tax;
+	long created;
+	long owner;
+	long flags;
+};
+
+typedef ft::soa_vector<long, double, double, double, double, long, long, long> OrderTable;
+
+void bench_soa_vector()
+{
+	const size_t n = 25000000;	// 100M rows of 64 bytes would need 6.4 GB for the vector alone
+	long sum = 0;
+	double total = 0;
+	Timer t;
+
+	std::cout << "soa_vector: " << n << " rows of " << sizeof(Order) << " bytes" << std::endl;
+	{
+		ft::vector<Order> rows;
+		rows.reserve(n);
+		t.reset();
+		for (size_t i = 0; i < n; ++i)
+		{
+			Order r = { long(i), i * 0.25, 1.0, 0.5, 0.1, long(i), long(i % 1000), 0 };
+			rows.push_back(r);
+		}
+		report("ft::vector<Order> push_back", t.ms());
+		t.reset();
+		for (int r = 0; r < 5; ++r)
+			for (size_t i = 0; i < n; ++i)
+				sum += rows[i].owner;
+		report("ft::vector<Order> sum owner (5 passes)", t.ms());
+		t.reset();
+		for (int r = 0; r < 5; ++r)
+			for (size_t i = 0; i < n; ++i)
+				total += rows[i].price * rows[i].qty;
+		report("ft::vector<Order> sum price * qty (5)", t.ms());
+	}
+	{
+		OrderTable table;
+		table.reserve(n);
+		t.reset();
+		for (size_t i = 0; i < n; ++i)
+			table.push_back(OrderTable::value_type(long(i), i * 0.25, 1.0, 0.5, 0.1, long(i), long(i % 1000), 0));
+		report("ft::soa_vector push_back", t.ms());
+		t.reset();
+		for (int r = 0; r < 5; ++r)
+		{
+			ft::soa_span<const long> owner = static_cast<const OrderTable&>(table).column<6>();
+			for (size_t i = 0; i < owner.size(); ++i)
+				sum += owner[i];
+		}
+		report("ft::soa_vector sum owner (5 passes)", t.ms());
+		t.reset();
+		for (int r = 0; r < 5; ++r)
+		{
+			ft::soa_span<double> price = table.column<1>();
+			ft::soa_span<double> qty = table.column<2>();
+			for (size_t i = 0; i < price.size(); ++i)
+				total += price[i] * qty[i];
+		}
+		report("ft::soa_vector sum price * qty (5)", t.ms());
+		t.reset();
+		for (int r = 0; r < 5; ++r)
+			for (OrderTable::iterator it = table.begin(); it != table.end(); ++it)
+				sum += (*it).get<6>();
+		report("ft::soa_vector sum owner, rows (5)", t.ms());
+	}
+	g_sink = static_cast<size_t>(sum + total);
+}
+
+// operator== / operator< of 1 MB vectors: the byte compare kernels vs the element loop,
+// which the predicate overloads of ft::equal / ft::lexicographical_compare still use
+template <typename T>
+void bench_compare_one(const std::string& name)
+{
+	const size_t n = (1 << 20) / sizeof(T);
+	const int rounds = 2000;
+	ft::vector<T> a(n, T(1));
+	ft::vector<T> b(a);
+	size_t hits = 0;
+	Timer t;
+
+	b.back() = T(2);	// the ranges differ only at the last element
+	for (int r = 0; r < rounds; ++r)
+		hits += ft::equal(a.begin(), a.end(), b.begin(), std::equal_to<T>());
+	report(name + " ==, element loop", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		hits += (a == b);
+	report(name + " ==", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		hits += ft::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), std::less<T>());
+	report(name + " <, element loop", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		hits += (a < b);
+	report(name + " <", t.ms());
+	g_sink = hits;
+}
+
+void bench_compare()
+{
+	std::cout << "compare: 1 MB vectors which differ at the last element, 2000 rounds" << std::endl;
+	bench_compare_one<char>("ft::vector<char>");
+	bench_compare_one<int>("ft::vector<int>");
+}
+
+// an allocator which is not std::allocator: ft::vector then constructs element by element,
+// which is what every transfer did before the copy / fill algorithms
+template <typename T>
+struct ElementAllocator : public std::allocator<T>
+{
+	ElementAllocator() {}
+	template <typename U>
+	ElementAllocator(const ElementAllocator<U>&) {}
+	template <typename U>
+	struct rebind { typedef ElementAllocator<U> other; };
+};
+
+template <typename Vec>
+void bench_copy_one(const std::string& name, const Vec& src)
+{
+	const int rounds = 200;
+	const size_t n = src.size();
+	size_t sum = 0;
+	Timer t;
+
+	for (int r = 0; r < rounds; ++r)
+	{
+		Vec v(src);
+		sum += v[r];
+	}
+	report(name + " copy construct", t.ms());
+	Vec v;
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+	{
+		v.assign(n, r);
+		sum += v[r];
+	}
+	report(name + " assign(n, value)", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+	{
+		v.insert(v.begin() + 1, src.begin(), src.begin() + n / 8);
+		v.erase(v.begin() + 1, v.begin() + 1 + n / 8);
+		sum += v[r];
+	}
+	report(name + " insert + erase n/8", t.ms());
+	g_sink = sum;
+}
+
+void bench_copy()
+{
+	const size_t n = 1 << 20;
+	std::vector<int> std_ints(n);
+	ft::vector<int> ints(n);
+	ft::vector<int, ElementAllocator<int> > loop_ints(n);
+
+	for (size_t i = 0; i < n; ++i)
+		std_ints[i] = ints[i] = loop_ints[i] = static_cast<int>(i);
+	std::cout << "copy: vectors of " << n << " ints, 200 rounds" << std::endl;
+	bench_copy_one("std::vector", std_ints);
+	bench_copy_one("ft::vector, loop", loop_ints);
+	bench_copy_one("ft::vector", ints);
+}
+
+// ft::sort (radix for integral keys, pdqsort otherwise) / ft::stable_sort vs std::sort / std::stable_sort
+template <typename T, typename Sort>
+void bench_sort_one(const std::string& name, const ft::vector<T>& input, Sort sort)
+{
+	ft::vector<T> v(input);
+	Timer t;
+
+	sort(v.data(), v.data() + v.size());
+	report(name, t.ms());
+	g_sink = static_cast<size_t>(v[v.size() / 2] == v[0]);
+}
+
+template <typename T>
+void ft_sort(T* first, T* last) { ft::sort(first, last); }
+
+template <typename T>
+void ft_sort_less(T* first, T* last) { ft::sort(first, last, std::less<T>()); }
+
+template <typename T>
+void ft_stable_sort(T* first, T* last) { ft::stable_sort(first, last); }
+
+template <typename T>
+void std_sort(T* first, T* last) { std::sort(first, last); }
+
+template <typename T>
+void std_stable_sort(T* first, T* last) { std::stable_sort(first, last); }
+
+template <typename T>
+void bench_sort_all(const std::string& what, const ft::vector<T>& input)
+{
+	std::cout << "sort: " << input.size() << " " << what << std::endl;
+	bench_sort_one("std::sort", input, std_sort<T>);
+	bench_sort_one("ft::sort", input, ft_sort<T>);
+	bench_sort_one("ft::sort, std::less (pdqsort)", input, ft_sort_less<T>);
+	bench_sort_one("std::stable_sort", input, std_stable_sort<T>);
+	bench_sort_one("ft::stable_sort", input, ft_stable_sort<T>);
+}
+
+void bench_sort()
+{
+	const size_t n = 10000000;
+	ft::vector<int> ints(n);
+	ft::vector<ft::pair<int, int> > pairs(n);
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		ints[i] = rand() - RAND_MAX / 2;
+	bench_sort_all("random ints", ints);
+	for (size_t i = 0; i < n; ++i)
+		pairs[i] = ft::make_pair(rand() % 1000, rand());
+	bench_sort_all("random pairs", pairs);
+	for (size_t i = 0; i < n; ++i)
+		ints[i] = (i % 1000 == 0) ? rand() : static_cast<int>(i);
+	bench_sort_all("nearly sorted ints", ints);
+}
+
+// lower_bound of random keys in a sorted vector: std::lower_bound, the branchless ft::lower_bound,
+// and ft::lower_bound_many (the searches of a batch go down the levels together)
+template <typename T>
+void bench_search_one(const std::string& what, size_t n, size_t queries)
+{
+	ft::vector<T> sorted(n);
+	ft::vector<T> keys(queries);
+	ft::vector<const T*> found(queries);
+	size_t sum = 0;
+
+	for (size_t i = 0; i < n; ++i)
+		sorted[i] = static_cast<T>(i * 2);
+	for (size_t i = 0; i < queries; ++i)
+		keys[i] = static_cast<T>((static_cast<size_t>(rand()) * RAND_MAX + rand()) % (n * 2));
+	std::cout << "search: " << queries << " lower_bound in " << n << " " << what << std::endl;
+
+	const T* first = sorted.data();
+	const T* last = first + n;
+	Timer t;
+	for (size_t i = 0; i < queries; ++i)
+		sum += std::lower_bound(first, last, keys[i]) - first;
+	report("std::lower_bound", t.ms());
+	t.reset();
+	for (size_t i = 0; i < queries; ++i)
+		sum += ft::lower_bound(first, last, keys[i]) - first;
+	report("ft::lower_bound", t.ms());
+	t.reset();
+	ft::lower_bound_many(first, last, keys.begin(), keys.end(), found.begin());
+	for (size_t i = 0; i < queries; ++i)
+		sum += found[i] - first;
+	report("ft::lower_bound_many", t.ms());
+	g_sink = sum;
+}
+
+void bench_search()
+{
+	srand(42);
+	bench_search_one<int>("ints (16 KB)", 1 << 12, 1 << 22);
+	bench_search_one<int>("ints (256 MB)", 1 << 26, 1 << 22);
+	bench_search_one<unsigned long>("uint64 (256 MB)", 1 << 25, 1 << 22);
+}
+
+// p50 / p90 / p99 / p99.9 of 10M latency samples: full sort, nth_element per percentile,
+// and ft::quantiles (all the ranks in one pass). every variant gets its own copy of the samples
+void bench_select_one(const std::string& name, const ft::vector<double>& samples, int variant)
+{
+	const double qs[4] = { 0.5, 0.9, 0.99, 0.999 };
+	const size_t n = samples.size();
+	ft::vector<double> v(samples);
+	double found[4];
+	Timer t;
+
+	if (variant == 0)
+		std::sort(v.data(), v.data() + n);
+	for (int i = 0; i < 4 && variant != 3; ++i)
+	{
+		double* nth = v.data() + static_cast<size_t>(qs[i] * (n - 1));
+		if (variant == 1)
+			std::nth_element(v.data(), nth, v.data() + n);
+		else if (variant == 2)
+			ft::nth_element(v.data(), nth, v.data() + n);
+		found[i] = *nth;
+	}
+	if (variant == 3)
+		ft::quantiles(v.begin(), v.end(), qs, qs + 4, found);
+	report(name, t.ms());
+	g_sink = static_cast<size_t>(found[0] + found[1] + found[2] + found[3]);
+}
+
+void bench_select()
+{
+	const size_t n = 10000000;
+	ft::vector<double> samples(n);
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)	// long tail: most samples small, a few large
+		samples[i] = -std::log((rand() + 1.0) / (RAND_MAX + 2.0)) * 100.0;
+	std::cout << "select: p50 p90 p99 p99.9 of " << n << " samples" << std::endl;
+	bench_select_one("std::sort", samples, 0);
+	bench_select_one("std::nth_element x 4", samples, 1);
+	bench_select_one("ft::nth_element x 4", samples, 2);
+	bench_select_one("ft::quantiles", samples, 3);
+
+	ft::vector<double> v(samples);
+	Timer t;
+	std::partial_sort(v.data(), v.data() + 1000, v.data() + n);
+	report("std::partial_sort, 1000 smallest", t.ms());
+	v = samples;
+	t.reset();
+	ft::partial_sort(v.begin(), v.begin() + 1000, v.end());
+	report("ft::partial_sort, 1000 smallest", t.ms());
+	g_sink = static_cast<size_t>(v[999]);
+}
+
+// intersection of sorted posting lists (uint32) of skewed sizes: the long list has 4M ids,
+// the short one 4M / ratio. ft gallops above 1:32, and runs the SSE2 kernel below
+// (ft with std::less is the scalar merge)
+void random_postings(ft::vector<unsigned>& out, size_t n, unsigned max_gap)
+{
+	unsigned id = 0;
+
+	out.resize(n);
+	for (size_t i = 0; i < n; ++i)
+		out[i] = (id += 1 + rand() % max_gap);
+}
+
+void bench_set_ops()
+{
+	const size_t n = 1 << 22;
+	const int rounds = 10;
+	ft::vector<unsigned> large;
+	ft::vector<unsigned> out(n);
+
+	srand(42);
+	random_postings(large, n, 4);
+	std::cout << "set_ops: " << n << " uint32 ids against n / ratio, " << rounds << " rounds" << std::endl;
+	for (size_t ratio = 1; ratio <= 10000; ratio *= 10)
+	{
+		ft::vector<unsigned> small;
+		random_postings(small, n / ratio, static_cast<unsigned>(4 * ratio));
+		const unsigned* l = large.data();
+		const unsigned* s = small.data();
+		std::ostringstream prefix;
+		prefix << "1:" << ratio << " ";
+		size_t found = 0;
+
+		Timer t;
+		for (int r = 0; r < rounds; ++r)
+			found += std::set_intersection(s, s + small.size(), l, l + n, out.data()) - out.data();
+		report(prefix.str() + "std::set_intersection", t.ms());
+		if (ratio < 32)
+		{
+			t.reset();
+			for (int r = 0; r < rounds; ++r)
+				found += ft::set_intersection(s, s + small.size(), l, l + n, out.data(), std::less<unsigned>()) - out.data();
+			report(prefix.str() + "ft, scalar merge", t.ms());
+		}
+		t.reset();
+		for (int r = 0; r < rounds; ++r)
+			found += ft::set_intersection(small.begin(), small.end(), large.begin(), large.end(), out.begin()) - out.begin();
+		report(prefix.str() + "ft::set_intersection", t.ms());
+		if (ratio == 1000)
+		{
+			ft::vector<unsigned> all(n + small.size());
+			t.reset();
+			for (int r = 0; r < rounds; ++r)
+				found += std::set_union(s, s + small.size(), l, l + n, all.data()) - all.data();
+			report(prefix.str() + "std::set_union", t.ms());
+			t.reset();
+			for (int r = 0; r < rounds; ++r)
+				found += ft::set_union(small.begin(), small.end(), large.begin(), large.end(), all.begin()) - all.begin();
+			report(prefix.str() + "ft::set_union", t.ms());
+			t.reset();
+			for (int r = 0; r < rounds; ++r)
+				found += std::set_difference(l, l + n, s, s + small.size(), all.data()) - all.data();
+			report(prefix.str() + "std::set_difference", t.ms());
+			t.reset();
+			for (int r = 0; r < rounds; ++r)
+				found += ft::set_difference(large.begin(), large.end(), small.begin(), small.end(), all.begin()) - all.begin();
+			report(prefix.str() + "ft::set_difference", t.ms());
+		}
+		g_sink = found;
+	}
+}
+
+// the plain loops (std::) against ft's vector kernels, over a range which fits no cache
+template <class T>
+void bench_simd_one(const std::string& type, size_t n, int rounds)
+{
+	ft::vector<T> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = static_cast<T>(rand() % 1000);
+	const T* p = v.data();
+	const T missing = static_cast<T>(-1);
+	size_t found = 0;
+
+	Timer t;
+	for (int r = 0; r < rounds; ++r)
+		found += static_cast<size_t>(std::accumulate(p, p + n, T()));
+	report(type + " std::accumulate", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += static_cast<size_t>(ft::sum(v.begin(), v.end()));
+	report(type + " ft::sum", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += static_cast<size_t>(*std::min_element(p, p + n) + *std::max_element(p, p + n));
+	report(type + " std::min_element + max_element", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+	{
+		ft::pair<T, T> range = ft::minmax(v.begin(), v.end());
+		found += static_cast<size_t>(range.first + range.second);
+	}
+	report(type + " ft::minmax", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += std::count(p, p + n, static_cast<T>(r));
+	report(type + " std::count", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += ft::count(v.begin(), v.end(), static_cast<T>(r));
+	report(type + " ft::count", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += std::find(p, p + n, missing) - p;
+	report(type + " std::find (absent)", t.ms());
+	t.reset();
+	for (int r = 0; r < rounds; ++r)
+		found += ft::find(v.begin(), v.end(), missing) - v.begin();
+	report(type + " ft::find (absent)", t.ms());
+	g_sink = found;
+}
+
+void bench_simd()
+{
+	const size_t n = 1 << 22;
+	const int rounds = 20;
+
+	srand(42);
+	std::cout << "simd: " << n << " elements, " << rounds << " rounds" << std::endl;
+	bench_simd_one<int>("int", n, rounds);
+	bench_simd_one<long>("long", n, rounds);
+	bench_simd_one<float>("float", n, rounds);
+	bench_simd_one<double>("double", n, rounds);
+}
+
+// ft::execution::par on 1, 2, 4... threads (pools of threads - 1 workers): strong scaling, same input
+struct ScaleSquare
+{
+	long operator()(int x) const { return (static_cast<long>(x) * x); }
+};
+
+void bench_parallel()
+{
+	const size_t n = 50000000;
+	size_t hardware = ft::thread_pool::default_workers() + 1;
+	ft::vector<int> input(n), v;
+	ft::vector<long> squares(n);
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		input[i] = rand() - RAND_MAX / 2;
+	std::cout << "parallel: " << n << " random ints, " << hardware << " hardware threads" << std::endl;
+	for (size_t threads = 1; threads <= (hardware > 4 ? hardware : 4); threads *= 2)
+	{
+		ft::thread_pool pool(threads - 1);
+		ft::execution::parallel_policy par = ft::execution::par.on(pool);
+		std::ostringstream suffix;
+		suffix << ", " << threads << " threads";
+		Timer t;
+
+		ft::transform(par, input.begin(), input.end(), squares.begin(), ScaleSquare());
+		report("transform" + suffix.str(), t.ms());
+		t.reset();
+		g_sink = static_cast<size_t>(ft::reduce(par, squares.begin(), squares.end()));
+		report("reduce" + suffix.str(), t.ms());
+		v = input;
+		t.reset();
+		ft::sort(par, v.begin(), v.end());
+		report("sort" + suffix.str(), t.ms());
+		t.reset();
+		g_sink = static_cast<size_t>(ft::equal(par, v.begin(), v.end(), v.begin()));
+		report("equal" + suffix.str(), t.ms());
+	}
+}
+
+// full scans of a map built in random order (nodes spread over the heap), plain vs threaded iterators
+template <typename Map>
+void bench_map_scan_one(const std::string& name, const ft::vector<int>& keys)
+{
+	Map m;
+	for (size_t i = 0; i < keys.size(); ++i)
+		m.insert(typename Map::value_type(keys[i], static_cast<long>(i)));
+
+	long sum = 0;
+	Timer t;
+	for (int round = 0; round < 10; ++round)
+		for (typename Map::const_iterator it = m.begin(); it != m.end(); ++it)
+			sum += it->second;
+	report(name + ", forward", t.ms());
+	t.reset();
+	for (int round = 0; round < 10; ++round)
+		for (typename Map::const_reverse_iterator it = m.rbegin(); it != m.rend(); ++it)
+			sum += it->second;
+	report(name + ", reverse", t.ms());
+	g_sink = static_cast<size_t>(sum);
+}
+
+// in a child process each, so that no map scans the heap left over by another one
+template <typename Map>
+void bench_map_scan_isolated(const std::string& name, const ft::vector<int>& keys)
+{
+	std::cout.flush();
+	pid_t pid = fork();
+	if (pid == 0)
+	{
+		bench_map_scan_one<Map>(name, keys);
+		std::cout.flush();
+		_exit(0);
+	}
+	waitpid(pid, NULL, 0);
+}
+
+void bench_map_scan_all(const std::string& what, const ft::vector<int>& keys)
+{
+	std::cout << "map_scan: 10 full scans of " << keys.size() << " " << what << std::endl;
+	bench_map_scan_isolated<std::map<int, long> >("std::map", keys);
+	bench_map_scan_isolated<ft::map<int, long> >("ft::map", keys);
+	bench_map_scan_isolated<ft::map<int, long, std::less<int>, std::allocator<ft::pair<const int, long> >, true> >(
+		"ft::map, threaded", keys);
+}
+
+void bench_map_scan()
+{
+	const size_t n = 1000000;
+	ft::vector<int> keys(n);
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		keys[i] = rand();
+	bench_map_scan_all("random keys", keys);
+	for (size_t i = 0; i < n; ++i)
+		keys[i] = static_cast<int>(i);
+	bench_map_scan_all("ascending keys (nodes in address order)", keys);
+}
+
+// parallel_reduce / parallel_for_each over a read-only map, on 1, 2, 4... threads (strong scaling)
+struct MappedValue
+{
+	long operator()(const ft::pair<const int, long>& value) const { return (value.second); }
+};
+
+struct SumLong
+{
+	long operator()(long lhs, long rhs) const { return (lhs + rhs); }
+};
+
+struct TouchValue
+{
+	void operator()(const ft::pair<const int, long>& value) const { g_sink = static_cast<size_t>(value.second); }
+};
+
+void bench_parallel_map()
+{
+	const size_t n = 4000000;
+	size_t hardware = ft::thread_pool::default_workers() + 1;
+	ft::map<int, long> m;
+
+	srand(42);
+	for (size_t i = 0; i < n; ++i)
+		m.insert(ft::make_pair(rand(), static_cast<long>(i)));
+	std::cout << "parallel_map: " << m.size() << " random keys, " << hardware << " hardware threads" << std::endl;
+
+	Timer t;
+	long sum = 0;
+	for (ft::map<int, long>::const_iterator it = m.begin(); it != m.end(); ++it)
+		sum += it->second;
+	report("serial loop", t.ms());
+	for (size_t threads = 1; threads <= (hardware > 4 ? hardware : 4); threads *= 2)
+	{
+		ft::thread_pool pool(threads - 1);
+		ft::execution::parallel_policy par = ft::execution::par.on(pool);
+		std::ostringstream suffix;
+		suffix << ", " << threads << " threads";
+
+		t.reset();
+		sum += ft::parallel_reduce(par, m.begin(), m.end(), 0L, SumLong(), MappedValue());
+		report("parallel_reduce" + suffix.str(), t.ms());
+		t.reset();
+		ft::parallel_for_each(par, m.begin(), m.end(), TouchValue());
+		report("parallel_for_each" + suffix.str(), t.ms());
+	}
+	g_sink = static_cast<size_t>(sum);
+}
+
+struct Benchmark
+{
+	const char* name;
+	void (*run)();
+};
+
+const Benchmark g_benchmarks[] = {
+	{ "erase", bench_erase },
+	{ "mmap", bench_mmap },
+	{ "deque", bench_deque },
+	{ "stack", bench_stack },
+	{ "concurrent_stack", bench_concurrent_stack },
+	{ "priority_queue", bench_priority_queue },
+	{ "intrusive_map", bench_intrusive_map },
+	{ "radix_map", bench_radix_map },
+	{ "treap_map", bench_treap_map },
+	{ "vector_bool", bench_vector_bool },
+	{ "soa_vector", bench_soa_vector },
+	{ "compare", bench_compare },
+	{ "copy", bench_copy },
+	{ "sort", bench_sort },
+	{ "search", bench_search },
+	{ "select", bench_select },
+	{ "set_ops", bench_set_ops },
+	{ "simd", bench_simd },
+	{ "parallel", bench_parallel },
+	{ "map_scan", bench_map_scan },
+	{ "parallel_map", bench_parallel_map },
+};
+
+int main(int argc, char** argv)
+{
+	const size_t count = sizeof(g_benchmarks) / sizeof(g_benchmarks[0]);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		bool selected = (argc == 1);
+		for (int j = 1; j < argc; ++j)
+			if (std::strcmp(argv[j], g_benchmarks[i].name) == 0)
+				selected = true;
+		if (selected)
+			g_benchmarks[i].run();
+	}
+	return (0);
+}
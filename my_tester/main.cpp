@@ -1,22 +1,42 @@
 #include <iostream>
 #include <string>
-#include <deque>
+#include <list>
+#include <sstream>
+#include <iterator>
+#include <functional>
 #if !FT //CREATE A REAL STL EXAMPLE
+	#include <algorithm>
+	#include <deque>
 	#include <map>
+	#include <queue>
+	#include <set>
 	#include <stack>
 	#include <vector>
 	namespace ft = std;
 #else
+	#include "../containers/concurrent_stack.hpp"
+	#include "../containers/deque.hpp"
+	#include "../containers/intrusive_map.hpp"
 	#include "../containers/map.hpp"
+	#include "../containers/mmap_vector.hpp"
+	#include "../containers/priority_queue.hpp"
+	#include "../containers/radix_map.hpp"
+	#include "../containers/segmented_vector.hpp"
+	#include "../containers/set.hpp"
+	#include "../containers/soa_vector.hpp"
 	#include "../containers/stack.hpp"
+	#include "../containers/treap_map.hpp"
 	#include "../containers/vector.hpp"
 	#include "../utils/algorithm.hpp"
+	#include "../utils/execution.hpp"
 	#include "../utils/iterator.hpp"
 	#include "../utils/pair.hpp"
 	#include "../utils/util.hpp"
 #endif
 
 #include <stdlib.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #define MAX_RAM 4294967296
 #define BUFFER_SIZE 4096
@@ -29,6 +49,8 @@ struct Buffer
 
 #define COUNT (MAX_RAM / (int)sizeof(Buffer))
 
+bool by_first(const ft::pair<int, int>& lhs, const ft::pair<int, int>& rhs) { return (lhs.first < rhs.first); }
+
 template<typename T>
 class MutantStack : public ft::stack<T>
 {
@@ -48,6 +70,1330 @@ public:
 	iterator end() { return this->c.end(); }
 };
 
+#if FT	// tests for ft only extensions (report to stderr, so the result diff is not affected)
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <vector>
+
+// allocator which fills every new block with a pattern, to see which bytes are written
+template<typename T>
+class PatternAllocator : public std::allocator<T>
+{
+public:
+	typedef typename std::allocator<T>::pointer pointer;
+	typedef typename std::allocator<T>::size_type size_type;
+
+	PatternAllocator() {}
+	PatternAllocator(const PatternAllocator& src) : std::allocator<T>(src) {}
+	template<typename U>
+	PatternAllocator(const PatternAllocator<U>& src) : std::allocator<T>(src) {}
+	template<typename U>
+	struct rebind { typedef PatternAllocator<U> other; };
+
+	pointer allocate(size_type n)
+	{
+		pointer p = std::allocator<T>::allocate(n);
+		std::memset(static_cast<void*>(p), 0xAB, n * sizeof(T));
+		return p;
+	}
+};
+
+// allocator whose allocations_to_fail-th allocation (counted down, 0: none) throws bad_alloc
+int allocations_to_fail = 0;
+
+template<typename T>
+class FailingAllocator : public std::allocator<T>
+{
+public:
+	typedef typename std::allocator<T>::pointer pointer;
+	typedef typename std::allocator<T>::size_type size_type;
+
+	FailingAllocator() {}
+	FailingAllocator(const FailingAllocator& src) : std::allocator<T>(src) {}
+	template<typename U>
+	FailingAllocator(const FailingAllocator<U>& src) : std::allocator<T>(src) {}
+	template<typename U>
+	struct rebind { typedef FailingAllocator<U> other; };
+
+	pointer allocate(size_type n, const void* hint = 0)
+	{
+		if (allocations_to_fail > 0 && --allocations_to_fail == 0)
+			throw std::bad_alloc();
+		return std::allocator<T>::allocate(n, hint);
+	}
+};
+
+void test_resize_default_init()
+{
+	ft::vector<unsigned char, PatternAllocator<unsigned char> > bytes;
+
+	bytes.resize_default_init(BUFFER_SIZE);
+	if (bytes.size() != BUFFER_SIZE)
+		std::cerr << "Error: resize_default_init: wrong size" << std::endl;
+	for (size_t i = 0; i < bytes.size(); ++i)
+		if (bytes[i] != 0xAB)
+		{
+			std::cerr << "Error: resize_default_init: new region is written" << std::endl;
+			break;
+		}
+	bytes.resize_default_init(10);
+	if (bytes.size() != 10)
+		std::cerr << "Error: resize_default_init: wrong size after shrink" << std::endl;
+
+	ft::vector<std::string> strs(3, "abc");
+	strs.resize_default_init(5);
+	if (strs.size() != 5 || strs[2] != "abc" || !strs[4].empty())
+		std::cerr << "Error: resize_default_init: non trivial type is not constructed" << std::endl;
+}
+
+bool is_odd(int n) { return (n % 2 != 0); }
+
+void test_erase_unordered_and_erase_if()
+{
+	ft::vector<int> v;
+	for (int i = 0; i < 10; ++i)
+		v.push_back(i);
+
+	ft::vector<int>::iterator it = v.erase_unordered(v.begin() + 2);
+	if (v.size() != 9 || *it != 9 || v.back() != 8)
+		std::cerr << "Error: erase_unordered: wrong result" << std::endl;
+	v.erase_unordered(v.end() - 1);
+	if (v.size() != 8 || v.back() != 7)
+		std::cerr << "Error: erase_unordered: wrong result at back" << std::endl;
+
+	// 0 1 9 3 4 5 6 7
+	if (v.erase_if(is_odd) != 5 || v.size() != 3 || v[0] != 0 || v[1] != 4 || v[2] != 6)
+		std::cerr << "Error: erase_if: wrong result" << std::endl;
+	if (v.erase_if(is_odd) != 0 || v.size() != 3)
+		std::cerr << "Error: erase_if: erased with no match" << std::endl;
+}
+
+void test_mmap_vector()
+{
+	const char* path = "/tmp/ft_mmap_vector_test";
+	unlink(path);
+	{
+		ft::mmap_vector<int> v(path);
+		for (int i = 0; i < 100000; ++i)
+			v.push_back(i);
+		v.flush();
+	}
+	{
+		ft::mmap_vector<int> v(path);
+		if (v.size() != 100000 || v[0] != 0 || v.back() != 99999 || *(v.end() - 2) != 99998)
+			std::cerr << "Error: mmap_vector: data is not kept after reopen" << std::endl;
+		v.resize(10);
+		v.push_back(42);
+	}
+	{
+		ft::mmap_vector<int> v(path);
+		if (v.size() != 11 || v[9] != 9 || v.back() != 42)
+			std::cerr << "Error: mmap_vector: size is not kept after reopen" << std::endl;
+	}
+	try
+	{
+		ft::mmap_vector<double> v(path);
+		std::cerr << "Error: mmap_vector: opened with another value type" << std::endl;
+	}
+	catch (const std::runtime_error& e)
+	{
+		// NORMAL
+	}
+	{
+		ft::mmap_vector<int> v(path);
+		if (v.size() != 11 || v[0] != 0 || v[9] != 9 || v.back() != 42)
+			std::cerr << "Error: mmap_vector: a refused open changed the file" << std::endl;
+	}
+	unlink(path);
+}
+
+void test_segmented_stack()
+{
+	ft::stack<int, ft::segmented_vector<int> > stack;
+	ft::vector<int> values;
+
+	for (int i = 0; i < 100000; ++i)
+		values.push_back(i);
+	stack.reserve(1000);
+	stack.push_range(values.begin(), values.end());
+	if (stack.size() != 100000 || stack.top() != 99999)
+		std::cerr << "Error: segmented stack: push_range" << std::endl;
+	stack.pop_n(50000);
+	if (stack.size() != 50000 || stack.top() != 49999)
+		std::cerr << "Error: segmented stack: pop_n" << std::endl;
+	for (int i = 0; i < 50000; ++i)
+		stack.push(i);
+	ft::stack<int, ft::segmented_vector<int> > copy(stack);
+	if (copy != stack || copy.top() != 49999)
+		std::cerr << "Error: segmented stack: copy" << std::endl;
+	stack.pop_n(stack.size());
+	if (!stack.empty() || !(stack < copy))
+		std::cerr << "Error: segmented stack: empty" << std::endl;
+}
+
+// multi-producer / multi-consumer: every pushed value must be popped exactly once
+#define CSTACK_THREADS 4
+#define CSTACK_PER_THREAD 50000
+
+struct ConcurrentStackTest
+{
+	ft::concurrent_stack<int>*	stack;
+	int							id;
+	int							popped_count;
+	char*						seen;
+};
+
+void* concurrent_producer(void* arg)
+{
+	ConcurrentStackTest* t = static_cast<ConcurrentStackTest*>(arg);
+	int chunk[10];
+
+	for (int i = 0; i < CSTACK_PER_THREAD; )
+	{
+		int value = t->id * CSTACK_PER_THREAD + i;
+		if (i % 100 == 0 && i + 10 <= CSTACK_PER_THREAD)
+		{
+			for (int j = 0; j < 10; ++j)
+				chunk[j] = value + j;
+			i += t->stack->push_range(chunk, chunk + 10);
+		}
+		else if (t->stack->push(value))
+			++i;
+	}
+	return (NULL);
+}
+
+void* concurrent_consumer(void* arg)
+{
+	ConcurrentStackTest* t = static_cast<ConcurrentStackTest*>(arg);
+	int value;
+
+	while (t->popped_count < CSTACK_PER_THREAD)
+		if (t->stack->pop(value))
+		{
+			if (__atomic_fetch_add(&t->seen[value], 1, __ATOMIC_RELAXED) != 0)
+				std::cerr << "Error: concurrent_stack: popped twice: " << value << std::endl;
+			++t->popped_count;
+		}
+	return (NULL);
+}
+
+void test_concurrent_stack()
+{
+	ft::concurrent_stack<int> stack(1000);	// small pool: producers often find it exhausted
+	ft::vector<char> seen(CSTACK_THREADS * CSTACK_PER_THREAD, 0);
+	ConcurrentStackTest producers[CSTACK_THREADS];
+	ConcurrentStackTest consumers[CSTACK_THREADS];
+	pthread_t threads[CSTACK_THREADS * 2];
+
+	for (int i = 0; i < CSTACK_THREADS; ++i)
+	{
+		ConcurrentStackTest t = { &stack, i, 0, seen.data() };
+		producers[i] = t;
+		consumers[i] = t;
+		pthread_create(&threads[i], NULL, concurrent_producer, &producers[i]);
+		pthread_create(&threads[CSTACK_THREADS + i], NULL, concurrent_consumer, &consumers[i]);
+	}
+	for (int i = 0; i < CSTACK_THREADS * 2; ++i)
+		pthread_join(threads[i], NULL);
+
+	int value;
+	if (!stack.empty() || stack.pop(value))
+		std::cerr << "Error: concurrent_stack: not empty at the end" << std::endl;
+	for (size_t i = 0; i < seen.size(); ++i)
+		if (seen[i] != 1)
+		{
+			std::cerr << "Error: concurrent_stack: lost value: " << i << std::endl;
+			break;
+		}
+}
+
+void test_indexed_priority_queue()
+{
+	ft::indexed_priority_queue<int, std::greater<int> > timers;
+	size_t handles[100];
+
+	for (int i = 0; i < 100; ++i)
+		handles[i] = timers.push(1000 + i);
+	timers.decrease_key(handles[50], 10);
+	timers.erase(handles[0]);
+	timers.update(handles[1], 5000);
+	if (timers.size() != 99 || timers.top() != 10 || timers.top_handle() != handles[50])
+		std::cerr << "Error: indexed_priority_queue: decrease_key" << std::endl;
+	timers.pop();
+	if (timers.top() != 1002 || timers.contains(handles[50]) || timers.contains(handles[0]))
+		std::cerr << "Error: indexed_priority_queue: pop / erase" << std::endl;
+	int last = 0;
+	while (!timers.empty())
+	{
+		last = timers.top();
+		timers.pop();
+	}
+	if (last != 5000)
+		std::cerr << "Error: indexed_priority_queue: update" << std::endl;
+}
+
+struct Session
+{
+	int id;
+	long deadline;
+	ft::rb_hook by_id;
+	ft::rb_hook by_deadline;
+};
+
+struct SessionId
+{
+	const int& operator()(const Session& s) const { return s.id; }
+};
+
+struct SessionDeadline
+{
+	const long& operator()(const Session& s) const { return s.deadline; }
+};
+
+void test_intrusive_map()
+{
+	ft::vector<Session> pool(1000);
+	ft::intrusive_map<int, Session, &Session::by_id, SessionId> by_id;
+	ft::intrusive_map<long, Session, &Session::by_deadline, SessionDeadline, std::greater<long> > by_deadline;
+	ft::map<int, Session*> reference;
+
+	for (size_t i = 0; i < pool.size(); ++i)
+	{
+		pool[i].id = rand() % 5000;
+		pool[i].deadline = static_cast<long>(i) * 7 % 1000;
+		bool inserted = by_id.insert(pool[i]).second;
+		if (inserted != reference.insert(ft::make_pair(pool[i].id, &pool[i])).second)
+			std::cerr << "Error: intrusive_map: insert of a duplicate key" << std::endl;
+		if (inserted)
+			by_deadline.insert(pool[i]);
+	}
+	for (size_t i = 0; i < pool.size(); i += 3)
+		if (pool[i].by_id.is_linked())
+		{
+			reference.erase(pool[i].id);
+			by_id.erase(pool[i]);
+			by_deadline.erase(pool[i]);
+			if (pool[i].by_id.is_linked() || pool[i].by_deadline.is_linked())
+				std::cerr << "Error: intrusive_map: hook still linked after erase" << std::endl;
+		}
+	if (by_id.size() != reference.size() || by_deadline.size() != reference.size())
+		std::cerr << "Error: intrusive_map: size" << std::endl;
+	ft::map<int, Session*>::iterator ref = reference.begin();
+	for (ft::intrusive_map<int, Session, &Session::by_id, SessionId>::iterator it = by_id.begin();
+		it != by_id.end(); ++it, ++ref)
+		if (&*it != ref->second)
+		{
+			std::cerr << "Error: intrusive_map: order" << std::endl;
+			break;
+		}
+	long previous = -1;
+	for (ft::intrusive_map<long, Session, &Session::by_deadline, SessionDeadline, std::greater<long> >::reverse_iterator
+		it = by_deadline.rbegin(); it != by_deadline.rend(); ++it)
+	{
+		if (it->deadline < previous)
+			std::cerr << "Error: intrusive_map: reverse order" << std::endl;
+		previous = it->deadline;
+	}
+	if (!reference.empty() && by_id.find(reference.begin()->first)->id != reference.begin()->first)
+		std::cerr << "Error: intrusive_map: find" << std::endl;
+	if (by_id.find(-1) != by_id.end() || by_id.count(-1))
+		std::cerr << "Error: intrusive_map: find of a missing key" << std::endl;
+	by_deadline.clear();
+	for (size_t i = 0; i < pool.size(); ++i)
+		if (pool[i].by_deadline.is_linked())
+		{
+			std::cerr << "Error: intrusive_map: hook still linked after clear" << std::endl;
+			break;
+		}
+	while (!by_id.empty())
+		by_id.erase(by_id.begin());
+}
+
+void test_radix_map()
+{
+	ft::radix_map<int, int> radix;
+	ft::map<int, int> reference;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int key = rand() % 4000 - 2000;
+		if (radix.insert(ft::make_pair(key, i)).second != reference.insert(ft::make_pair(key, i)).second)
+			std::cerr << "Error: radix_map: insert" << std::endl;
+		if (i % 3 == 0 && radix.erase(-key) != reference.erase(-key))
+			std::cerr << "Error: radix_map: erase" << std::endl;
+	}
+	for (int key = -2100; key < 2100; key += 7)
+	{
+		ft::radix_map<int, int>::iterator lower = radix.lower_bound(key), upper = radix.upper_bound(key);
+		ft::map<int, int>::iterator ref_lower = reference.lower_bound(key), ref_upper = reference.upper_bound(key);
+		if ((lower == radix.end()) != (ref_lower == reference.end()) || (upper == radix.end()) != (ref_upper == reference.end())
+			|| (lower != radix.end() && lower->first != ref_lower->first)
+			|| (upper != radix.end() && upper->first != ref_upper->first))
+			std::cerr << "Error: radix_map: lower_bound / upper_bound: " << key << std::endl;
+	}
+	if (radix.size() != reference.size() || !ft::equal(radix.begin(), radix.end(), reference.begin()))
+		std::cerr << "Error: radix_map: content" << std::endl;
+	ft::radix_map<int, int> copy(radix);
+	radix[12345] = 1;
+	if (copy == radix || copy.count(12345) || radix.at(12345) != 1)
+		std::cerr << "Error: radix_map: copy / operator[]" << std::endl;
+	radix.erase(radix.begin(), radix.end());
+	if (!radix.empty() || radix.rbegin() != radix.rend())
+		std::cerr << "Error: radix_map: clear" << std::endl;
+
+	// an allocation which fails inside insert or erase leaves the map as it was (leaks: asan build)
+	ft::radix_map<int, int, FailingAllocator<ft::pair<const int, int> > > failing;
+	reference.clear();
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int key = rand() % 1000;
+		allocations_to_fail = rand() % 4;
+		try
+		{
+			if (i % 3 == 0)
+			{
+				failing.erase(key);
+				reference.erase(key);
+			}
+			else if (failing.insert(ft::make_pair(key, i)).second)
+				reference.insert(ft::make_pair(key, i));
+		}
+		catch (const std::bad_alloc&)
+		{
+		}
+	}
+	allocations_to_fail = 0;
+	if (failing.size() != reference.size() || !ft::equal(failing.begin(), failing.end(), reference.begin()))
+		std::cerr << "Error: radix_map: content after failed allocations" << std::endl;
+	for (ft::map<int, int>::iterator it = reference.begin(); it != reference.end(); ++it)
+		if (failing.find(it->first) == failing.end() || failing.find(it->first)->second != it->second)
+		{
+			std::cerr << "Error: radix_map: lookup after failed allocations" << std::endl;
+			break ;
+		}
+	// erased down to empty, every node shrinks on the way
+	while (!reference.empty())
+	{
+		const int key = reference.begin()->first;
+		allocations_to_fail = rand() % 3;
+		try
+		{
+			failing.erase(key);
+			reference.erase(key);
+		}
+		catch (const std::bad_alloc&)
+		{
+		}
+		allocations_to_fail = 0;
+		if (failing.size() != reference.size() || failing.count(key) != reference.count(key)
+			|| (!reference.empty() && failing.begin()->first != reference.begin()->first))
+		{
+			std::cerr << "Error: radix_map: erase after failed allocations" << std::endl;
+			break ;
+		}
+	}
+}
+
+// copies (and assignments) throw while throw_on_copy is set, and the copies_to_throw-th copy (counted down,
+// 0: none) throws
+struct throwing_copy
+{
+	static bool throw_on_copy;
+	static int copies_to_throw;
+	int value;
+	throwing_copy(int v = 0) : value(v) {}
+	throwing_copy(const throwing_copy& other) : value(other.value)
+	{
+		if (throw_on_copy || (copies_to_throw > 0 && --copies_to_throw == 0))
+			throw std::runtime_error("throwing_copy");
+	}
+	throwing_copy& operator=(const throwing_copy& other)
+	{
+		if (throw_on_copy || (copies_to_throw > 0 && --copies_to_throw == 0))
+			throw std::runtime_error("throwing_copy");
+		value = other.value;
+		return (*this);
+	}
+};
+bool throwing_copy::throw_on_copy = false;
+int throwing_copy::copies_to_throw = 0;
+
+void test_treap_map()
+{
+	ft::treap_map<int, int> treap;
+	ft::map<int, int> reference;
+
+	for (int i = 0; i < 20000; ++i)
+	{
+		const int key = rand() % 3000;
+		if (treap.insert(ft::make_pair(key, i)).second != reference.insert(ft::make_pair(key, i)).second)
+			std::cerr << "Error: treap_map: insert" << std::endl;
+		if (i % 3 == 0 && treap.erase(key / 2) != reference.erase(key / 2))
+			std::cerr << "Error: treap_map: erase" << std::endl;
+		if (i % 5 == 0 && (treap.find(key / 3) == treap.end()) != (reference.find(key / 3) == reference.end()))
+			std::cerr << "Error: treap_map: find" << std::endl;
+	}
+	for (int key = -10; key < 3010; key += 7)
+	{
+		ft::treap_map<int, int>::iterator lower = treap.lower_bound(key);
+		ft::map<int, int>::iterator ref_lower = reference.lower_bound(key);
+		if ((lower == treap.end()) != (ref_lower == reference.end()) || (lower != treap.end() && lower->first != ref_lower->first))
+			std::cerr << "Error: treap_map: lower_bound: " << key << std::endl;
+	}
+	if (treap.size() != reference.size() || !ft::equal(treap.begin(), treap.end(), reference.begin()))
+		std::cerr << "Error: treap_map: content" << std::endl;
+	ft::treap_map<int, int>::reverse_iterator rit = treap.rbegin();
+	for (ft::map<int, int>::reverse_iterator ref = reference.rbegin(); ref != reference.rend(); ++ref, ++rit)
+		if (rit->first != ref->first)
+		{
+			std::cerr << "Error: treap_map: reverse iteration" << std::endl;
+			break;
+		}
+	const ft::treap_map<int, int> copy(treap);
+	if (copy != treap || copy.at(treap.begin()->first) != treap.begin()->second)
+		std::cerr << "Error: treap_map: copy" << std::endl;
+	ft::treap_map<int, int> other;
+	other[1] = 1;
+	swap(other, treap);
+	if (other.size() != copy.size() || treap.size() != 1 || treap.begin()->first != 1)
+		std::cerr << "Error: treap_map: non-member swap" << std::endl;
+
+	// a copy which throws half way frees the nodes already copied (checked by the asan build)
+	ft::treap_map<int, throwing_copy> source;
+	for (int i = 0; i < 500; ++i)
+		source.insert(ft::make_pair(i, throwing_copy(i)));
+	throwing_copy::copies_to_throw = 250;
+	try
+	{
+		ft::treap_map<int, throwing_copy> half(source);
+		std::cerr << "Error: treap_map: the copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::copies_to_throw = 0;
+}
+
+void test_vector_bool()
+{
+	ft::vector<bool> a(200), b(200);
+	for (size_t i = 0; i < a.size(); ++i)
+	{
+		a[i] = (i % 3 == 0);
+		b[i] = (i % 5 == 0);
+	}
+	if (a.count() != 67 || b.count() != 40)
+		std::cerr << "Error: vector<bool>: count" << std::endl;
+
+	size_t found = 0;
+	for (size_t i = b.find_first(); i != ft::vector<bool>::npos; i = b.find_next(i), ++found)
+		if (i % 5 != 0)
+			std::cerr << "Error: vector<bool>: find_next returned " << i << std::endl;
+	if (found != 40 || ft::vector<bool>(100).find_first() != ft::vector<bool>::npos)
+		std::cerr << "Error: vector<bool>: find_first / find_next" << std::endl;
+	if (a.find_next(198) != ft::vector<bool>::npos || a.find_next(196) != 198)
+		std::cerr << "Error: vector<bool>: find_next at the end" << std::endl;
+
+	ft::vector<bool> and_ab(a), or_ab(a), xor_ab(a);
+	and_ab &= b;
+	or_ab |= b;
+	xor_ab ^= b;
+	for (size_t i = 0; i < a.size(); ++i)
+		if (and_ab[i] != (a[i] && b[i]) || or_ab[i] != (a[i] || b[i]) || xor_ab[i] != (a[i] != b[i]))
+		{
+			std::cerr << "Error: vector<bool>: bulk operation at " << i << std::endl;
+			break;
+		}
+	if (and_ab.count() != 14 || or_ab.count() != 93 || xor_ab.count() != 79)
+		std::cerr << "Error: vector<bool>: bulk operation count" << std::endl;
+	try
+	{
+		a &= ft::vector<bool>(10);
+		std::cerr << "Error: vector<bool>: size mismatch is not reported" << std::endl;
+	}
+	catch (const std::invalid_argument&)
+	{
+	}
+
+	// bits past size() stay zero, so count() does not see them
+	a.flip();
+	a.resize(150);
+	a.resize(300, false);
+	if (a.count() != 100 || a.find_next(149) != ft::vector<bool>::npos)
+		std::cerr << "Error: vector<bool>: stale bits after shrink" << std::endl;
+
+	// proxy references through reverse_iterator
+	ft::vector<bool> r(70, false);
+	for (ft::vector<bool>::reverse_iterator it = r.rbegin(); it != r.rend(); it += 7)
+		*it = true;
+	r.rbegin()[1].flip();
+	if (r.count() != 11 || !r[69] || !r[68] || !r[62] || !r[6] || r[0])
+		std::cerr << "Error: vector<bool>: reverse_iterator write" << std::endl;
+}
+
+void test_soa_vector()
+{
+	typedef ft::soa_vector<int, double, std::string> Table;
+	Table t;
+	for (int i = 0; i < 100; ++i)
+		t.push_back(Table::value_type(i, i * 0.5, std::string(i % 7, 'x')));
+	if (t.size() != 100 || t.capacity() < 100 || t[42].get<0>() != 42 || t.back().get<2>() != "x")
+		std::cerr << "Error: soa_vector: push_back" << std::endl;
+
+	// each field is one contiguous array
+	ft::soa_span<double> prices = t.column<1>();
+	double sum = 0;
+	for (size_t i = 0; i < prices.size(); ++i)
+		sum += prices[i];
+	if (prices.size() != 100 || sum != 2475 || &prices[1] != &prices[0] + 1 || &t[3].get<1>() != prices.data() + 3)
+		std::cerr << "Error: soa_vector: column" << std::endl;
+
+	// rows through the zipped iterators
+	Table::value_type row = *(t.begin() + 13);
+	if (row.get<0>() != 13 || row.get<1>() != 6.5 || row.get<2>() != "xxxxxx")
+		std::cerr << "Error: soa_vector: row load" << std::endl;
+	t[0] = row;
+	*t.rbegin() = t[1];
+	t.begin()[2].get<2>() = "abc";
+	if (t[0].get<0>() != 13 || t[0].get<2>() != "xxxxxx" || t[99].get<0>() != 1 || t[2].get<2>() != "abc")
+		std::cerr << "Error: soa_vector: row store" << std::endl;
+	unsigned reversed = 0;
+	const Table& ct = t;
+	for (Table::const_reverse_iterator it = ct.rbegin(); it != ct.rend(); ++it)
+		reversed = reversed * 31 + (*it).get<0>();
+	unsigned forward = 0;
+	for (Table::const_iterator it = ct.end(); it != ct.begin(); )
+		forward = forward * 31 + (*--it).get<0>();
+	if (reversed != forward || ct.end() - ct.begin() != 100)
+		std::cerr << "Error: soa_vector: reverse_iterator" << std::endl;
+
+	Table copy(t);
+	copy.pop_back();
+	copy.resize(150, Table::value_type(-1, 0, "new"));
+	t.swap(copy);
+	if (t.size() != 150 || copy.size() != 100 || t[120].get<2>() != "new" || t.column<0>().size() != 150)
+		std::cerr << "Error: soa_vector: copy / resize / swap" << std::endl;
+	try
+	{
+		t.at(150);
+		std::cerr << "Error: soa_vector: at() does not throw" << std::endl;
+	}
+	catch (const std::out_of_range&)
+	{
+	}
+
+	// a field copy which throws leaves every column as it was
+	ft::soa_vector<int, throwing_copy> guarded;
+	guarded.reserve(8);
+	for (int i = 0; i < 4; ++i)
+		guarded.push_back(ft::soa_row<int, throwing_copy>(i, throwing_copy(i)));
+	const ft::soa_row<int, throwing_copy> fifth(4, throwing_copy(4));
+	throwing_copy::throw_on_copy = true;
+	try
+	{
+		guarded.push_back(fifth);
+		std::cerr << "Error: soa_vector: the field copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::throw_on_copy = false;
+	if (guarded.size() != 4 || guarded.column<0>().size() != 4 || guarded.column<1>().size() != 4
+		|| guarded.back().get<0>() != 3)
+		std::cerr << "Error: soa_vector: push_back is not strong" << std::endl;
+	// the int column has grown when the second one throws: it shrinks back
+	throwing_copy::copies_to_throw = 2;
+	try
+	{
+		guarded.resize(8, fifth);
+		std::cerr << "Error: soa_vector: the resize copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::copies_to_throw = 0;
+	if (guarded.size() != 4 || guarded.column<0>().size() != 4 || guarded.column<1>().size() != 4)
+		std::cerr << "Error: soa_vector: resize is not strong" << std::endl;
+}
+
+// a copy which throws in push, push_range or pop loses neither a node nor an element
+void test_concurrent_stack_copy_failure()
+{
+	ft::concurrent_stack<throwing_copy> stack(8);
+	throwing_copy values[8];
+	throwing_copy out;
+
+	for (int i = 0; i < 8; ++i)
+		values[i] = throwing_copy(i);
+	stack.push_range(values, values + 4);
+	throwing_copy::copies_to_throw = 3;
+	try
+	{
+		stack.push_range(values + 4, values + 8);
+		std::cerr << "Error: concurrent_stack: push_range did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::throw_on_copy = true;
+	try
+	{
+		stack.pop(out);
+		std::cerr << "Error: concurrent_stack: pop did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	try
+	{
+		stack.push(values[7]);
+		std::cerr << "Error: concurrent_stack: push did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::throw_on_copy = false;
+	if (stack.size() != 4 || !stack.pop(out) || out.value != 3)
+		std::cerr << "Error: concurrent_stack: a failed copy changed the stack" << std::endl;
+	if (stack.push_range(values + 4, values + 8) != 4 || !stack.push(values[0]) || stack.push(values[0]))
+		std::cerr << "Error: concurrent_stack: a failed copy lost pool nodes" << std::endl;
+}
+
+// a constructor which throws partway frees the elements and the buffer it built (checked by the asan build)
+void test_vector_construct_failure()
+{
+	std::istringstream	iss("1 2 3 4 5");
+	const throwing_copy	values[5];
+
+	throwing_copy::copies_to_throw = 3;
+	try
+	{
+		ft::vector<throwing_copy>	from_input((std::istream_iterator<int>(iss)), std::istream_iterator<int>());
+		std::cerr << "Error: vector: the input range copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::copies_to_throw = 3;
+	try
+	{
+		ft::vector<throwing_copy>	from_forward(values, values + 5);
+		std::cerr << "Error: vector: the forward range copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::copies_to_throw = 3;
+	try
+	{
+		ft::vector<throwing_copy>	filled(5, values[0]);
+		std::cerr << "Error: vector: the fill copy did not throw" << std::endl;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	throwing_copy::copies_to_throw = 0;
+}
+
+// a push which throws on a chunk boundary frees the chunk it allocated (checked by the asan build)
+void test_deque_push_failure()
+{
+	ft::deque<throwing_copy> deq;
+	const throwing_copy value(7);
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		throwing_copy::throw_on_copy = true;
+		try
+		{
+			if (i % 2)
+				deq.push_back(value);
+			else
+				deq.push_front(value);
+			std::cerr << "Error: deque: the element copy did not throw" << std::endl;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		throwing_copy::throw_on_copy = false;
+		if (i % 2)
+			deq.push_back(value);
+		else
+			deq.push_front(value);
+	}
+	if (deq.size() != 2000 || deq.front().value != 7 || deq.back().value != 7)
+		std::cerr << "Error: deque: a failed push changed the deque" << std::endl;
+}
+
+// a push which throws on a segment boundary leaves the back where it was
+void test_segmented_push_failure()
+{
+	ft::segmented_vector<throwing_copy> vec;
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		const throwing_copy value(i);
+
+		throwing_copy::throw_on_copy = true;
+		try
+		{
+			vec.push_back(value);
+			std::cerr << "Error: segmented_vector: the element copy did not throw" << std::endl;
+		}
+		catch (const std::runtime_error&)
+		{
+		}
+		throwing_copy::throw_on_copy = false;
+		if (vec.size() != static_cast<size_t>(i) || (i != 0 && vec.back().value != i - 1))
+		{
+			std::cerr << "Error: segmented_vector: a failed push moved the back" << std::endl;
+			return ;
+		}
+		vec.push_back(value);
+	}
+	while (vec.size() > 1 && vec.back().value == static_cast<int>(vec.size()) - 1)
+		vec.pop_back();
+	if (vec.size() != 1 || vec.front().value != 0)
+		std::cerr << "Error: segmented_vector: pop_back after a failed push" << std::endl;
+}
+
+// the byte compare of contiguous integral ranges must agree with the element loop (predicate overloads)
+template<typename T>
+void test_bytewise_compare_one(const char* name)
+{
+	for (size_t n = 0; n < 100; n += 7)
+		for (size_t diff = 0; diff <= n; diff += 3)
+		{
+			ft::vector<T> a, b;
+			for (size_t i = 0; i < n; ++i)
+				a.push_back(T(i * 37 - 100));
+			b = a;
+			if (diff < n)
+				b[diff] = T(-b[diff] - 1);
+			if (ft::vector<T>(b.begin(), b.begin() + diff) != ft::vector<T>(a.begin(), a.begin() + diff)
+				|| (a == b) != ft::equal(a.begin(), a.end(), b.begin(), std::equal_to<T>())
+				|| (a < b) != ft::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), std::less<T>())
+				|| (b < a) != ft::lexicographical_compare(b.begin(), b.end(), a.begin(), a.end(), std::less<T>())
+				|| (n && !ft::lexicographical_compare(a.data(), a.data() + n - 1, a.data(), a.data() + n)))
+			{
+				std::cerr << "Error: bytewise compare of " << name << " at n " << n << ", diff " << diff << std::endl;
+				return ;
+			}
+		}
+}
+
+void test_bytewise_compare()
+{
+	test_bytewise_compare_one<char>("char");
+	test_bytewise_compare_one<unsigned char>("unsigned char");
+	test_bytewise_compare_one<short>("short");
+	test_bytewise_compare_one<int>("int");
+	test_bytewise_compare_one<unsigned>("unsigned");
+	test_bytewise_compare_one<long>("long");
+}
+
+struct counted
+{
+	static int	alive;
+	int			value;
+
+	counted(int v = 0) : value(v) { ++alive; }
+	counted(const counted& other) : value(other.value) { ++alive; }
+	~counted() { --alive; }
+	bool operator==(const counted& other) const { return (value == other.value); }
+};
+
+int counted::alive = 0;
+
+// the memmove / memset paths (int) and the element paths (counted, non std::allocator)
+// must leave the vector as std::vector would
+template<typename Vec>
+bool test_bulk_copy_fill_one(Vec& v, std::vector<int>& ref, int step)
+{
+	const size_t	pos = ref.empty() ? 0 : static_cast<size_t>(rand()) % ref.size();
+	const size_t	n = static_cast<size_t>(rand()) % 20;
+	int				src[20];
+
+	for (size_t i = 0; i < n; ++i)
+		src[i] = step * 100 + static_cast<int>(i);
+	switch (step % 6)
+	{
+		case 0:
+			if (ref.empty())
+				v.push_back(step), ref.push_back(step);
+			v.insert(v.begin() + pos, n, v[0]);	// the value lives in the vector
+			ref.insert(ref.begin() + pos, n, ref[0]);
+			break;
+		case 1:
+			v.insert(v.begin() + pos, src, src + n);
+			ref.insert(ref.begin() + pos, src, src + n);
+			break;
+		case 2:
+			v.erase(v.begin() + pos, v.begin() + std::min(pos + n, ref.size()));
+			ref.erase(ref.begin() + pos, ref.begin() + std::min(pos + n, ref.size()));
+			break;
+		case 3:
+			v.assign(src, src + n);
+			ref.assign(src, src + n);
+			break;
+		case 4:
+			v.resize(pos + n, step);
+			ref.resize(pos + n, step);
+			break;
+		case 5:
+			v.assign(pos + n, step);
+			ref.assign(pos + n, step);
+			break;
+	}
+	if (v.size() != ref.size())
+		return (false);
+	for (size_t i = 0; i < ref.size(); ++i)
+		if (!(v[i] == ref[i]))
+			return (false);
+	return (true);
+}
+
+void test_bulk_copy_fill()
+{
+	ft::vector<int>										ints;
+	ft::vector<counted, PatternAllocator<counted> >		objs;
+	std::vector<int>									ref_ints, ref_objs;
+
+	for (int step = 1; step < 2000; ++step)
+		if (!test_bulk_copy_fill_one(ints, ref_ints, step) || !test_bulk_copy_fill_one(objs, ref_objs, step))
+		{
+			std::cerr << "Error: bulk copy / fill: vector differs from std::vector at step " << step << std::endl;
+			break;
+		}
+	objs.resize(3);
+	if (counted::alive != 3)
+		std::cerr << "Error: bulk copy / fill: resize leaves " << counted::alive << " elements alive" << std::endl;
+
+	int		a[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+	int		b[8];
+
+	ft::copy(ft::reverse_iterator<int*>(a + 8), ft::reverse_iterator<int*>(a), b);
+	ft::copy_backward(a, a + 6, a + 8);
+	if (b[0] != 7 || b[7] != 0 || a[2] != 0 || a[7] != 5)
+		std::cerr << "Error: bulk copy / fill: copy through reverse iterators" << std::endl;
+	if (ft::fill_n(b, 8, 0) != b + 8 || b[7] != 0 || *ft::fill_n(b, 0, 1) != 0)
+		std::cerr << "Error: bulk copy / fill: fill_n" << std::endl;
+
+	std::string		strs[2] = { "abc", "de" };
+	std::string*	raw = std::allocator<std::string>().allocate(2);
+
+	if (ft::uninitialized_copy(strs, strs + 2, raw) != raw + 2 || raw[1] != "de")
+		std::cerr << "Error: bulk copy / fill: uninitialized_copy" << std::endl;
+	raw[0].~basic_string();
+	raw[1].~basic_string();
+	std::allocator<std::string>().deallocate(raw, 2);
+}
+
+struct key_less
+{
+	bool operator()(const ft::pair<const int, int>& lhs, int rhs) const { return (lhs.first < rhs); }
+	bool operator()(int lhs, const ft::pair<const int, int>& rhs) const { return (lhs < rhs.first); }
+};
+
+// the branchless searches must agree with the std ones, on every position of ranges with duplicates
+void test_binary_search()
+{
+	for (int n = 0; n < 300; n += 1 + n / 16)
+	{
+		ft::vector<int>		v;
+		std::vector<int>	ref;
+		ft::vector<int>		keys;
+		ft::vector<ft::vector<int>::iterator>	many;
+
+		for (int i = 0; i < n; ++i)
+			v.push_back(i / 3 * 2);
+		ref.assign(v.data(), v.data() + n);
+		for (int key = -2; key <= n; ++key)
+			keys.push_back(key);
+		ft::lower_bound_many(v.begin(), v.end(), keys.begin(), keys.end(), std::back_inserter(many));
+		for (int key = -2; key <= n; ++key)
+		{
+			const size_t	lb = std::lower_bound(ref.begin(), ref.end(), key) - ref.begin();
+			const size_t	ub = std::upper_bound(ref.begin(), ref.end(), key) - ref.begin();
+			ft::pair<ft::vector<int>::iterator, ft::vector<int>::iterator>	range = ft::equal_range(v.begin(), v.end(), key);
+
+			if (size_t(ft::lower_bound(v.begin(), v.end(), key) - v.begin()) != lb
+				|| size_t(ft::upper_bound(v.begin(), v.end(), key) - v.begin()) != ub
+				|| size_t(range.first - v.begin()) != lb || size_t(range.second - v.begin()) != ub
+				|| ft::binary_search(v.begin(), v.end(), key) != (lb != ub)
+				|| size_t(many[key + 2] - v.begin()) != lb
+				|| size_t(ft::lower_bound(v.rbegin(), v.rend(), key, std::greater<int>()).base() - v.begin()) != ub)
+			{
+				std::cerr << "Error: binary search: n " << n << ", key " << key << std::endl;
+				return ;
+			}
+		}
+	}
+
+	ft::map<int, int>	m;
+	for (int i = 0; i < 100; i += 2)
+		m[i] = i;
+	if (ft::lower_bound(m.begin(), m.end(), 31, key_less())->first != 32
+		|| ft::upper_bound(m.begin(), m.end(), 32, key_less())->first != 34
+		|| ft::binary_search(m.begin(), m.end(), 99, key_less())
+		|| ft::equal_range(m.begin(), m.end(), 40, key_less()).first->first != 40)
+		std::cerr << "Error: binary search: map iterators" << std::endl;
+}
+
+bool below_half(double x) { return (x < 0.5); }
+
+// selection must agree with a full sort, on samples with many duplicates
+void test_selection()
+{
+	for (int n = 1; n < 3000; n += 1 + n / 4)
+	{
+		ft::vector<double>	v;
+		std::vector<double>	sorted;
+		const double		qs[4] = { 0.0, 0.5, 0.99, 1.0 };
+		double				found[4];
+
+		for (int i = 0; i < n; ++i)
+			v.push_back((rand() % 64) / 64.0);
+		sorted.assign(v.data(), v.data() + n);
+		std::sort(sorted.begin(), sorted.end());
+
+		ft::quantiles(v.begin(), v.end(), qs, qs + 4, found);
+		for (int i = 0; i < 4; ++i)
+			if (found[i] != sorted[size_t(qs[i] * (n - 1))])
+				std::cerr << "Error: quantiles: n " << n << ", q " << qs[i] << std::endl;
+
+		const int	k = rand() % n;
+		ft::nth_element(v.begin(), v.begin() + k, v.end());
+		if (v[k] != sorted[k] || *std::max_element(v.data(), v.data() + k + 1) != v[k]
+			|| *std::min_element(v.data() + k, v.data() + n) != v[k])
+			std::cerr << "Error: nth_element: n " << n << ", k " << k << std::endl;
+
+		ft::partial_sort(v.begin(), v.begin() + k, v.end());
+		if (!std::equal(v.data(), v.data() + k, sorted.begin()))
+			std::cerr << "Error: partial_sort: n " << n << ", k " << k << std::endl;
+
+		ft::vector<double>::iterator	middle = ft::partition(v.begin(), v.end(), below_half);
+		if (middle - v.begin() != std::lower_bound(sorted.begin(), sorted.end(), 0.5) - sorted.begin()
+			|| ft::partition_point(v.begin(), v.end(), below_half) != middle
+			|| std::find_if(v.data(), middle.base(), std::not1(std::ptr_fun(below_half))) != middle.base())
+			std::cerr << "Error: partition: n " << n << std::endl;
+	}
+}
+
+// the galloping / SSE2 paths must give the std results, duplicates included
+void test_set_operations()
+{
+	for (int round = 0; round < 200; ++round)
+	{
+		const int			n1 = rand() % 500;
+		const int			n2 = round % 2 ? rand() % 500 : rand() % 10;
+		const int			range = round % 3 ? 50 : 5000;
+		ft::vector<int>		a, b;
+		std::vector<int>	expected, got;
+
+		for (int i = 0; i < n1; ++i)
+			a.push_back(rand() % range);
+		for (int i = 0; i < n2; ++i)
+			b.push_back(rand() % range);
+		ft::sort(a.begin(), a.end());
+		ft::sort(b.begin(), b.end());
+		if (round % 4 == 0)
+			a.swap(b);
+
+		std::set_intersection(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), std::back_inserter(expected));
+		ft::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(got));
+		if (got != expected)
+			std::cerr << "Error: set_intersection: round " << round << std::endl;
+		expected.clear();
+		got.clear();
+		std::set_union(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), std::back_inserter(expected));
+		ft::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(got));
+		if (got != expected)
+			std::cerr << "Error: set_union: round " << round << std::endl;
+		expected.clear();
+		got.clear();
+		std::set_difference(a.data(), a.data() + a.size(), b.data(), b.data() + b.size(), std::back_inserter(expected));
+		ft::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(got));
+		if (got != expected)
+			std::cerr << "Error: set_difference: round " << round << std::endl;
+	}
+
+	ft::map<int, int>	multiples_of_2, multiples_of_3;
+	ft::vector<int>		multiples_of_6;
+
+	for (int i = 0; i < 300; ++i)
+	{
+		multiples_of_2[i * 2] = i;
+		multiples_of_3[i * 3] = i;
+	}
+	ft::set_intersection(ft::make_key_iterator(multiples_of_2.begin()), ft::make_key_iterator(multiples_of_2.end()),
+							ft::make_key_iterator(multiples_of_3.begin()), ft::make_key_iterator(multiples_of_3.end()),
+							std::back_inserter(multiples_of_6));
+	if (multiples_of_6.size() != 100 || multiples_of_6[1] != 6 || multiples_of_6.back() != 594)
+		std::cerr << "Error: set_intersection: map keys" << std::endl;
+}
+
+// the vector kernels must give the results of the plain loops (exactly, but for the rounding of
+// float sums), on every size around the vector widths
+template< class T >
+void test_simd_kernels( const char* type, int range )
+{
+	for (int round = 0; round < 300; ++round)
+	{
+		const int		n = round < 100 ? round : rand() % 5000;
+		ft::vector<T>	v;
+		double			magnitude = 0;
+
+		for (int i = 0; i < n; ++i)
+		{
+			v.push_back(static_cast<T>(rand() % range - range / 2));
+			magnitude += v[i] < 0 ? -static_cast<double>(v[i]) : static_cast<double>(v[i]);
+		}
+		const std::list<T>	scalar(v.data(), v.data() + n);	// not contiguous: the plain loops
+		const double		error = static_cast<double>(ft::sum(v.begin(), v.end()))
+									- static_cast<double>(ft::sum(scalar.begin(), scalar.end()));
+
+		if (error > magnitude * 1e-6 || -error > magnitude * 1e-6)
+			std::cerr << "Error: sum<" << type << ">: size " << n << std::endl;
+		if (n != 0)
+		{
+			ft::pair<T, T>	range_of_v = ft::minmax(v.begin(), v.end());
+
+			if (range_of_v != ft::minmax(scalar.begin(), scalar.end()))
+				std::cerr << "Error: minmax<" << type << ">: size " << n << std::endl;
+		}
+		const T			key = static_cast<T>(rand() % range - range / 2);
+
+		if (ft::count(v.begin(), v.end(), key) != ft::count(scalar.begin(), scalar.end(), key))
+			std::cerr << "Error: count<" << type << ">: size " << n << std::endl;
+		if (ft::find(v.begin(), v.end(), key) - v.begin() != std::find(v.data(), v.data() + n, key) - v.data())
+			std::cerr << "Error: find<" << type << ">: size " << n << std::endl;
+	}
+}
+
+void test_simd_kernels()
+{
+	test_simd_kernels<int>("int", 100);
+	test_simd_kernels<int>("int", INT_MAX);
+	test_simd_kernels<long>("long", 100);
+	test_simd_kernels<long>("long", INT_MAX);
+	test_simd_kernels<float>("float", 100);
+	test_simd_kernels<double>("double", 100);
+
+	ft::vector<int>		ints(50, 7);
+	ft::vector<double>	doubles(50, 0.0);
+
+	ints[45] = INT_MAX;
+	if (ft::sum(ints.begin(), ints.end() - 4) != static_cast<int>(45u * 7u + static_cast<unsigned>(INT_MAX)))
+		std::cerr << "Error: sum: wrap around" << std::endl;
+	if (ft::count(ints.begin(), ints.end(), 7u) != 49 || ft::count(ints.begin(), ints.end(), 7.0) != 49
+		|| ft::find(ints.begin(), ints.end(), 7.5) != ints.end())
+		std::cerr << "Error: count / find: value of another type" << std::endl;
+#if LONG_MAX > INT_MAX
+	if (ft::count(ints.begin(), ints.end(), static_cast<long>(UINT_MAX) + 8) != 0
+		|| ft::find(ints.begin(), ints.end(), static_cast<long>(UINT_MAX) + 8) != ints.end())
+		std::cerr << "Error: count / find: value out of the element range" << std::endl;
+#endif
+	if (ft::count(doubles.begin(), doubles.end(), -0.0) != 50)
+		std::cerr << "Error: count: signed zeros" << std::endl;
+	doubles[20] = std::numeric_limits<double>::quiet_NaN();
+	if (ft::count(doubles.begin(), doubles.end(), doubles[20]) != 0 || ft::find(doubles.begin(), doubles.end(), doubles[20]) != doubles.end())
+		std::cerr << "Error: count / find: NaN" << std::endl;
+}
+
+struct parallel_square
+{
+	long operator()(int x) const { return (static_cast<long>(x) * x); }
+};
+
+struct parallel_negate
+{
+	void operator()(int& x) const { x = -x; }
+};
+
+// the in-order links must follow the tree through inserts, erases, copies and swaps
+void test_threaded_map()
+{
+	typedef ft::map<int, int, std::less<int>, std::allocator<ft::pair<const int, int> >, true> ThreadedMap;
+	ThreadedMap m, empty;
+	ft::map<int, int> plain;
+
+	for (int i = 0; i < 1000; ++i)
+	{
+		int key = (i * 7919) % 1009;
+		m[key] = i;
+		plain[key] = i;
+		if (i % 3 == 0)
+		{
+			m.erase((key * 31) % 1009);
+			plain.erase((key * 31) % 1009);
+		}
+	}
+	ThreadedMap copy(m);
+	m.swap(empty);
+	empty.swap(m);
+	m.insert(ft::make_pair(-1, 0));
+	plain.insert(ft::make_pair(-1, 0));
+
+	ft::map<int, int>::iterator expected = plain.begin();
+	ThreadedMap::iterator it = m.begin();
+	for (; expected != plain.end() && it != m.end(); ++expected, ++it)
+		if (it->first != expected->first || it->second != expected->second)
+			break ;
+	if (expected != plain.end() || it != m.end() || m.size() != plain.size())
+		std::cerr << "Error: threaded map: forward scan" << std::endl;
+	ft::map<int, int>::reverse_iterator rexpected = plain.rbegin();
+	ThreadedMap::const_reverse_iterator rit = m.rbegin();
+	for (; rexpected != plain.rend() && rit != m.rend(); ++rexpected, ++rit)
+		if (rit->first != rexpected->first)
+			break ;
+	if (rexpected != plain.rend() || rit != m.rend())
+		std::cerr << "Error: threaded map: reverse scan" << std::endl;
+	if (copy.size() + 1 != m.size() || (--copy.end())->first != (--m.end())->first || !empty.empty()
+		|| empty.begin() != empty.end())
+		std::cerr << "Error: threaded map: copy / swap" << std::endl;
+}
+
+// the parallel overloads must give the sequential results, on pools of 0 (caller only) to 3 workers
+void test_parallel_algorithms()
+{
+	for (size_t workers = 0; workers < 4; ++workers)
+	{
+		ft::thread_pool pool(workers);
+		ft::execution::parallel_policy par = ft::execution::par.on(pool);
+		const size_t sizes[] = { 0, 1, 4095, 100000 };
+
+		for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+		{
+			const size_t n = sizes[s];
+			ft::vector<int> v(n), sorted;
+			ft::vector<long> squares(n);
+			for (size_t i = 0; i < n; ++i)
+				v[i] = static_cast<int>((i * 2654435761u) % 100003) - 50000;
+
+			ft::transform(par, v.begin(), v.end(), squares.begin(), parallel_square());
+			if (ft::reduce(par, squares.begin(), squares.end()) != ft::reduce(squares.begin(), squares.end())
+				|| ft::reduce(par, v.begin(), v.end(), 0L) != ft::reduce(ft::execution::seq, v.begin(), v.end(), 0L))
+				std::cerr << "Error: parallel transform / reduce, " << workers << " workers, n " << n << std::endl;
+
+			// bool partials are one per chunk, not bits of shared words: no chunk's false may be lost
+			ft::vector<int> flags(n, 1);
+			for (size_t zero = 0; zero < n; zero += n / 8 + 1)
+			{
+				flags[zero] = 0;
+				if (ft::reduce(par, flags.begin(), flags.end(), true, std::logical_and<bool>())
+					|| ft::reduce(par, flags.begin(), flags.end(), false, std::logical_or<bool>()) != (n > 1))
+					std::cerr << "Error: parallel reduce of bools, " << workers << " workers, n " << n << std::endl;
+				flags[zero] = 1;
+			}
+
+			sorted = v;
+			ft::sort(sorted.begin(), sorted.end());
+			ft::sort(par, v.begin(), v.end());
+			if (!ft::equal(par, v.begin(), v.end(), sorted.begin()) || v != sorted)
+				std::cerr << "Error: parallel sort, " << workers << " workers, n " << n << std::endl;
+			ft::sort(par, v.begin(), v.end(), std::greater<int>());
+			ft::sort(sorted.begin(), sorted.end(), std::greater<int>());
+			if (v != sorted)
+				std::cerr << "Error: parallel sort with comparator, " << workers << " workers, n " << n << std::endl;
+
+			ft::for_each(par, v.begin(), v.end(), parallel_negate());
+			if (n > 1 && (v.front() != -sorted.front() || v.back() != -sorted.back()
+				|| ft::equal(par, v.begin(), v.end(), sorted.begin())))
+				std::cerr << "Error: parallel for_each / equal, " << workers << " workers, n " << n << std::endl;
+		}
+	}
+}
+
+struct parallel_mapped
+{
+	long operator()(const ft::pair<const int, int>& value) const { return (value.second); }
+};
+
+struct parallel_plus
+{
+	long operator()(long lhs, long rhs) const { return (lhs + rhs); }
+};
+
+// keeps the leftmost key: associative, not commutative, so the chunks must be combined in key order
+struct parallel_first_key
+{
+	int operator()(const ft::pair<const int, int>& value) const { return (value.first); }
+	int operator()(int lhs, int rhs) const { return (lhs == INT_MIN ? rhs : lhs); }
+};
+
+struct parallel_value_is_not
+{
+	int value;
+	bool operator()(const ft::pair<const int, int>& element) const { return (element.second != value); }
+};
+
+struct parallel_mark
+{
+	int* marks;
+	void operator()(const ft::pair<const int, int>& value) const { __atomic_fetch_add(&marks[value.second], 1, __ATOMIC_RELAXED); }
+};
+
+// whole subtrees of the map go to the threads: every element must be seen once, whatever the pool
+void test_parallel_map()
+{
+	ft::multimap<int, int> m;
+	for (int i = 0; i < 20000; ++i)
+		m.insert(ft::make_pair((i * 7919) % 5003, i));
+
+	for (size_t workers = 0; workers < 4; ++workers)
+	{
+		ft::thread_pool pool(workers);
+		ft::execution::parallel_policy par = ft::execution::par.on(pool);
+		// a range which starts and ends inside runs of equal keys
+		ft::multimap<int, int>::const_iterator first = m.lower_bound(1000);
+		ft::multimap<int, int>::const_iterator last = m.lower_bound(4000);
+		++first;
+		++last;
+
+		long expected = 0;
+		for (ft::multimap<int, int>::const_iterator it = first; it != last; ++it)
+			expected += it->second;
+		if (ft::parallel_reduce(par, first, last, 0L, parallel_plus(), parallel_mapped()) != expected
+			|| ft::parallel_reduce(par, m.begin(), m.end(), INT_MIN, parallel_first_key(), parallel_first_key())
+				!= m.begin()->first
+			|| ft::parallel_reduce(par, first, first, 42L, parallel_plus(), parallel_mapped()) != 42)
+			std::cerr << "Error: parallel_reduce over a multimap, " << workers << " workers" << std::endl;
+		// bool partials: the one chunk which sees the value must not have its false lost
+		for (int value = 0; value < 20000; value += 2503)
+		{
+			parallel_value_is_not is_not = { value };
+			if (ft::parallel_reduce(par, m.begin(), m.end(), true, std::logical_and<bool>(), is_not))
+				std::cerr << "Error: parallel_reduce of bools over a multimap, " << workers << " workers" << std::endl;
+		}
+		parallel_value_is_not absent = { -1 };
+		if (!ft::parallel_reduce(par, m.begin(), m.end(), true, std::logical_and<bool>(), absent))
+			std::cerr << "Error: parallel_reduce of bools over a multimap, " << workers << " workers" << std::endl;
+
+		ft::vector<int> marks(20000, 0);
+		parallel_mark mark = { marks.data() };
+		ft::parallel_for_each(par, m.begin(), m.end(), mark);
+		size_t once = 0;
+		for (size_t i = 0; i < marks.size(); ++i)
+			once += (marks[i] == 1);
+		if (once != marks.size())
+			std::cerr << "Error: parallel_for_each over a multimap, " << workers << " workers" << std::endl;
+	}
+}
+
+// layout: no vptr, and the empty std::allocator / std::less take no space
+typedef char vector_layout_check[sizeof(ft::vector<int>) == 3 * sizeof(void*) ? 1 : -1];
+typedef char stack_layout_check[sizeof(ft::stack<int>) == 3 * sizeof(void*) ? 1 : -1];
+typedef char map_layout_check[sizeof(ft::map<int, int>) == 3 * sizeof(void*) ? 1 : -1];
+typedef char vector_bool_layout_check[sizeof(ft::vector<bool>) == 3 * sizeof(void*) ? 1 : -1];
+typedef char set_layout_check[sizeof(ft::set<int>) == 3 * sizeof(void*) ? 1 : -1];
+typedef char radix_map_layout_check[sizeof(ft::radix_map<int, int>) == 5 * sizeof(void*) ? 1 : -1];
+#endif
+
 int main(int argc, char** argv) {
 	if (argc != 2)
 	{
@@ -63,7 +1409,7 @@ int main(int argc, char** argv) {
 	ft::vector<int> vector_int;
 	ft::stack<int> stack_int;
 	ft::vector<Buffer> vector_buffer;
-	ft::stack<Buffer, std::deque<Buffer> > stack_deq_buffer;
+	ft::stack<Buffer, ft::deque<Buffer> > stack_deq_buffer;
 	ft::map<int, int> map_int;
 
 	for (int i = 0; i < COUNT; i++)
@@ -141,6 +1487,173 @@ int main(int argc, char** argv) {
 		++it;
 	}
 
+	{	// range operations with input / bidirectional / random access iterators
+		std::istringstream	iss("1 2 3 4 5");
+		ft::vector<int>		from_input((std::istream_iterator<int>(iss)), std::istream_iterator<int>());
+		std::list<int>		lst(from_input.begin(), from_input.end());
+		ft::vector<int>		ranged(lst.begin(), lst.end());
+
+		std::istringstream	iss2("7 8 9");
+		ranged.insert(ranged.begin() + 1, std::istream_iterator<int>(iss2), std::istream_iterator<int>());
+		ranged.insert(ranged.end() - 2, lst.begin(), lst.end());
+		ranged.insert(ranged.begin(), from_input.rbegin(), from_input.rend());
+		for (ft::vector<int>::iterator it = ranged.begin(); it != ranged.end(); ++it)
+			std::cout << *it << " ";
+		std::cout << std::endl;
+		std::istringstream	iss3("6 5");
+		ranged.assign(std::istream_iterator<int>(iss3), std::istream_iterator<int>());
+		std::cout << "size: " << ranged.size() << ", back: " << ranged.back() << std::endl;
+	}
+
+	{	// deque
+		ft::deque<int>	deq;
+		for (int i = 0; i < 1000; ++i)
+		{
+			deq.push_back(i);
+			deq.push_front(-i);
+		}
+		for (int i = 0; i < 300; ++i)
+			deq.pop_front();
+		deq.insert(deq.begin() + 10, 5, 42);
+		ft::vector<int>	to_insert(20, 7);
+		deq.insert(deq.end() - 10, to_insert.begin(), to_insert.end());
+		deq.erase(deq.begin() + 100, deq.begin() + 200);
+		deq.erase(deq.end() - 300, deq.end() - 250);
+		std::cout << "deque size: " << deq.size() << ", front: " << deq.front() << ", back: " << deq.back() << std::endl;
+		long long_sum = 0;
+		for (ft::deque<int>::const_reverse_iterator it = deq.rbegin(); it != deq.rend(); ++it)
+			long_sum += *it;
+		std::cout << "deque sum: " << long_sum << ", [123]: " << deq[123] << ", at(456): " << deq.at(456) << std::endl;
+
+		for (int i = 0; i < 100; ++i)
+			stack_deq_buffer.push(Buffer());
+		while (stack_deq_buffer.size() > 10)
+			stack_deq_buffer.pop();
+		std::cout << "stack on deque size: " << stack_deq_buffer.size() << std::endl;
+	}
+
+	{	// priority_queue
+		ft::vector<int>	values;
+		for (int i = 0; i < 1000; ++i)
+			values.push_back(rand() % 10000);
+		ft::priority_queue<int>	max_queue(values.begin(), values.end());
+		ft::priority_queue<int, ft::vector<int>, std::greater<int> >	min_queue;
+		for (int i = 0; i < 1000; ++i)
+			min_queue.push(values[i]);
+		for (int i = 0; i < 10; ++i)
+		{
+			std::cout << max_queue.top() << "/" << min_queue.top() << " ";
+			max_queue.pop();
+			min_queue.pop();
+		}
+		std::cout << "size: " << max_queue.size() << std::endl;
+	}
+
+	{	// set / multiset / multimap
+		ft::set<int>			uniq;
+		ft::multiset<int>		dups;
+		ft::multimap<int, int>	multi;
+		for (int i = 0; i < 2000; ++i)
+		{
+			const int	key = rand() % 300;
+			uniq.insert(key);
+			dups.insert(key);
+			multi.insert(ft::make_pair(key, i));
+		}
+		std::cout << "set size: " << uniq.size() << ", multiset size: " << dups.size()
+			<< ", multimap size: " << multi.size() << std::endl;
+		std::cout << "count(42): " << uniq.count(42) << "/" << dups.count(42) << "/" << multi.count(42) << std::endl;
+		std::cout << "erase(7): " << uniq.erase(7) << "/" << dups.erase(7) << "/" << multi.erase(7) << std::endl;
+		dups.erase(dups.find(42));
+		multi.erase(multi.lower_bound(100), multi.upper_bound(150));
+		ft::pair<ft::multimap<int, int>::iterator, ft::multimap<int, int>::iterator>	range = multi.equal_range(42);
+		for (; range.first != range.second; ++range.first)
+			std::cout << range.first->second << " ";
+		std::cout << std::endl;
+		long	long_sum = 0;
+		for (ft::multiset<int>::reverse_iterator it = dups.rbegin(); it != dups.rend(); ++it)
+			long_sum += *it;
+		for (ft::multimap<int, int>::const_iterator it = multi.begin(); it != multi.end(); ++it)
+			long_sum += it->first * 3 + it->second;
+		std::cout << "sum: " << long_sum << ", sizes: " << dups.size() << "/" << multi.size() << std::endl;
+		ft::set<int>		uniq_copy(dups.begin(), dups.end());
+		ft::multiset<int>	dups_copy(dups);
+		std::cout << (uniq_copy == uniq) << (dups_copy == dups) << (uniq_copy < uniq) << (dups_copy != dups) << std::endl;
+	}
+
+	{	// vector<bool>
+		ft::vector<bool>	bits;
+		for (int i = 0; i < 1000; ++i)
+			bits.push_back(rand() % 3 == 0);
+		bits.insert(bits.begin() + 70, 130, true);
+		ft::vector<bool>	head(bits.begin(), bits.begin() + 90);
+		bits.insert(bits.begin() + 3, head.rbegin(), head.rend());
+		bits.erase(bits.begin() + 10, bits.begin() + 75);
+		bits.erase(bits.end() - 1);
+		bits[5] = !bits[6];
+		bits.flip();
+		bits.resize(1100, true);
+		ft::vector<bool>::swap(bits[0], bits[1]);
+		long	ones = 0;
+		for (ft::vector<bool>::const_reverse_iterator it = bits.rbegin(); it != bits.rend(); ++it)
+			ones = ones * 3 % 1000003 + *it;
+		std::cout << "vector<bool> size: " << bits.size() << ", hash: " << ones
+			<< ", front/back: " << bits.front() << bits.back() << ", at(500): " << bits.at(500) << std::endl;
+		ft::vector<bool>	copy(bits.begin(), bits.end());
+		std::cout << (copy == bits) << (copy < bits);
+		copy.pop_back();
+		std::cout << (copy == bits) << (copy < bits) << std::endl;
+	}
+
+	{	// sort / stable_sort
+		ft::vector<int>		ints;
+		ft::deque<int>		deq;
+		ft::vector<ft::pair<int, int> >	pairs;
+		for (int i = 0; i < 5000; ++i)
+		{
+			ints.push_back(rand() - RAND_MAX / 2);
+			deq.push_back(rand() % 1000);
+			pairs.push_back(ft::make_pair(rand() % 100, i));
+		}
+		ft::vector<int>		sorted(ints);
+		ft::sort(sorted.begin(), sorted.end());
+		ft::stable_sort(ints.begin(), ints.end(), std::greater<int>());
+		ft::sort(deq.begin(), deq.end());
+		ft::stable_sort(pairs.begin(), pairs.end(), by_first);
+		long	long_sum = 0;
+		for (size_t i = 0; i < sorted.size(); ++i)
+			long_sum = (long_sum * 31 + sorted[i] + ints[ints.size() - 1 - i] + deq[i] + pairs[i].second) % 1000000007;
+		std::cout << "sorted: " << sorted.front() << " " << sorted.back() << " " << deq[2500]
+			<< " " << pairs[0].second << ", hash: " << long_sum << std::endl;
+	}
+
+	#if FT
+		test_resize_default_init();
+		test_erase_unordered_and_erase_if();
+		test_mmap_vector();
+		test_segmented_stack();
+		test_concurrent_stack();
+		test_indexed_priority_queue();
+		test_intrusive_map();
+		test_radix_map();
+		test_treap_map();
+		test_vector_bool();
+		test_soa_vector();
+		test_concurrent_stack_copy_failure();
+		test_vector_construct_failure();
+		test_deque_push_failure();
+		test_segmented_push_failure();
+		test_bytewise_compare();
+		test_bulk_copy_fill();
+		test_binary_search();
+		test_selection();
+		test_set_operations();
+		test_simd_kernels();
+		test_parallel_algorithms();
+		test_threaded_map();
+		test_parallel_map();
+	#endif
+
 	#ifdef ERR
 		ft::vector<const int>	tmp;
 		tmp.push_back(24);
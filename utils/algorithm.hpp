@@ -13,16 +13,188 @@
 // Algorithms library:	https://en.cppreference.com/w/cpp/algorithm
 // // equal:						https://en.cppreference.com/w/cpp/algorithm/equal
 // // lexicographical_compare:		https://en.cppreference.com/w/cpp/algorithm/lexicographical_compare
+// // copy:							https://en.cppreference.com/w/cpp/algorithm/copy
+// // copy_backward:				https://en.cppreference.com/w/cpp/algorithm/copy_backward
+// // fill:							https://en.cppreference.com/w/cpp/algorithm/fill
+// // fill_n:						https://en.cppreference.com/w/cpp/algorithm/fill_n
+// // uninitialized_copy:			https://en.cppreference.com/w/cpp/memory/uninitialized_copy
+// // uninitialized_fill_n:			https://en.cppreference.com/w/cpp/memory/uninitialized_fill_n
+// // for_each:						https://en.cppreference.com/w/cpp/algorithm/for_each
+// // transform:					https://en.cppreference.com/w/cpp/algorithm/transform
+// // reduce:						https://en.cppreference.com/w/cpp/algorithm/reduce
+// // sort:							https://en.cppreference.com/w/cpp/algorithm/sort
+// // stable_sort:					https://en.cppreference.com/w/cpp/algorithm/stable_sort
+// // lower_bound:					https://en.cppreference.com/w/cpp/algorithm/lower_bound
+// // upper_bound:					https://en.cppreference.com/w/cpp/algorithm/upper_bound
+// // binary_search:				https://en.cppreference.com/w/cpp/algorithm/binary_search
+// // equal_range:					https://en.cppreference.com/w/cpp/algorithm/equal_range
+// // nth_element:					https://en.cppreference.com/w/cpp/algorithm/nth_element
+// // partial_sort:					https://en.cppreference.com/w/cpp/algorithm/partial_sort
+// // partition:					https://en.cppreference.com/w/cpp/algorithm/partition
+// // partition_point:				https://en.cppreference.com/w/cpp/algorithm/partition_point
+// // set_intersection:				https://en.cppreference.com/w/cpp/algorithm/set_intersection
+// // set_union:					https://en.cppreference.com/w/cpp/algorithm/set_union
+// // set_difference:				https://en.cppreference.com/w/cpp/algorithm/set_difference
+// // count:						https://en.cppreference.com/w/cpp/algorithm/count
+// // find:							https://en.cppreference.com/w/cpp/algorithm/find
 
 #ifndef ALGORITHM_HPP
 # define ALGORITHM_HPP
 
+# include <algorithm>
+# include <climits>
+# include <cstddef>
+# include <cstring>
+# include <functional>
+# include <memory>
+
+# include "pair.hpp"
+# include "random_access_iterator.hpp"
+# include "type_traits.hpp"
+
+# if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define FT_ALGORITHM_X86_DISPATCH_ 1
+#  include <immintrin.h>
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+# endif
+
 namespace ft
 {
 
 
+/*
+	equal / lexicographical_compare on two contiguous ranges (pointers, ft::random_access_iterator)
+	of the same integral type compare the raw bytes instead of walking the elements:
+	equal is memcmp, and lexicographical_compare is memcmp for unsigned bytes, otherwise
+	the first mismatching byte is searched 32 (AVX2, when the cpu has it) or 16 (SSE2) bytes
+	at a time and only the element holding it is compared.
+	floating point is left to the element loop (0.0 == -0.0, NaN != NaN).
+*/
+
+// contiguous iterators, and how to get a pointer out of them
+template< class It >
+struct	contiguous_iterator_
+{
+	static const bool	value = false;
+	typedef void		value_type;
+};
+
+template< class T >
+struct	contiguous_iterator_<T*>
+{
+	static const bool									value = true;
+	typedef typename ft::remove_cv<T>::type				value_type;
+	typedef T*											pointer;
+
+	static pointer	base( T* it )
+	{ return (it); }
+};
+
+template< class T >
+struct	contiguous_iterator_<ft::random_access_iterator<T> >
+{
+	static const bool									value = true;
+	typedef typename ft::remove_cv<T>::type				value_type;
+	typedef T*											pointer;
+
+	static pointer	base( const ft::random_access_iterator<T>& it )
+	{ return (it.base()); }
+};
+
+// contiguous_iterator_<It>::value, as a trait of its own
+template< class It >
+struct	is_contiguous_iterator : public ft::integral_constant<bool, contiguous_iterator_<It>::value> {};
+
+template< class T1, class T2 >
+struct	same_integral_ : public ft::false_type {};
+
+template< class T >
+struct	same_integral_<T, T> : public ft::integral_constant<bool, ft::is_integral<T>::value> {};
+
+// the two ranges can be compared as bytes
+template< class It1, class It2 >
+struct	bitwise_comparable_
+: public ft::integral_constant<bool, contiguous_iterator_<It1>::value
+										&& contiguous_iterator_<It2>::value
+										&& same_integral_<typename contiguous_iterator_<It1>::value_type,
+															typename contiguous_iterator_<It2>::value_type>::value> {};
+
+// the byte order of memcmp is the element order
+template< class T >
+struct	memcmp_orderable_ : public ft::false_type {};
+
+template<>
+struct	memcmp_orderable_<unsigned char> : public ft::true_type {};
+
+template<>
+struct	memcmp_orderable_<char> : public ft::integral_constant<bool, CHAR_MIN == 0> {};
+
+template<>
+struct	memcmp_orderable_<bool> : public ft::true_type {};
+
+
+// index of the first byte which differs, or n
+inline std::size_t	mismatch_bytes_scalar_( const unsigned char* a, const unsigned char* b,
+											std::size_t i, std::size_t n )
+{
+	while (i < n && a[i] == b[i])
+		++i;
+	return (i);
+}
+
+# if defined(__SSE2__)
+inline std::size_t	mismatch_bytes_sse2_( const unsigned char* a, const unsigned char* b, std::size_t n )
+{
+	std::size_t	i = 0;
+
+	for (; i + 16 <= n; i += 16)
+	{
+		__m128i		x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		__m128i		y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+		unsigned	diff = _mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xFFFFu;
+
+		if (diff != 0)
+			return (i + __builtin_ctz(diff));
+	}
+	return (mismatch_bytes_scalar_(a, b, i, n));
+}
+# endif
+
+# ifdef FT_ALGORITHM_X86_DISPATCH_
+__attribute__((target("avx2")))
+inline std::size_t	mismatch_bytes_avx2_( const unsigned char* a, const unsigned char* b, std::size_t n )
+{
+	std::size_t	i = 0;
+
+	for (; i + 32 <= n; i += 32)
+	{
+		__m256i		x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+		__m256i		y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+		unsigned	diff = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+
+		if (diff != 0)
+			return (i + __builtin_ctz(diff));
+	}
+	return (mismatch_bytes_scalar_(a, b, i, n));
+}
+# endif
+
+inline std::size_t	mismatch_bytes_( const unsigned char* a, const unsigned char* b, std::size_t n )
+{
+# ifdef FT_ALGORITHM_X86_DISPATCH_
+	if (__builtin_cpu_supports("avx2"))
+		return (mismatch_bytes_avx2_(a, b, n));
+# endif
+# if defined(__SSE2__)
+	return (mismatch_bytes_sse2_(a, b, n));
+# else
+	return (mismatch_bytes_scalar_(a, b, 0, n));
+# endif
+}
+
 template< class InputIt1, class InputIt2 >
-bool	equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 )
+bool	equal_( InputIt1 first1, InputIt1 last1, InputIt2 first2, ft::false_type )
 {
 	for (; first1 != last1; ++first1, ++first2)
 		if (*first1 != *first2)
@@ -30,18 +202,18 @@ bool	equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 )
 	return (true);
 }
 
-template< class InputIt1, class InputIt2, class BinaryPredicate >
-bool	equal( InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p )
+template< class It1, class It2 >
+bool	equal_( It1 first1, It1 last1, It2 first2, ft::true_type )
 {
-	for (; first1 != last1; ++first1, ++first2)
-		if (!(p(*first1, *first2)))
-			return (false);
-	return (true);
+	std::size_t	n = last1 - first1;
+
+	return (n == 0 || std::memcmp(contiguous_iterator_<It1>::base(first1), contiguous_iterator_<It2>::base(first2),
+									n * sizeof(typename contiguous_iterator_<It1>::value_type)) == 0);
 }
 
 template< class InputIt1, class InputIt2 >
-bool	lexicographical_compare( InputIt1 first1, InputIt1 last1,
-									InputIt2 first2, InputIt2 last2 )
+bool	lexicographical_compare_( InputIt1 first1, InputIt1 last1,
+									InputIt2 first2, InputIt2 last2, ft::false_type )
 {
 	for (; (first1 != last1) && (first2 != last2); ++first1, (void)++first2)
 	{
@@ -53,6 +225,63 @@ bool	lexicographical_compare( InputIt1 first1, InputIt1 last1,
 	return ((first1 == last1) && (first2 != last2));
 }
 
+
+template< class T >
+bool	lexicographical_compare_bytes_( const T* a, std::size_t n1, const T* b, std::size_t n2, ft::true_type )
+{
+	int		cmp = std::memcmp(a, b, (n1 < n2 ? n1 : n2) * sizeof(T));
+
+	return (cmp != 0 ? cmp < 0 : n1 < n2);
+}
+
+template< class T >
+bool	lexicographical_compare_bytes_( const T* a, std::size_t n1, const T* b, std::size_t n2, ft::false_type )
+{
+	std::size_t	n = n1 < n2 ? n1 : n2;
+	std::size_t	i = mismatch_bytes_(reinterpret_cast<const unsigned char*>(a),
+									reinterpret_cast<const unsigned char*>(b), n * sizeof(T)) / sizeof(T);
+
+	return (i != n ? a[i] < b[i] : n1 < n2);
+}
+
+template< class It1, class It2 >
+bool	lexicographical_compare_( It1 first1, It1 last1, It2 first2, It2 last2, ft::true_type )
+{
+	typedef typename contiguous_iterator_<It1>::value_type	T;
+
+	std::size_t	n1 = last1 - first1;
+	std::size_t	n2 = last2 - first2;
+
+	if (n1 == 0 || n2 == 0)
+		return (n1 < n2);
+	return (lexicographical_compare_bytes_(contiguous_iterator_<It1>::base(first1), n1,
+											contiguous_iterator_<It2>::base(first2), n2,
+											memcmp_orderable_<T>()));
+}
+
+
+
+template< class InputIt1, class InputIt2 >
+bool	equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 )
+{ return (ft::equal_(first1, last1, first2, ft::bitwise_comparable_<InputIt1, InputIt2>())); }
+
+template< class InputIt1, class InputIt2, class BinaryPredicate >
+bool	equal( InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p )
+{
+	for (; first1 != last1; ++first1, ++first2)
+		if (!(p(*first1, *first2)))
+			return (false);
+	return (true);
+}
+
+template< class InputIt1, class InputIt2 >
+bool	lexicographical_compare( InputIt1 first1, InputIt1 last1,
+									InputIt2 first2, InputIt2 last2 )
+{
+	return (ft::lexicographical_compare_(first1, last1, first2, last2,
+											ft::bitwise_comparable_<InputIt1, InputIt2>()));
+}
+
 template< class InputIt1, class InputIt2, class Compare >
 bool	lexicographical_compare( InputIt1 first1, InputIt1 last1,
 									InputIt2 first2, InputIt2 last2,
@@ -69,6 +298,2315 @@ bool	lexicographical_compare( InputIt1 first1, InputIt1 last1,
 }
 
 
+/*
+	copy / copy_backward / fill / fill_n / uninitialized_copy / uninitialized_fill_n:
+	ft::random_access_iterator, and ft::reverse_iterator of it or of a pointer, are unwrapped
+	to the pointers they hold (unwrap_iterator_), then
+	- trivially copyable elements between pointers to the same type are moved by one memmove
+	  (a reverse range to a reverse range is the same block, moved backwards),
+	- fill is a memset for byte-sized integral types, and for any integral type filled with 0,
+	and the result is wrapped back into the caller's iterator type.
+*/
+
+template< class It >
+struct	unwrap_iterator_
+{
+	typedef It	type;
+
+	static type	unwrap( const It& it )
+	{ return (it); }
+
+	static It	rewrap( const It&, const type& it )
+	{ return (it); }
+};
+
+template< class T >
+struct	unwrap_iterator_<ft::random_access_iterator<T> >
+{
+	typedef T*	type;
+
+	static type	unwrap( const ft::random_access_iterator<T>& it )
+	{ return (it.base()); }
+
+	static ft::random_access_iterator<T>	rewrap( const ft::random_access_iterator<T>&, type it )
+	{ return (ft::random_access_iterator<T>(it)); }
+};
+
+template< class It >
+struct	unwrap_iterator_<ft::reverse_iterator<It> >
+{
+	typedef ft::reverse_iterator<typename unwrap_iterator_<It>::type>	type;
+
+	static type	unwrap( const ft::reverse_iterator<It>& it )
+	{ return (type(unwrap_iterator_<It>::unwrap(it.base()))); }
+
+	static ft::reverse_iterator<It>	rewrap( const ft::reverse_iterator<It>& original, const type& it )
+	{ return (ft::reverse_iterator<It>(unwrap_iterator_<It>::rewrap(original.base(), it.base()))); }
+};
+
+// [first, last) can be memmove()d to d_first
+template< class In, class Out >
+struct	memmove_copyable_ : public ft::false_type {};
+
+template< class T >
+struct	memmove_copyable_<T*, T*> : public ft::integral_constant<bool, ft::is_trivially_copyable<T>::value> {};
+
+template< class T >
+struct	memmove_copyable_<const T*, T*> : public ft::integral_constant<bool, ft::is_trivially_copyable<T>::value> {};
+
+template< class In, class Out >
+struct	memmove_copyable_<ft::reverse_iterator<In>, ft::reverse_iterator<Out> > : public memmove_copyable_<In, Out> {};
+
+
+template< class InputIt, class OutputIt >
+OutputIt	copy_( InputIt first, InputIt last, OutputIt d_first, ft::false_type )
+{
+	for (; first != last; ++first, (void)++d_first)
+		*d_first = *first;
+	return (d_first);
+}
+
+template< class BidirIt1, class BidirIt2 >
+BidirIt2	copy_backward_( BidirIt1 first, BidirIt1 last, BidirIt2 d_last, ft::false_type )
+{
+	while (first != last)
+		*--d_last = *--last;
+	return (d_last);
+}
+
+template< class T, class U >
+U*	copy_( T* first, T* last, U* d_first, ft::true_type )
+{
+	const std::size_t	n = last - first;
+
+	if (n != 0)
+		std::memmove(d_first, first, n * sizeof(U));
+	return (d_first + n);
+}
+
+template< class T, class U >
+U*	copy_backward_( T* first, T* last, U* d_last, ft::true_type )
+{
+	const std::size_t	n = last - first;
+
+	if (n != 0)
+		std::memmove(d_last - n, first, n * sizeof(U));
+	return (d_last - n);
+}
+
+template< class In, class Out >
+ft::reverse_iterator<Out>	copy_( ft::reverse_iterator<In> first, ft::reverse_iterator<In> last,
+									ft::reverse_iterator<Out> d_first, ft::true_type )
+{ return (ft::reverse_iterator<Out>(copy_backward_(last.base(), first.base(), d_first.base(), ft::true_type()))); }
+
+template< class In, class Out >
+ft::reverse_iterator<Out>	copy_backward_( ft::reverse_iterator<In> first, ft::reverse_iterator<In> last,
+											ft::reverse_iterator<Out> d_last, ft::true_type )
+{ return (ft::reverse_iterator<Out>(copy_(last.base(), first.base(), d_last.base(), ft::true_type()))); }
+
+template< class InputIt, class OutputIt >
+OutputIt	copy( InputIt first, InputIt last, OutputIt d_first )
+{
+	typedef unwrap_iterator_<InputIt>	in;
+	typedef unwrap_iterator_<OutputIt>	out;
+
+	return (out::rewrap(d_first, ft::copy_(in::unwrap(first), in::unwrap(last), out::unwrap(d_first),
+								memmove_copyable_<typename in::type, typename out::type>())));
+}
+
+template< class BidirIt1, class BidirIt2 >
+BidirIt2	copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last )
+{
+	typedef unwrap_iterator_<BidirIt1>	in;
+	typedef unwrap_iterator_<BidirIt2>	out;
+
+	return (out::rewrap(d_last, ft::copy_backward_(in::unwrap(first), in::unwrap(last), out::unwrap(d_last),
+								memmove_copyable_<typename in::type, typename out::type>())));
+}
+
+
+template< class ForwardIt, class T >
+void	fill_( ForwardIt first, ForwardIt last, const T& value )
+{
+	for (; first != last; ++first)
+		*first = value;
+}
+
+template< class T, class U >
+typename ft::enable_if<ft::is_integral<T>::value>::type	fill_( T* first, T* last, const U& value )
+{
+	const T		fill_value = value;
+
+	if (first == last)
+		return ;
+	if (sizeof(T) == 1 || fill_value == 0)
+		std::memset(first, static_cast<unsigned char>(fill_value), (last - first) * sizeof(T));
+	else
+		for (; first != last; ++first)
+			*first = fill_value;
+}
+
+template< class ForwardIt, class T >
+void	fill( ForwardIt first, ForwardIt last, const T& value )
+{
+	typedef unwrap_iterator_<ForwardIt>	unwrap;
+
+	ft::fill_(unwrap::unwrap(first), unwrap::unwrap(last), value);
+}
+
+template< class OutputIt, class Size, class T >
+OutputIt	fill_n_( OutputIt first, Size count, const T& value )
+{
+	for (; count > 0; --count, (void)++first)
+		*first = value;
+	return (first);
+}
+
+template< class U, class Size, class T >
+U*	fill_n_( U* first, Size count, const T& value )
+{
+	if (count <= 0)
+		return (first);
+	ft::fill_(first, first + count, value);
+	return (first + count);
+}
+
+template< class OutputIt, class Size, class T >
+OutputIt	fill_n( OutputIt first, Size count, const T& value )
+{
+	typedef unwrap_iterator_<OutputIt>	unwrap;
+
+	return (unwrap::rewrap(first, ft::fill_n_(unwrap::unwrap(first), count, value)));
+}
+
+
+// the elements are built in raw memory; if one constructor throws, the ones already built are destroyed
+template< class InputIt, class ForwardIt >
+ForwardIt	uninitialized_copy_( InputIt first, InputIt last, ForwardIt d_first, ft::false_type )
+{
+	typedef typename ft::iterator_traits<ForwardIt>::value_type	T;
+	ForwardIt	current = d_first;
+
+	try
+	{
+		for (; first != last; ++first, (void)++current)
+			::new (static_cast<void*>(&*current)) T(*first);
+	}
+	catch (...)
+	{
+		for (; d_first != current; ++d_first)
+			(*d_first).~T();
+		throw ;
+	}
+	return (current);
+}
+
+template< class InputIt, class ForwardIt >
+ForwardIt	uninitialized_copy_( InputIt first, InputIt last, ForwardIt d_first, ft::true_type )
+{ return (ft::copy_(first, last, d_first, ft::true_type())); }
+
+template< class InputIt, class ForwardIt >
+ForwardIt	uninitialized_copy( InputIt first, InputIt last, ForwardIt d_first )
+{
+	typedef unwrap_iterator_<InputIt>	in;
+	typedef unwrap_iterator_<ForwardIt>	out;
+
+	return (out::rewrap(d_first, ft::uninitialized_copy_(in::unwrap(first), in::unwrap(last), out::unwrap(d_first),
+								memmove_copyable_<typename in::type, typename out::type>())));
+}
+
+template< class ForwardIt, class Size, class T >
+ForwardIt	uninitialized_fill_n_( ForwardIt first, Size count, const T& value, ft::false_type )
+{
+	typedef typename ft::iterator_traits<ForwardIt>::value_type	V;
+	ForwardIt	current = first;
+
+	try
+	{
+		for (; count > 0; --count, (void)++current)
+			::new (static_cast<void*>(&*current)) V(value);
+	}
+	catch (...)
+	{
+		for (; first != current; ++first)
+			(*first).~V();
+		throw ;
+	}
+	return (current);
+}
+
+template< class ForwardIt, class Size, class T >
+ForwardIt	uninitialized_fill_n_( ForwardIt first, Size count, const T& value, ft::true_type )
+{ return (ft::fill_n_(first, count, value)); }
+
+template< class ForwardIt, class Size, class T >
+ForwardIt	uninitialized_fill_n( ForwardIt first, Size count, const T& value )
+{
+	typedef unwrap_iterator_<ForwardIt>	unwrap;
+
+	return (unwrap::rewrap(first, ft::uninitialized_fill_n_(unwrap::unwrap(first), count, value,
+							memmove_copyable_<typename unwrap::type, typename unwrap::type>())));
+}
+
+
+template< class InputIt, class UnaryFunction >
+UnaryFunction	for_each( InputIt first, InputIt last, UnaryFunction f )
+{
+	for (; first != last; ++first)
+		f(*first);
+	return (f);
+}
+
+template< class InputIt, class OutputIt, class UnaryOperation >
+OutputIt	transform( InputIt first1, InputIt last1, OutputIt d_first, UnaryOperation unary_op )
+{
+	for (; first1 != last1; ++first1, (void)++d_first)
+		*d_first = unary_op(*first1);
+	return (d_first);
+}
+
+template< class InputIt1, class InputIt2, class OutputIt, class BinaryOperation >
+OutputIt	transform( InputIt1 first1, InputIt1 last1, InputIt2 first2,
+						OutputIt d_first, BinaryOperation binary_op )
+{
+	for (; first1 != last1; ++first1, (void)++first2, (void)++d_first)
+		*d_first = binary_op(*first1, *first2);
+	return (d_first);
+}
+
+// the elements are combined in order here; the parallel overload (execution.hpp) regroups them,
+// so op has to be associative there
+template< class InputIt, class T, class BinaryOp >
+T	reduce( InputIt first, InputIt last, T init, BinaryOp op )
+{
+	for (; first != last; ++first)
+		init = op(init, *first);
+	return (init);
+}
+
+template< class InputIt, class T >
+T	reduce( InputIt first, InputIt last, T init )
+{ return (ft::reduce(first, last, init, std::plus<T>())); }
+
+template< class InputIt >
+typename ft::iterator_traits<InputIt>::value_type	reduce( InputIt first, InputIt last )
+{ return (ft::reduce(first, last, typename ft::iterator_traits<InputIt>::value_type())); }
+
+/*
+	sort: pattern-defeating quicksort (Orson Peters, "Pattern-defeating Quicksort"):
+	introsort with median of 3 (ninther above 128 elements) pivots, insertion sort below 24,
+	a partition_left which puts the run of elements equal to the pivot in place at once,
+	an early exit through a bounded insertion sort when a partition moved nothing (sorted input),
+	some swaps to break the pattern after an unbalanced partition, and heap sort when that
+	happens log2(n) times.
+	stable_sort: top down merge sort, merging through a scratch buffer of half the range.
+	both go to an LSD radix sort (one counting pass, then one scatter per byte which is not the
+	same for every key) when the range is contiguous, the keys integral and the order operator<.
+*/
+
+enum
+{
+	sort_insertion_threshold_ = 24,
+	sort_ninther_threshold_ = 128,
+	sort_partial_insertion_limit_ = 8,
+	sort_radix_threshold_ = 256,
+	stable_sort_run_ = 32
+};
+
+template< class It >
+void	iter_swap_( It a, It b )
+{
+	using std::swap;
+	swap(*a, *b);
+}
+
+template< class RandomIt, class Compare >
+void	insertion_sort_( RandomIt first, RandomIt last, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+
+	if (first == last)
+		return ;
+	for (RandomIt cur = first + 1; cur != last; ++cur)
+	{
+		RandomIt	sift = cur;
+		RandomIt	prev = cur - 1;
+
+		if (comp(*sift, *prev))
+		{
+			T	tmp = *sift;
+
+			do
+				*sift-- = *prev;
+			while (sift != first && comp(tmp, *--prev));
+			*sift = tmp;
+		}
+	}
+}
+
+// an element not greater than any of [first, last) must be just before first
+template< class RandomIt, class Compare >
+void	unguarded_insertion_sort_( RandomIt first, RandomIt last, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+
+	if (first == last)
+		return ;
+	for (RandomIt cur = first + 1; cur != last; ++cur)
+	{
+		RandomIt	sift = cur;
+		RandomIt	prev = cur - 1;
+
+		if (comp(*sift, *prev))
+		{
+			T	tmp = *sift;
+
+			do
+				*sift-- = *prev;
+			while (comp(tmp, *--prev));
+			*sift = tmp;
+		}
+	}
+}
+
+// insertion sort which gives up (returns false) after moving a few elements
+template< class RandomIt, class Compare >
+bool	partial_insertion_sort_( RandomIt first, RandomIt last, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+	std::size_t		moved = 0;
+
+	if (first == last)
+		return (true);
+	for (RandomIt cur = first + 1; cur != last; ++cur)
+	{
+		if (moved > sort_partial_insertion_limit_)
+			return (false);
+
+		RandomIt	sift = cur;
+		RandomIt	prev = cur - 1;
+
+		if (comp(*sift, *prev))
+		{
+			T	tmp = *sift;
+
+			do
+				*sift-- = *prev;
+			while (sift != first && comp(tmp, *--prev));
+			*sift = tmp;
+			moved += cur - sift;
+		}
+	}
+	return (true);
+}
+
+template< class RandomIt, class Compare >
+void	sort2_( RandomIt a, RandomIt b, Compare comp )
+{
+	if (comp(*b, *a))
+		iter_swap_(a, b);
+}
+
+template< class RandomIt, class Compare >
+void	sort3_( RandomIt a, RandomIt b, RandomIt c, Compare comp )
+{
+	sort2_(a, b, comp);
+	sort2_(b, c, comp);
+	sort2_(a, b, comp);
+}
+
+template< class RandomIt, class Compare >
+void	sift_down_( RandomIt first, std::ptrdiff_t hole, std::ptrdiff_t len, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+	T	value = first[hole];
+
+	for (std::ptrdiff_t child = 2 * hole + 1; child < len; child = 2 * hole + 1)
+	{
+		if (child + 1 < len && comp(first[child], first[child + 1]))
+			++child;
+		if (!comp(value, first[child]))
+			break ;
+		first[hole] = first[child];
+		hole = child;
+	}
+	first[hole] = value;
+}
+
+template< class RandomIt, class Compare >
+void	heap_sort_( RandomIt first, RandomIt last, Compare comp )
+{
+	std::ptrdiff_t	len = last - first;
+
+	for (std::ptrdiff_t i = len / 2; i-- > 0; )
+		sift_down_(first, i, len, comp);
+	while (--len > 0)
+	{
+		iter_swap_(first, first + len);
+		sift_down_(first, 0, len, comp);
+	}
+}
+
+// partition around *first, elements equal to the pivot go to the right.
+// returns the final position of the pivot, and whether no element had to be swapped
+template< class RandomIt, class Compare >
+ft::pair<RandomIt, bool>	partition_right_( RandomIt begin, RandomIt end, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+	T			pivot = *begin;
+	RandomIt	first = begin;
+	RandomIt	last = end;
+
+	// the median of 3 left an element >= pivot at the end, so the first search is guarded
+	while (comp(*++first, pivot))
+		;
+	if (first - 1 == begin)
+		while (first < last && !comp(*--last, pivot))
+			;
+	else
+		while (!comp(*--last, pivot))
+			;
+
+	bool	already_partitioned = first >= last;
+
+	while (first < last)
+	{
+		iter_swap_(first, last);
+		while (comp(*++first, pivot))
+			;
+		while (!comp(*--last, pivot))
+			;
+	}
+
+	RandomIt	pivot_pos = first - 1;
+
+	*begin = *pivot_pos;
+	*pivot_pos = pivot;
+	return (ft::make_pair(pivot_pos, already_partitioned));
+}
+
+// partition around *first, elements equal to the pivot go to the left.
+// used when the pivot equals the element before the range: the left part is then all equal
+template< class RandomIt, class Compare >
+RandomIt	partition_left_( RandomIt begin, RandomIt end, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+	T			pivot = *begin;
+	RandomIt	first = begin;
+	RandomIt	last = end;
+
+	while (comp(pivot, *--last))
+		;
+	if (last + 1 == end)
+		while (first < last && !comp(pivot, *++first))
+			;
+	else
+		while (!comp(pivot, *++first))
+			;
+	while (first < last)
+	{
+		iter_swap_(first, last);
+		while (comp(pivot, *--last))
+			;
+		while (!comp(pivot, *++first))
+			;
+	}
+
+	RandomIt	pivot_pos = last;
+
+	*begin = *pivot_pos;
+	*pivot_pos = pivot;
+	return (pivot_pos);
+}
+
+// move the pivot to *begin: median of 3, or above sort_ninther_threshold_ the median of 3 medians
+template< class RandomIt, class Compare >
+void	choose_pivot_( RandomIt begin, RandomIt end, Compare comp )
+{
+	typename ft::iterator_traits<RandomIt>::difference_type	size = end - begin;
+	typename ft::iterator_traits<RandomIt>::difference_type	half = size / 2;
+
+	if (size > sort_ninther_threshold_)
+	{
+		sort3_(begin, begin + half, end - 1, comp);
+		sort3_(begin + 1, begin + (half - 1), end - 2, comp);
+		sort3_(begin + 2, begin + (half + 1), end - 3, comp);
+		sort3_(begin + (half - 1), begin + half, begin + (half + 1), comp);
+		iter_swap_(begin, begin + half);
+	}
+	else
+		sort3_(begin + half, begin, end - 1, comp);
+}
+
+// after an unbalanced partition, swap a few elements on both sides so that
+// the next pivots are not picked out of the same pattern
+template< class RandomIt >
+void	break_patterns_( RandomIt begin, RandomIt pivot_pos, RandomIt end )
+{
+	typename ft::iterator_traits<RandomIt>::difference_type	l_size = pivot_pos - begin;
+	typename ft::iterator_traits<RandomIt>::difference_type	r_size = end - (pivot_pos + 1);
+
+	if (l_size >= sort_insertion_threshold_)
+	{
+		iter_swap_(begin, begin + l_size / 4);
+		iter_swap_(pivot_pos - 1, pivot_pos - l_size / 4);
+		if (l_size > sort_ninther_threshold_)
+		{
+			iter_swap_(begin + 1, begin + (l_size / 4 + 1));
+			iter_swap_(begin + 2, begin + (l_size / 4 + 2));
+			iter_swap_(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+			iter_swap_(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+		}
+	}
+	if (r_size >= sort_insertion_threshold_)
+	{
+		iter_swap_(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+		iter_swap_(end - 1, end - r_size / 4);
+		if (r_size > sort_ninther_threshold_)
+		{
+			iter_swap_(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+			iter_swap_(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+			iter_swap_(end - 2, end - (1 + r_size / 4));
+			iter_swap_(end - 3, end - (2 + r_size / 4));
+		}
+	}
+}
+
+// leftmost: nothing is before begin, otherwise *(begin - 1) is not greater than any of the range
+template< class RandomIt, class Compare >
+void	pdqsort_loop_( RandomIt begin, RandomIt end, Compare comp, int bad_allowed, bool leftmost )
+{
+	typedef typename ft::iterator_traits<RandomIt>::difference_type	diff_t;
+
+	while (true)
+	{
+		diff_t	size = end - begin;
+
+		if (size < sort_insertion_threshold_)
+		{
+			if (leftmost)
+				insertion_sort_(begin, end, comp);
+			else
+				unguarded_insertion_sort_(begin, end, comp);
+			return ;
+		}
+
+		choose_pivot_(begin, end, comp);
+
+		// the pivot equals the element before the range: skip the whole run of equal elements
+		if (!leftmost && !comp(*(begin - 1), *begin))
+		{
+			begin = partition_left_(begin, end, comp) + 1;
+			continue ;
+		}
+
+		ft::pair<RandomIt, bool>	part = partition_right_(begin, end, comp);
+		RandomIt					pivot_pos = part.first;
+		diff_t						l_size = pivot_pos - begin;
+		diff_t						r_size = end - (pivot_pos + 1);
+
+		if (l_size < size / 8 || r_size < size / 8)
+		{	// highly unbalanced: fall back to heap sort if it keeps happening, otherwise shuffle a bit
+			if (--bad_allowed == 0)
+			{
+				heap_sort_(begin, end, comp);
+				return ;
+			}
+			break_patterns_(begin, pivot_pos, end);
+		}
+		else if (part.second && partial_insertion_sort_(begin, pivot_pos, comp)
+								&& partial_insertion_sort_(pivot_pos + 1, end, comp))
+			return ;	// nothing was swapped, and both sides were (nearly) sorted already
+
+		// recurse into the left side, loop on the right side
+		pdqsort_loop_(begin, pivot_pos, comp, bad_allowed, leftmost);
+		begin = pivot_pos + 1;
+		leftmost = false;
+	}
+}
+
+template< class RandomIt, class Compare >
+void	pdqsort_( RandomIt first, RandomIt last, Compare comp )
+{
+	int		log2 = 0;
+
+	if (first == last)
+		return ;
+	for (typename ft::iterator_traits<RandomIt>::difference_type n = last - first; n > 1; n >>= 1)
+		++log2;
+	pdqsort_loop_(first, last, comp, log2 + 1, true);
+}
+
+
+// radix sort of integral keys: the key bits are compared as unsigned, with the sign bit flipped
+template< std::size_t Size >
+struct	radix_unsigned_;
+
+template<>
+struct	radix_unsigned_<1> { typedef unsigned char type; };
+
+template<>
+struct	radix_unsigned_<2> { typedef unsigned short type; };
+
+template<>
+struct	radix_unsigned_<4> { typedef unsigned int type; };
+
+template<>
+struct	radix_unsigned_<8> { typedef unsigned long type; };
+
+template< class T >
+typename radix_unsigned_<sizeof(T)>::type	radix_key_( T x )
+{
+	typedef typename radix_unsigned_<sizeof(T)>::type	U;
+	const bool	is_signed = T(-1) < T(0);
+
+	return (static_cast<U>(x) ^ (is_signed ? U(U(1) << (sizeof(T) * CHAR_BIT - 1)) : U(0)));
+}
+
+template< class T >
+void	radix_sort_( T* first, T* last )
+{
+	typedef typename radix_unsigned_<sizeof(T)>::type	U;
+	const std::size_t	n = last - first;
+
+	if (n < sort_radix_threshold_)
+	{
+		pdqsort_(first, last, std::less<T>());
+		return ;
+	}
+
+	// one pass counts every byte of every key
+	std::size_t		counts[sizeof(T)][256];
+
+	std::memset(counts, 0, sizeof(counts));
+	for (T* it = first; it != last; ++it)
+	{
+		U	key = radix_key_(*it);
+
+		for (std::size_t b = 0; b < sizeof(T); ++b)
+			++counts[b][(key >> (b * CHAR_BIT)) & 0xFF];
+	}
+
+	std::allocator<T>	alloc;
+	T*					buffer = alloc.allocate(n);
+	T*					src = first;
+	T*					dst = buffer;
+	const U				first_key = radix_key_(*first);
+
+	for (std::size_t b = 0; b < sizeof(T); ++b)
+	{
+		std::size_t*	count = counts[b];
+		const unsigned	shift = b * CHAR_BIT;
+
+		if (count[(first_key >> shift) & 0xFF] == n)
+			continue ;	// every key has the same byte here
+		for (std::size_t i = 0, offset = 0; i < 256; ++i)
+		{
+			std::size_t	c = count[i];
+
+			count[i] = offset;
+			offset += c;
+		}
+		for (T* it = src; it != src + n; ++it)
+			dst[count[(radix_key_(*it) >> shift) & 0xFF]++] = *it;
+		std::swap(src, dst);
+	}
+	if (src != first)
+		std::memcpy(first, src, n * sizeof(T));
+	alloc.deallocate(buffer, n);
+}
+
+template< class RandomIt >
+struct	radix_sortable_
+: public ft::integral_constant<bool, contiguous_iterator_<RandomIt>::value
+										&& ft::is_integral<typename contiguous_iterator_<RandomIt>::value_type>::value> {};
+
+template< class RandomIt >
+void	sort_( RandomIt first, RandomIt last, ft::true_type )
+{
+	radix_sort_(contiguous_iterator_<RandomIt>::base(first),
+				contiguous_iterator_<RandomIt>::base(first) + (last - first));
+}
+
+template< class RandomIt >
+void	sort_( RandomIt first, RandomIt last, ft::false_type )
+{ pdqsort_(first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>()); }
+
+
+// merge the sorted [first, middle) and [middle, last); [first, middle) fits in buffer
+template< class RandomIt, class T, class Compare >
+void	merge_with_buffer_( RandomIt first, RandomIt middle, RandomIt last, T* buffer, Compare comp )
+{
+	T*	buf_last = buffer;
+
+	for (RandomIt it = first; it != middle; ++it, ++buf_last)
+		*buf_last = *it;
+
+	T*	buf = buffer;
+
+	// on ties the left element (from the buffer) goes first, which keeps the sort stable
+	while (buf != buf_last && middle != last)
+	{
+		if (comp(*middle, *buf))
+			*first++ = *middle++;
+		else
+			*first++ = *buf++;
+	}
+	while (buf != buf_last)
+		*first++ = *buf++;
+}
+
+template< class RandomIt, class T, class Compare >
+void	merge_sort_( RandomIt first, RandomIt last, T* buffer, Compare comp )
+{
+	if (last - first <= stable_sort_run_)
+	{
+		insertion_sort_(first, last, comp);
+		return ;
+	}
+
+	RandomIt	middle = first + (last - first) / 2;
+
+	merge_sort_(first, middle, buffer, comp);
+	merge_sort_(middle, last, buffer, comp);
+	if (comp(*middle, *(middle - 1)))
+		merge_with_buffer_(first, middle, last, buffer, comp);
+}
+
+template< class RandomIt, class Compare >
+void	buffered_stable_sort_( RandomIt first, RandomIt last, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+	const std::size_t	len = (last - first + 1) / 2;
+
+	if (last - first <= stable_sort_run_)
+	{
+		insertion_sort_(first, last, comp);
+		return ;
+	}
+
+	// the buffer holds copies of *first, and is only assigned to from then on
+	std::allocator<T>	alloc;
+	T*					buffer = alloc.allocate(len);
+	std::size_t			built = 0;
+
+	try
+	{
+		for (; built < len; ++built)
+			alloc.construct(buffer + built, *first);
+		merge_sort_(first, last, buffer, comp);
+	}
+	catch (...)
+	{
+		while (built != 0)
+			alloc.destroy(buffer + --built);
+		alloc.deallocate(buffer, len);
+		throw ;
+	}
+	while (built != 0)
+		alloc.destroy(buffer + --built);
+	alloc.deallocate(buffer, len);
+}
+
+template< class RandomIt >
+void	stable_sort_( RandomIt first, RandomIt last, ft::true_type )
+{ sort_(first, last, ft::true_type()); }	// the radix sort is stable
+
+template< class RandomIt >
+void	stable_sort_( RandomIt first, RandomIt last, ft::false_type )
+{ buffered_stable_sort_(first, last, std::less<typename ft::iterator_traits<RandomIt>::value_type>()); }
+
+
+template< class RandomIt >
+void	sort( RandomIt first, RandomIt last )
+{ ft::sort_(first, last, ft::radix_sortable_<RandomIt>()); }
+
+template< class RandomIt, class Compare >
+void	sort( RandomIt first, RandomIt last, Compare comp )
+{ ft::pdqsort_(first, last, comp); }
+
+template< class RandomIt >
+void	stable_sort( RandomIt first, RandomIt last )
+{ ft::stable_sort_(first, last, ft::radix_sortable_<RandomIt>()); }
+
+template< class RandomIt, class Compare >
+void	stable_sort( RandomIt first, RandomIt last, Compare comp )
+{ ft::buffered_stable_sort_(first, last, comp); }
+
+
+/*
+	lower_bound / upper_bound / binary_search / equal_range: branchless binary search on
+	random access ranges (Khuong and Morin, "Array Layouts for Comparison-Based Searching").
+	the range is halved until one element is left whatever the comparisons say, and each
+	comparison only picks the half through a conditional move, so there is no branch to
+	mispredict. on pointers (ft::random_access_iterator is unwrapped) both possible next
+	probes are prefetched while the current one is compared: out of cache, a search waits
+	on about one miss per two levels instead of one per level.
+	lower_bound_many runs a batch of searches on the same range level by level, so the
+	misses of the batch overlap.
+	other iterators (ft::map ...) get the usual search, with ft::advance.
+*/
+
+enum { lower_bound_many_batch_ = 16 };
+
+// a < b for mixed types: the default order of the searches
+struct	less_
+{
+	template< class T, class U >
+	bool	operator()( const T& a, const U& b ) const
+	{ return (a < b); }
+};
+
+template< class T >
+void	prefetch_( T* p )
+{ __builtin_prefetch(p); }
+
+template< class It >
+void	prefetch_( const It& )
+{}
+
+template< class ForwardIt, class T, class Compare >
+ForwardIt	lower_bound_( ForwardIt first, ForwardIt last, const T& value, Compare comp, ft::forward_iterator_tag )
+{
+	typename ft::iterator_traits<ForwardIt>::difference_type	len = ft::distance(first, last);
+
+	while (len > 0)
+	{
+		typename ft::iterator_traits<ForwardIt>::difference_type	half = len / 2;
+		ForwardIt	middle = first;
+
+		ft::advance(middle, half);
+		if (comp(*middle, value))
+		{
+			first = ++middle;
+			len -= half + 1;
+		}
+		else
+			len = half;
+	}
+	return (first);
+}
+
+template< class RandomIt, class T, class Compare >
+RandomIt	lower_bound_( RandomIt first, RandomIt last, const T& value, Compare comp, ft::random_access_iterator_tag )
+{
+	typedef typename ft::iterator_traits<RandomIt>::difference_type	difference_type;
+	difference_type	len = last - first;
+
+	if (len == 0)
+		return (first);
+	while (len > 1)
+	{
+		const difference_type	half = len / 2;
+
+		prefetch_(first + half / 2);
+		prefetch_(first + (half + half / 2));
+		first = comp(first[half], value) ? first + half : first;
+		len -= half;
+	}
+	return (first + static_cast<difference_type>(comp(*first, value)));
+}
+
+template< class ForwardIt, class T, class Compare >
+ForwardIt	upper_bound_( ForwardIt first, ForwardIt last, const T& value, Compare comp, ft::forward_iterator_tag )
+{
+	typename ft::iterator_traits<ForwardIt>::difference_type	len = ft::distance(first, last);
+
+	while (len > 0)
+	{
+		typename ft::iterator_traits<ForwardIt>::difference_type	half = len / 2;
+		ForwardIt	middle = first;
+
+		ft::advance(middle, half);
+		if (!comp(value, *middle))
+		{
+			first = ++middle;
+			len -= half + 1;
+		}
+		else
+			len = half;
+	}
+	return (first);
+}
+
+template< class RandomIt, class T, class Compare >
+RandomIt	upper_bound_( RandomIt first, RandomIt last, const T& value, Compare comp, ft::random_access_iterator_tag )
+{
+	typedef typename ft::iterator_traits<RandomIt>::difference_type	difference_type;
+	difference_type	len = last - first;
+
+	if (len == 0)
+		return (first);
+	while (len > 1)
+	{
+		const difference_type	half = len / 2;
+
+		prefetch_(first + half / 2);
+		prefetch_(first + (half + half / 2));
+		first = comp(value, first[half]) ? first : first + half;
+		len -= half;
+	}
+	return (first + static_cast<difference_type>(!comp(value, *first)));
+}
+
+
+template< class ForwardIt, class T, class Compare >
+ForwardIt	lower_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+{
+	typedef unwrap_iterator_<ForwardIt>	unwrap;
+
+	return (unwrap::rewrap(first, ft::lower_bound_(unwrap::unwrap(first), unwrap::unwrap(last), value, comp,
+													ft::iterator_category(unwrap::unwrap(first)))));
+}
+
+template< class ForwardIt, class T >
+ForwardIt	lower_bound( ForwardIt first, ForwardIt last, const T& value )
+{ return (ft::lower_bound(first, last, value, less_())); }
+
+template< class ForwardIt, class T, class Compare >
+ForwardIt	upper_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+{
+	typedef unwrap_iterator_<ForwardIt>	unwrap;
+
+	return (unwrap::rewrap(first, ft::upper_bound_(unwrap::unwrap(first), unwrap::unwrap(last), value, comp,
+													ft::iterator_category(unwrap::unwrap(first)))));
+}
+
+template< class ForwardIt, class T >
+ForwardIt	upper_bound( ForwardIt first, ForwardIt last, const T& value )
+{ return (ft::upper_bound(first, last, value, less_())); }
+
+template< class ForwardIt, class T, class Compare >
+bool	binary_search( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+{
+	first = ft::lower_bound(first, last, value, comp);
+	return (first != last && !comp(value, *first));
+}
+
+template< class ForwardIt, class T >
+bool	binary_search( ForwardIt first, ForwardIt last, const T& value )
+{ return (ft::binary_search(first, last, value, less_())); }
+
+template< class ForwardIt, class T, class Compare >
+ft::pair<ForwardIt, ForwardIt>	equal_range( ForwardIt first, ForwardIt last, const T& value, Compare comp )
+{
+	first = ft::lower_bound(first, last, value, comp);
+	return (ft::make_pair(first, ft::upper_bound(first, last, value, comp)));
+}
+
+template< class ForwardIt, class T >
+ft::pair<ForwardIt, ForwardIt>	equal_range( ForwardIt first, ForwardIt last, const T& value )
+{ return (ft::equal_range(first, last, value, less_())); }
+
+// *d_first++ = ft::lower_bound(first, last, key) for each key of [keys_first, keys_last).
+// the keys are copied a batch at a time (the key type must be default constructible),
+// and every search of a batch does the same number of halvings, so they go down together
+template< class RandomIt, class InputIt, class OutputIt, class Compare >
+OutputIt	lower_bound_many( RandomIt first, RandomIt last, InputIt keys_first, InputIt keys_last,
+								OutputIt d_first, Compare comp )
+{
+	typedef unwrap_iterator_<RandomIt>									unwrap;
+	typedef typename unwrap::type										It;
+	typedef typename ft::iterator_traits<It>::difference_type			difference_type;
+	typedef typename ft::iterator_traits<InputIt>::value_type			Key;
+
+	const It				begin = unwrap::unwrap(first);
+	const difference_type	total = unwrap::unwrap(last) - begin;
+	Key						keys[lower_bound_many_batch_];
+	It						bases[lower_bound_many_batch_];
+
+	while (keys_first != keys_last)
+	{
+		std::size_t		count = 0;
+
+		for (; count < lower_bound_many_batch_ && keys_first != keys_last; ++count, (void)++keys_first)
+		{
+			keys[count] = *keys_first;
+			bases[count] = begin;
+		}
+		for (difference_type len = total; len > 1; )
+		{
+			const difference_type	half = len / 2;
+			const difference_type	next_half = (len - half) / 2;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				bases[i] = comp(bases[i][half], keys[i]) ? bases[i] + half : bases[i];
+				prefetch_(bases[i] + next_half);
+			}
+			len -= half;
+		}
+		for (std::size_t i = 0; i < count; ++i, (void)++d_first)
+			*d_first = unwrap::rewrap(first, bases[i] + static_cast<difference_type>(total != 0 && comp(*bases[i], keys[i])));
+	}
+	return (d_first);
+}
+
+template< class RandomIt, class InputIt, class OutputIt >
+OutputIt	lower_bound_many( RandomIt first, RandomIt last, InputIt keys_first, InputIt keys_last, OutputIt d_first )
+{ return (ft::lower_bound_many(first, last, keys_first, keys_last, d_first, less_())); }
+
+
+/*
+	nth_element: introselect on the partitions of pdqsort (same pivots, partition_left_ for the
+	runs equal to the element before the range), following only the side which holds nth,
+	insertion sort below sort_insertion_threshold_ elements, and heap sort of what is left
+	after log2(n) unbalanced partitions, so the worst case stays O(n log n).
+	nth_elements places several ranks in one pass: a partition is shared by all the ranks,
+	and the walk only splits where ranks fall on both sides of the pivot, so k percentiles
+	cost about n log2(k) + 2n comparisons instead of k times 2n.
+	quantiles reads the percentiles off the ranks placed by nth_elements.
+	partial_sort: a heap of the head when it is under 1 / partial_sort_heap_ratio_ of the range
+	(each other element costs one comparison with the top), otherwise nth_element on the last
+	rank then pdqsort of the head.
+	partition_point: the branchless lower_bound, with pred as the comparison.
+*/
+
+enum { partial_sort_heap_ratio_ = 16 };
+
+// ranks: ascending offsets from first, all in [0, last - first)
+template< class RandomIt, class RankIt, class Compare >
+void	select_loop_( RandomIt first, RandomIt begin, RandomIt end, RankIt rank_first, RankIt rank_last,
+						Compare comp, int bad_allowed, bool leftmost )
+{
+	typedef typename ft::iterator_traits<RandomIt>::difference_type	diff_t;
+	typedef typename ft::iterator_traits<RankIt>::value_type		rank_t;
+
+	while (rank_first != rank_last)
+	{
+		diff_t	size = end - begin;
+
+		if (size < sort_insertion_threshold_)
+		{
+			insertion_sort_(begin, end, comp);
+			return ;
+		}
+		choose_pivot_(begin, end, comp);
+
+		// the pivot equals the element before the range: the run of equal elements is in place
+		if (!leftmost && !comp(*(begin - 1), *begin))
+		{
+			begin = partition_left_(begin, end, comp) + 1;
+			while (rank_first != rank_last && first + *rank_first < begin)
+				++rank_first;
+			continue ;
+		}
+
+		RandomIt	pivot_pos = partition_right_(begin, end, comp).first;
+		diff_t		l_size = pivot_pos - begin;
+		diff_t		r_size = end - (pivot_pos + 1);
+
+		if (l_size < size / 8 || r_size < size / 8)
+		{
+			if (--bad_allowed == 0)
+			{
+				heap_sort_(begin, end, comp);
+				return ;
+			}
+			break_patterns_(begin, pivot_pos, end);
+		}
+
+		const rank_t	pivot_rank = static_cast<rank_t>(pivot_pos - first);
+		RankIt			left_last = ft::lower_bound(rank_first, rank_last, pivot_rank);
+		RankIt			right_first = left_last;
+
+		while (right_first != rank_last && *right_first == pivot_rank)
+			++right_first;
+		if (right_first == rank_last)
+		{	// nothing on the right: loop on the left
+			end = pivot_pos;
+			rank_last = left_last;
+			continue ;
+		}
+		if (rank_first != left_last)
+			select_loop_(first, begin, pivot_pos, rank_first, left_last, comp, bad_allowed, leftmost);
+		begin = pivot_pos + 1;
+		rank_first = right_first;
+		leftmost = false;
+	}
+}
+
+template< class RandomIt, class RankIt, class Compare >
+void	select_( RandomIt first, RandomIt last, RankIt rank_first, RankIt rank_last, Compare comp )
+{
+	int		log2 = 0;
+
+	for (typename ft::iterator_traits<RandomIt>::difference_type n = last - first; n > 1; n >>= 1)
+		++log2;
+	select_loop_(first, first, last, rank_first, rank_last, comp, log2 + 1, true);
+}
+
+// pred(x) as a comparison of x with pred, for the binary search of partition_point
+struct	partition_point_comp_
+{
+	template< class T, class UnaryPredicate >
+	bool	operator()( const T& x, const UnaryPredicate& pred ) const
+	{ return (pred(x)); }
+};
+
+template< class ForwardIt, class UnaryPredicate >
+ForwardIt	partition_( ForwardIt first, ForwardIt last, UnaryPredicate pred, ft::forward_iterator_tag )
+{
+	while (first != last && pred(*first))
+		++first;
+	if (first == last)
+		return (first);
+	for (ForwardIt it = first; ++it != last; )
+		if (pred(*it))
+		{
+			iter_swap_(first, it);
+			++first;
+		}
+	return (first);
+}
+
+template< class BidirIt, class UnaryPredicate >
+BidirIt		partition_( BidirIt first, BidirIt last, UnaryPredicate pred, ft::bidirectional_iterator_tag )
+{
+	while (true)
+	{
+		while (first != last && pred(*first))
+			++first;
+		if (first == last)
+			return (first);
+		do
+			if (--last == first)
+				return (first);
+		while (!pred(*last));
+		iter_swap_(first, last);
+		++first;
+	}
+}
+
+
+template< class RandomIt, class Compare >
+void	nth_element( RandomIt first, RandomIt nth, RandomIt last, Compare comp )
+{
+	if (nth == last)
+		return ;
+
+	const typename ft::iterator_traits<RandomIt>::difference_type	rank = nth - first;
+
+	ft::select_(first, last, &rank, &rank + 1, comp);
+}
+
+template< class RandomIt >
+void	nth_element( RandomIt first, RandomIt nth, RandomIt last )
+{ ft::nth_element(first, nth, last, less_()); }
+
+// places each of the ascending ranks [rank_first, rank_last) (offsets from first) as
+// nth_element would: every element before a placed rank is not greater than it, every one after not less
+template< class RandomIt, class RankIt, class Compare >
+void	nth_elements( RandomIt first, RandomIt last, RankIt rank_first, RankIt rank_last, Compare comp )
+{ ft::select_(first, last, rank_first, rank_last, comp); }
+
+template< class RandomIt, class RankIt >
+void	nth_elements( RandomIt first, RandomIt last, RankIt rank_first, RankIt rank_last )
+{ ft::select_(first, last, rank_first, rank_last, less_()); }
+
+// *d_first++ = the element of rank q * (n - 1) (rounded down) for each q of [q_first, q_last),
+// which must be ascending and in [0, 1]. [first, last) is reordered as by nth_elements
+template< class RandomIt, class ForwardIt, class OutputIt, class Compare >
+OutputIt	quantiles( RandomIt first, RandomIt last, ForwardIt q_first, ForwardIt q_last, OutputIt d_first, Compare comp )
+{
+	const std::size_t			n = last - first;
+	const std::size_t			count = ft::distance(q_first, q_last);
+	std::allocator<std::size_t>	alloc;
+	std::size_t*				ranks;
+
+	if (n == 0 || count == 0)
+		return (d_first);
+	ranks = alloc.allocate(count);
+	for (std::size_t i = 0; i < count; ++i, (void)++q_first)
+		ranks[i] = static_cast<std::size_t>(*q_first * (n - 1));
+	try
+	{
+		ft::select_(first, last, ranks, ranks + count, comp);
+		for (std::size_t i = 0; i < count; ++i, (void)++d_first)
+			*d_first = first[ranks[i]];
+	}
+	catch (...)
+	{
+		alloc.deallocate(ranks, count);
+		throw ;
+	}
+	alloc.deallocate(ranks, count);
+	return (d_first);
+}
+
+template< class RandomIt, class ForwardIt, class OutputIt >
+OutputIt	quantiles( RandomIt first, RandomIt last, ForwardIt q_first, ForwardIt q_last, OutputIt d_first )
+{ return (ft::quantiles(first, last, q_first, q_last, d_first, less_())); }
+
+// the head as a max heap: the rest of the range is compared once with its top, and only
+// the elements which beat it go through the heap
+template< class RandomIt, class Compare >
+void	heap_select_( RandomIt first, RandomIt middle, RandomIt last, Compare comp )
+{
+	std::ptrdiff_t	len = middle - first;
+
+	for (std::ptrdiff_t i = len / 2; i-- > 0; )
+		sift_down_(first, i, len, comp);
+	for (RandomIt it = middle; it != last; ++it)
+		if (comp(*it, *first))
+		{
+			iter_swap_(first, it);
+			sift_down_(first, 0, len, comp);
+		}
+	while (--len > 0)
+	{
+		iter_swap_(first, first + len);
+		sift_down_(first, 0, len, comp);
+	}
+}
+
+template< class RandomIt, class Compare >
+void	partial_sort( RandomIt first, RandomIt middle, RandomIt last, Compare comp )
+{
+	if (first == middle)
+		return ;
+	if ((middle - first) * partial_sort_heap_ratio_ < last - first)
+		ft::heap_select_(first, middle, last, comp);
+	else
+	{
+		ft::nth_element(first, middle - 1, last, comp);
+		ft::pdqsort_(first, middle - 1, comp);
+	}
+}
+
+template< class RandomIt >
+void	partial_sort( RandomIt first, RandomIt middle, RandomIt last )
+{ ft::partial_sort(first, middle, last, less_()); }
+
+template< class ForwardIt, class UnaryPredicate >
+ForwardIt	partition( ForwardIt first, ForwardIt last, UnaryPredicate pred )
+{ return (ft::partition_(first, last, pred, ft::iterator_category(first))); }
+
+template< class ForwardIt, class UnaryPredicate >
+ForwardIt	partition_point( ForwardIt first, ForwardIt last, UnaryPredicate pred )
+{ return (ft::lower_bound(first, last, pred, partition_point_comp_())); }
+
+
+/*
+	set_intersection / set_union / set_difference, with the std results on multisets
+	(the equivalent elements are paired one to one, in order).
+	two random access ranges whose sizes differ by more than set_gallop_ratio_ are walked
+	along the shorter one: each of its elements finds its place in the longer one by
+	galloping (steps of 1, 2, 4... from the last place, then a binary search of the last step),
+	so the cost is about m log(n / m) comparisons instead of m + n, and the runs of the longer
+	range which go to the output are copied in bulk (memmove for trivial types).
+	the intersection of two contiguous ranges of the same 32 bits integral type, in the
+	default order, compares 4 keys of each range with 4 others at once (SSE2: the 4 rotations
+	of one block against the other, as in Schlegel, Willhalm and Lehner, "Fast
+	Sorted-Set Intersection using SIMD Instructions"). equal keys inside a range would be
+	paired more than once there, so a block which holds some goes through the scalar merge.
+	everything else is the usual merge, and works on any input iterators, e.g. the keys of
+	ft::map through ft::key_iterator.
+*/
+
+enum { set_gallop_ratio_ = 32 };
+
+// the first position of [first, last) not before value, by galloping
+template< class RandomIt, class T, class Compare >
+RandomIt	gallop_( RandomIt first, RandomIt last, const T& value, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::difference_type	diff_t;
+	const diff_t	len = last - first;
+	diff_t			lo = 0;
+	diff_t			hi = 1;
+
+	if (len == 0 || !comp(*first, value))
+		return (first);
+	while (hi < len && comp(first[hi], value))
+	{
+		lo = hi;
+		hi = 2 * hi + 1;
+	}
+	return (ft::lower_bound(first + (lo + 1), first + (hi < len ? hi : len), value, comp));
+}
+
+// intersection: the elements come from the first range
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	gallop_intersection_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+									OutputIt d_first, Compare comp )
+{
+	if (last1 - first1 <= last2 - first2)
+	{
+		for (; first1 != last1 && first2 != last2; ++first1)
+		{
+			first2 = gallop_(first2, last2, *first1, comp);
+			if (first2 != last2 && !comp(*first1, *first2))
+			{
+				*d_first = *first1;
+				++d_first;
+				++first2;
+			}
+		}
+	}
+	else
+	{
+		for (; first1 != last1 && first2 != last2; ++first2)
+		{
+			first1 = gallop_(first1, last1, *first2, comp);
+			if (first1 != last1 && !comp(*first2, *first1))
+			{
+				*d_first = *first1;
+				++d_first;
+				++first1;
+			}
+		}
+	}
+	return (d_first);
+}
+
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	gallop_union_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+							OutputIt d_first, Compare comp )
+{
+	if (last1 - first1 <= last2 - first2)
+	{
+		for (; first1 != last1; ++first1)
+		{
+			RandomIt2	place = gallop_(first2, last2, *first1, comp);
+
+			d_first = ft::copy(first2, place, d_first);
+			*d_first = *first1;
+			++d_first;
+			first2 = (place != last2 && !comp(*first1, *place)) ? place + 1 : place;
+		}
+	}
+	else
+	{
+		for (; first2 != last2; ++first2)
+		{
+			RandomIt1	place = gallop_(first1, last1, *first2, comp);
+
+			d_first = ft::copy(first1, place, d_first);
+			if (place != last1 && !comp(*first2, *place))
+				*d_first = *place++;
+			else
+				*d_first = *first2;
+			++d_first;
+			first1 = place;
+		}
+	}
+	return (ft::copy(first2, last2, ft::copy(first1, last1, d_first)));
+}
+
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	gallop_difference_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+								OutputIt d_first, Compare comp )
+{
+	if (last1 - first1 <= last2 - first2)
+	{
+		for (; first1 != last1 && first2 != last2; ++first1)
+		{
+			first2 = gallop_(first2, last2, *first1, comp);
+			if (first2 != last2 && !comp(*first1, *first2))
+				++first2;
+			else
+			{
+				*d_first = *first1;
+				++d_first;
+			}
+		}
+	}
+	else
+	{
+		for (; first1 != last1 && first2 != last2; ++first2)
+		{
+			RandomIt1	place = gallop_(first1, last1, *first2, comp);
+
+			d_first = ft::copy(first1, place, d_first);
+			first1 = (place != last1 && !comp(*first2, *place)) ? place + 1 : place;
+		}
+	}
+	return (ft::copy(first1, last1, d_first));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	merge_intersection_( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+									OutputIt d_first, Compare comp, ft::false_type )
+{
+	while (first1 != last1 && first2 != last2)
+	{
+		if (comp(*first1, *first2))
+			++first1;
+		else
+		{
+			if (!comp(*first2, *first1))
+			{
+				*d_first = *first1;
+				++d_first;
+				++first1;
+			}
+			++first2;
+		}
+	}
+	return (d_first);
+}
+
+# if defined(__SSE2__)
+template< class It1, class It2, class OutputIt, class Compare >
+OutputIt	merge_intersection_( It1 first1, It1 last1, It2 first2, It2 last2,
+									OutputIt d_first, Compare comp, ft::true_type )
+{
+	typedef typename contiguous_iterator_<It1>::value_type	T;
+	const T*			a = contiguous_iterator_<It1>::base(first1);
+	const T*			b = contiguous_iterator_<It2>::base(first2);
+	const std::size_t	n1 = last1 - first1;
+	const std::size_t	n2 = last2 - first2;
+	std::size_t			i = 0;
+	std::size_t			j = 0;
+
+	// 5 keys of each side are read: the 5th tells whether the 4th is repeated in the next block
+	while (i + 5 <= n1 && j + 5 <= n2)
+	{
+		const __m128i	va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+		const __m128i	vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+		const __m128i	dup_a = _mm_cmpeq_epi32(va, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 1)));
+		const __m128i	dup_b = _mm_cmpeq_epi32(vb, _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j + 1)));
+
+		if (_mm_movemask_epi8(_mm_or_si128(dup_a, dup_b)) != 0)
+		{	// a key is repeated: merge these blocks one key at a time
+			const std::size_t	i_end = i + 4;
+			const std::size_t	j_end = j + 4;
+
+			while (i < i_end && j < j_end)
+			{
+				if (a[i] < b[j])
+					++i;
+				else
+				{
+					if (!(b[j] < a[i]))
+					{
+						*d_first = a[i++];
+						++d_first;
+					}
+					++j;
+				}
+			}
+			continue ;
+		}
+
+		__m128i		match = _mm_cmpeq_epi32(va, vb);
+
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+		match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+		for (unsigned mask = _mm_movemask_ps(_mm_castsi128_ps(match)); mask != 0; mask &= mask - 1)
+		{
+			*d_first = a[i + __builtin_ctz(mask)];
+			++d_first;
+		}
+
+		const T		a_max = a[i + 3];
+		const T		b_max = b[j + 3];
+
+		if (!(b_max < a_max))
+			i += 4;
+		if (!(a_max < b_max))
+			j += 4;
+	}
+	return (merge_intersection_(a + i, a + n1, b + j, b + n2, d_first, comp, ft::false_type()));
+}
+# endif
+
+// the SSE2 kernel applies: contiguous ranges of one 32 bits integral type, in the default order
+template< class It1, class It2, class Compare >
+struct	simd_intersectable_ : public ft::false_type {};
+
+template< class T >
+struct	key_32_ : public ft::integral_constant<bool, sizeof(T) == 4> {};
+
+template<>
+struct	key_32_<void> : public ft::false_type {};	// not a contiguous iterator
+
+# if defined(__SSE2__)
+template< class It1, class It2 >
+struct	simd_intersectable_<It1, It2, less_>
+: public ft::integral_constant<bool, bitwise_comparable_<It1, It2>::value
+										&& key_32_<typename contiguous_iterator_<It1>::value_type>::value> {};
+# endif
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_intersection_( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+								OutputIt d_first, Compare comp, ft::input_iterator_tag, ft::input_iterator_tag )
+{ return (merge_intersection_(first1, last1, first2, last2, d_first, comp, ft::false_type())); }
+
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	set_intersection_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+								OutputIt d_first, Compare comp, ft::random_access_iterator_tag, ft::random_access_iterator_tag )
+{
+	const typename ft::iterator_traits<RandomIt1>::difference_type	n1 = last1 - first1;
+	const typename ft::iterator_traits<RandomIt2>::difference_type	n2 = last2 - first2;
+
+	if (n1 * set_gallop_ratio_ < n2 || n2 * set_gallop_ratio_ < n1)
+		return (gallop_intersection_(first1, last1, first2, last2, d_first, comp));
+	return (merge_intersection_(first1, last1, first2, last2, d_first, comp,
+								simd_intersectable_<RandomIt1, RandomIt2, Compare>()));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_union_( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+						OutputIt d_first, Compare comp, ft::input_iterator_tag, ft::input_iterator_tag )
+{
+	for (; first1 != last1; ++d_first)
+	{
+		if (first2 == last2)
+			return (ft::copy(first1, last1, d_first));
+		if (comp(*first2, *first1))
+			*d_first = *first2++;
+		else
+		{
+			*d_first = *first1;
+			if (!comp(*first1, *first2))
+				++first2;
+			++first1;
+		}
+	}
+	return (ft::copy(first2, last2, d_first));
+}
+
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	set_union_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+						OutputIt d_first, Compare comp, ft::random_access_iterator_tag, ft::random_access_iterator_tag )
+{
+	const typename ft::iterator_traits<RandomIt1>::difference_type	n1 = last1 - first1;
+	const typename ft::iterator_traits<RandomIt2>::difference_type	n2 = last2 - first2;
+
+	if (n1 * set_gallop_ratio_ < n2 || n2 * set_gallop_ratio_ < n1)
+		return (gallop_union_(first1, last1, first2, last2, d_first, comp));
+	return (set_union_(first1, last1, first2, last2, d_first, comp, ft::input_iterator_tag(), ft::input_iterator_tag()));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_difference_( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+								OutputIt d_first, Compare comp, ft::input_iterator_tag, ft::input_iterator_tag )
+{
+	while (first1 != last1)
+	{
+		if (first2 == last2)
+			return (ft::copy(first1, last1, d_first));
+		if (comp(*first1, *first2))
+		{
+			*d_first = *first1++;
+			++d_first;
+		}
+		else
+		{
+			if (!comp(*first2, *first1))
+				++first1;
+			++first2;
+		}
+	}
+	return (d_first);
+}
+
+template< class RandomIt1, class RandomIt2, class OutputIt, class Compare >
+OutputIt	set_difference_( RandomIt1 first1, RandomIt1 last1, RandomIt2 first2, RandomIt2 last2,
+								OutputIt d_first, Compare comp, ft::random_access_iterator_tag, ft::random_access_iterator_tag )
+{
+	const typename ft::iterator_traits<RandomIt1>::difference_type	n1 = last1 - first1;
+	const typename ft::iterator_traits<RandomIt2>::difference_type	n2 = last2 - first2;
+
+	if (n1 * set_gallop_ratio_ < n2 || n2 * set_gallop_ratio_ < n1)
+		return (gallop_difference_(first1, last1, first2, last2, d_first, comp));
+	return (set_difference_(first1, last1, first2, last2, d_first, comp, ft::input_iterator_tag(), ft::input_iterator_tag()));
+}
+
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_intersection( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+								OutputIt d_first, Compare comp )
+{
+	return (ft::set_intersection_(first1, last1, first2, last2, d_first, comp,
+									ft::iterator_category(first1), ft::iterator_category(first2)));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt >
+OutputIt	set_intersection( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first )
+{ return (ft::set_intersection(first1, last1, first2, last2, d_first, less_())); }
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_union( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+						OutputIt d_first, Compare comp )
+{
+	return (ft::set_union_(first1, last1, first2, last2, d_first, comp,
+							ft::iterator_category(first1), ft::iterator_category(first2)));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt >
+OutputIt	set_union( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first )
+{ return (ft::set_union(first1, last1, first2, last2, d_first, less_())); }
+
+template< class InputIt1, class InputIt2, class OutputIt, class Compare >
+OutputIt	set_difference( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2,
+							OutputIt d_first, Compare comp )
+{
+	return (ft::set_difference_(first1, last1, first2, last2, d_first, comp,
+								ft::iterator_category(first1), ft::iterator_category(first2)));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt >
+OutputIt	set_difference( InputIt1 first1, InputIt1 last1, InputIt2 first2, InputIt2 last2, OutputIt d_first )
+{ return (ft::set_difference(first1, last1, first2, last2, d_first, less_())); }
+
+
+/*
+	sum / minmax / count / find: contiguous ranges of int, long (64 bits), float and double
+	go through explicit vector kernels, SSE2 (every x86_64 cpu) or AVX2 when the cpu has it
+	(checked at run time, as for mismatch_bytes_). anything else takes the scalar loop.
+	- sum keeps one partial sum per lane (two vectors of them, so the adds do not wait on
+	  each other) and adds the lanes at the end: integers wrap as unsigned arithmetic
+	  would, and a float sum is reassociated, so it may differ from the scalar loop in the
+	  last bits.
+	- minmax returns the smallest and the largest element of a range which is not empty.
+	  with a NaN in the range, the result is unspecified.
+	- count and find compare with ==, as the scalar loop does (NaN matches nothing, 0.0
+	  matches -0.0). an integral value is converted to the element type first; if it does
+	  not survive the round trip, no element can be equal to it.
+*/
+
+enum { count_flush_ = 1 << 30 };	// elements counted before the lane counters are summed
+
+// a + b, wrapping instead of overflowing for the integral types
+template< class T >
+T	wrapping_add_( T a, T b )
+{ return (a + b); }
+
+inline int	wrapping_add_( int a, int b )
+{ return (static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b))); }
+
+inline long	wrapping_add_( long a, long b )
+{ return (static_cast<long>(static_cast<unsigned long>(a) + static_cast<unsigned long>(b))); }
+
+template< class InputIt >
+typename ft::iterator_traits<InputIt>::value_type	sum_( InputIt first, InputIt last, ft::false_type )
+{
+	typename ft::iterator_traits<InputIt>::value_type	total = typename ft::iterator_traits<InputIt>::value_type();
+
+	for (; first != last; ++first)
+		total = wrapping_add_(total, *first);
+	return (total);
+}
+
+template< class ForwardIt >
+ft::pair<typename ft::iterator_traits<ForwardIt>::value_type, typename ft::iterator_traits<ForwardIt>::value_type>
+	minmax_( ForwardIt first, ForwardIt last, ft::false_type )
+{
+	typename ft::iterator_traits<ForwardIt>::value_type	lo = *first;
+	typename ft::iterator_traits<ForwardIt>::value_type	hi = *first;
+
+	while (++first != last)
+	{
+		if (*first < lo)
+			lo = *first;
+		if (hi < *first)
+			hi = *first;
+	}
+	return (ft::make_pair(lo, hi));
+}
+
+template< class InputIt, class T >
+typename ft::iterator_traits<InputIt>::difference_type	count_( InputIt first, InputIt last, const T& value, ft::false_type )
+{
+	typename ft::iterator_traits<InputIt>::difference_type	found = 0;
+
+	for (; first != last; ++first)
+		if (*first == value)
+			++found;
+	return (found);
+}
+
+template< class InputIt, class T >
+InputIt		find_( InputIt first, InputIt last, const T& value, ft::false_type )
+{
+	while (first != last && !(*first == value))
+		++first;
+	return (first);
+}
+
+// element types with kernels
+template< class T >
+struct	simd_arithmetic_ : public ft::false_type {};
+
+# if defined(__SSE2__)
+template<>
+struct	simd_arithmetic_<int> : public ft::true_type {};
+
+template<>
+struct	simd_arithmetic_<long> : public ft::integral_constant<bool, sizeof(long) == 8> {};
+
+template<>
+struct	simd_arithmetic_<float> : public ft::true_type {};
+
+template<>
+struct	simd_arithmetic_<double> : public ft::true_type {};
+# endif
+
+template< class It >
+struct	simd_range_ : public simd_arithmetic_<typename contiguous_iterator_<It>::value_type> {};
+
+// a value of type T can be searched among elements of type V as a V
+template< class V, class T >
+struct	simd_key_
+: public ft::integral_constant<bool, ft::is_same<V, typename ft::remove_cv<T>::type>::value
+										|| (ft::is_integral<V>::value && ft::is_integral<T>::value)> {};
+
+# if defined(__SSE2__)
+// one vector of each element type: load / store / add / min / max, the lane mask of
+// a == b (eq_mask), and lane counters which count the equal lanes (count / total)
+template< class T >
+struct	sse2_ops_;
+
+template<>
+struct	sse2_ops_<int>
+{
+	typedef int		value_type;
+	typedef __m128i	vec;
+	typedef __m128i	counter;
+	enum { width = 4 };
+
+	static vec		load( const int* p )		{ return (_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+	static void		store( int* p, vec v )		{ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	static vec		set1( int x )				{ return (_mm_set1_epi32(x)); }
+	static vec		zero()						{ return (_mm_setzero_si128()); }
+	static vec		add( vec a, vec b )			{ return (_mm_add_epi32(a, b)); }
+	static vec		min( vec a, vec b )
+	{
+		const __m128i	gt = _mm_cmpgt_epi32(a, b);
+
+		return (_mm_or_si128(_mm_and_si128(gt, b), _mm_andnot_si128(gt, a)));
+	}
+	static vec		max( vec a, vec b )
+	{
+		const __m128i	gt = _mm_cmpgt_epi32(a, b);
+
+		return (_mm_or_si128(_mm_and_si128(gt, a), _mm_andnot_si128(gt, b)));
+	}
+	static unsigned	eq_mask( vec a, vec b )		{ return (_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)))); }
+	static counter	no_count()					{ return (_mm_setzero_si128()); }
+	static counter	count( counter c, vec a, vec b )	{ return (_mm_sub_epi32(c, _mm_cmpeq_epi32(a, b))); }
+	static std::size_t	total( counter c )
+	{
+		unsigned	lanes[4];
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), c);
+		return (std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3]);
+	}
+};
+
+// SSE2 has no 64 bits compare: it is built from the 32 bits halves
+template<>
+struct	sse2_ops_<long>
+{
+	typedef long	value_type;
+	typedef __m128i	vec;
+	typedef __m128i	counter;
+	enum { width = 2 };
+
+	static vec		load( const long* p )		{ return (_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+	static void		store( long* p, vec v )		{ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+	static vec		set1( long x )				{ return (_mm_set1_epi64x(x)); }
+	static vec		zero()						{ return (_mm_setzero_si128()); }
+	static vec		add( vec a, vec b )			{ return (_mm_add_epi64(a, b)); }
+	static vec		eq( vec a, vec b )
+	{
+		const __m128i	eq32 = _mm_cmpeq_epi32(a, b);
+
+		return (_mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+	// a > b: the high halves compare signed, the low halves unsigned (their sign bit flipped)
+	static vec		gt( vec a, vec b )
+	{
+		const __m128i	flip = _mm_set_epi32(0, INT_MIN, 0, INT_MIN);
+		const __m128i	gt32 = _mm_cmpgt_epi32(_mm_xor_si128(a, flip), _mm_xor_si128(b, flip));
+		const __m128i	eq32 = _mm_cmpeq_epi32(a, b);
+		const __m128i	gt_high = _mm_shuffle_epi32(gt32, _MM_SHUFFLE(3, 3, 1, 1));
+		const __m128i	gt_low = _mm_shuffle_epi32(gt32, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128i	eq_high = _mm_shuffle_epi32(eq32, _MM_SHUFFLE(3, 3, 1, 1));
+
+		return (_mm_or_si128(gt_high, _mm_and_si128(eq_high, gt_low)));
+	}
+	static vec		min( vec a, vec b )
+	{
+		const __m128i	a_gt = gt(a, b);
+
+		return (_mm_or_si128(_mm_and_si128(a_gt, b), _mm_andnot_si128(a_gt, a)));
+	}
+	static vec		max( vec a, vec b )
+	{
+		const __m128i	a_gt = gt(a, b);
+
+		return (_mm_or_si128(_mm_and_si128(a_gt, a), _mm_andnot_si128(a_gt, b)));
+	}
+	static unsigned	eq_mask( vec a, vec b )		{ return (_mm_movemask_pd(_mm_castsi128_pd(eq(a, b)))); }
+	static counter	no_count()					{ return (_mm_setzero_si128()); }
+	static counter	count( counter c, vec a, vec b )	{ return (_mm_sub_epi64(c, eq(a, b))); }
+	static std::size_t	total( counter c )
+	{
+		unsigned long	lanes[2];
+
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), c);
+		return (lanes[0] + lanes[1]);
+	}
+};
+
+template<>
+struct	sse2_ops_<float>
+{
+	typedef float	value_type;
+	typedef __m128	vec;
+	typedef __m128i	counter;
+	enum { width = 4 };
+
+	static vec		load( const float* p )		{ return (_mm_loadu_ps(p)); }
+	static void		store( float* p, vec v )	{ _mm_storeu_ps(p, v); }
+	static vec		set1( float x )				{ return (_mm_set1_ps(x)); }
+	static vec		zero()						{ return (_mm_setzero_ps()); }
+	static vec		add( vec a, vec b )			{ return (_mm_add_ps(a, b)); }
+	static vec		min( vec a, vec b )			{ return (_mm_min_ps(a, b)); }
+	static vec		max( vec a, vec b )			{ return (_mm_max_ps(a, b)); }
+	static unsigned	eq_mask( vec a, vec b )		{ return (_mm_movemask_ps(_mm_cmpeq_ps(a, b))); }
+	static counter	no_count()					{ return (_mm_setzero_si128()); }
+	static counter	count( counter c, vec a, vec b )	{ return (_mm_sub_epi32(c, _mm_castps_si128(_mm_cmpeq_ps(a, b)))); }
+	static std::size_t	total( counter c )		{ return (sse2_ops_<int>::total(c)); }
+};
+
+template<>
+struct	sse2_ops_<double>
+{
+	typedef double	value_type;
+	typedef __m128d	vec;
+	typedef __m128i	counter;
+	enum { width = 2 };
+
+	static vec		load( const double* p )		{ return (_mm_loadu_pd(p)); }
+	static void		store( double* p, vec v )	{ _mm_storeu_pd(p, v); }
+	static vec		set1( double x )			{ return (_mm_set1_pd(x)); }
+	static vec		zero()						{ return (_mm_setzero_pd()); }
+	static vec		add( vec a, vec b )			{ return (_mm_add_pd(a, b)); }
+	static vec		min( vec a, vec b )			{ return (_mm_min_pd(a, b)); }
+	static vec		max( vec a, vec b )			{ return (_mm_max_pd(a, b)); }
+	static unsigned	eq_mask( vec a, vec b )		{ return (_mm_movemask_pd(_mm_cmpeq_pd(a, b))); }
+	static counter	no_count()					{ return (_mm_setzero_si128()); }
+	static counter	count( counter c, vec a, vec b )	{ return (_mm_sub_epi64(c, _mm_castpd_si128(_mm_cmpeq_pd(a, b)))); }
+	static std::size_t	total( counter c )		{ return (sse2_ops_<long>::total(c)); }
+};
+
+// the lanes of v, added or min / max'ed together, then the tail p[i, n)
+template< class Ops >
+typename Ops::value_type	sum_lanes_( typename Ops::value_type* lanes, const typename Ops::value_type* p,
+										std::size_t i, std::size_t n )
+{
+	typename Ops::value_type	total = lanes[0];
+
+	for (int k = 1; k < Ops::width; ++k)
+		total = wrapping_add_(total, lanes[k]);
+	for (; i < n; ++i)
+		total = wrapping_add_(total, p[i]);
+	return (total);
+}
+
+template< class Ops >
+ft::pair<typename Ops::value_type, typename Ops::value_type>
+	minmax_lanes_( const typename Ops::value_type* lo, const typename Ops::value_type* hi )
+{
+	ft::pair<typename Ops::value_type, typename Ops::value_type>	range = minmax_(lo, lo + Ops::width, ft::false_type());
+
+	range.second = minmax_(hi, hi + Ops::width, ft::false_type()).second;
+	return (range);
+}
+
+template< class Ops >
+typename Ops::value_type	sum_sse2_( const typename Ops::value_type* p, std::size_t n )
+{
+	typename Ops::vec			acc0 = Ops::zero();
+	typename Ops::vec			acc1 = Ops::zero();
+	typename Ops::value_type	lanes[Ops::width];
+	std::size_t					i = 0;
+
+	for (; i + 2 * Ops::width <= n; i += 2 * Ops::width)
+	{
+		acc0 = Ops::add(acc0, Ops::load(p + i));
+		acc1 = Ops::add(acc1, Ops::load(p + i + Ops::width));
+	}
+	if (i + Ops::width <= n)
+	{
+		acc0 = Ops::add(acc0, Ops::load(p + i));
+		i += Ops::width;
+	}
+	Ops::store(lanes, Ops::add(acc0, acc1));
+	return (sum_lanes_<Ops>(lanes, p, i, n));
+}
+
+// the last block overlaps the one before it rather than leaving a scalar tail
+template< class Ops >
+ft::pair<typename Ops::value_type, typename Ops::value_type>	minmax_sse2_( const typename Ops::value_type* p, std::size_t n )
+{
+	if (n < std::size_t(Ops::width))
+		return (minmax_(p, p + n, ft::false_type()));
+
+	typename Ops::vec			lo = Ops::load(p);
+	typename Ops::vec			hi = lo;
+	typename Ops::value_type	lo_lanes[Ops::width];
+	typename Ops::value_type	hi_lanes[Ops::width];
+
+	for (std::size_t i = Ops::width; i < n; i += Ops::width)
+	{
+		const typename Ops::vec	v = Ops::load(p + (i + Ops::width <= n ? i : n - Ops::width));
+
+		lo = Ops::min(lo, v);
+		hi = Ops::max(hi, v);
+	}
+	Ops::store(lo_lanes, lo);
+	Ops::store(hi_lanes, hi);
+	return (minmax_lanes_<Ops>(lo_lanes, hi_lanes));
+}
+
+template< class Ops >
+std::size_t	count_sse2_( const typename Ops::value_type* p, std::size_t n, typename Ops::value_type value )
+{
+	const typename Ops::vec	key = Ops::set1(value);
+	std::size_t				i = 0;
+	std::size_t				found = 0;
+
+	while (i + Ops::width <= n)
+	{
+		typename Ops::counter	c = Ops::no_count();
+		std::size_t				stop = n - (n - i) % Ops::width;
+
+		if (stop - i > std::size_t(count_flush_))
+			stop = i + count_flush_;
+		for (; i < stop; i += Ops::width)
+			c = Ops::count(c, Ops::load(p + i), key);
+		found += Ops::total(c);
+	}
+	return (found + count_(p + i, p + n, value, ft::false_type()));
+}
+
+template< class Ops >
+std::size_t	find_sse2_( const typename Ops::value_type* p, std::size_t n, typename Ops::value_type value )
+{
+	const typename Ops::vec	key = Ops::set1(value);
+	std::size_t				i = 0;
+
+	for (; i + 2 * Ops::width <= n; i += 2 * Ops::width)
+	{
+		const unsigned	mask = Ops::eq_mask(Ops::load(p + i), key)
+								| (Ops::eq_mask(Ops::load(p + i + Ops::width), key) << Ops::width);
+
+		if (mask != 0)
+			return (i + __builtin_ctz(mask));
+	}
+	return (find_(p + i, p + n, value, ft::false_type()) - p);
+}
+# endif
+
+# if defined(__SSE2__) && defined(FT_ALGORITHM_X86_DISPATCH_)
+// the same operations on 256 bits vectors
+template< class T >
+struct	avx2_ops_;
+
+template<>
+struct	avx2_ops_<int>
+{
+	typedef int		value_type;
+	typedef __m256i	vec;
+	typedef __m256i	counter;
+	enum { width = 8 };
+
+	__attribute__((target("avx2"))) static vec		load( const int* p )	{ return (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+	__attribute__((target("avx2"))) static void		store( int* p, vec v )	{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	__attribute__((target("avx2"))) static vec		set1( int x )			{ return (_mm256_set1_epi32(x)); }
+	__attribute__((target("avx2"))) static vec		zero()					{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static vec		add( vec a, vec b )		{ return (_mm256_add_epi32(a, b)); }
+	__attribute__((target("avx2"))) static vec		min( vec a, vec b )		{ return (_mm256_min_epi32(a, b)); }
+	__attribute__((target("avx2"))) static vec		max( vec a, vec b )		{ return (_mm256_max_epi32(a, b)); }
+	__attribute__((target("avx2"))) static unsigned	eq_mask( vec a, vec b )
+	{ return (_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)))); }
+	__attribute__((target("avx2"))) static counter	no_count()				{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static counter	count( counter c, vec a, vec b )
+	{ return (_mm256_sub_epi32(c, _mm256_cmpeq_epi32(a, b))); }
+	__attribute__((target("avx2"))) static std::size_t	total( counter c )
+	{
+		unsigned	lanes[8];
+		std::size_t	found = 0;
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), c);
+		for (int k = 0; k < 8; ++k)
+			found += lanes[k];
+		return (found);
+	}
+};
+
+template<>
+struct	avx2_ops_<long>
+{
+	typedef long	value_type;
+	typedef __m256i	vec;
+	typedef __m256i	counter;
+	enum { width = 4 };
+
+	__attribute__((target("avx2"))) static vec		load( const long* p )	{ return (_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+	__attribute__((target("avx2"))) static void		store( long* p, vec v )	{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+	__attribute__((target("avx2"))) static vec		set1( long x )			{ return (_mm256_set1_epi64x(x)); }
+	__attribute__((target("avx2"))) static vec		zero()					{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static vec		add( vec a, vec b )		{ return (_mm256_add_epi64(a, b)); }
+	__attribute__((target("avx2"))) static vec		min( vec a, vec b )
+	{ return (_mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b))); }
+	__attribute__((target("avx2"))) static vec		max( vec a, vec b )
+	{ return (_mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b))); }
+	__attribute__((target("avx2"))) static unsigned	eq_mask( vec a, vec b )
+	{ return (_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(a, b)))); }
+	__attribute__((target("avx2"))) static counter	no_count()				{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static counter	count( counter c, vec a, vec b )
+	{ return (_mm256_sub_epi64(c, _mm256_cmpeq_epi64(a, b))); }
+	__attribute__((target("avx2"))) static std::size_t	total( counter c )
+	{
+		unsigned long	lanes[4];
+
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), c);
+		return (lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+	}
+};
+
+template<>
+struct	avx2_ops_<float>
+{
+	typedef float	value_type;
+	typedef __m256	vec;
+	typedef __m256i	counter;
+	enum { width = 8 };
+
+	__attribute__((target("avx2"))) static vec		load( const float* p )		{ return (_mm256_loadu_ps(p)); }
+	__attribute__((target("avx2"))) static void		store( float* p, vec v )	{ _mm256_storeu_ps(p, v); }
+	__attribute__((target("avx2"))) static vec		set1( float x )				{ return (_mm256_set1_ps(x)); }
+	__attribute__((target("avx2"))) static vec		zero()						{ return (_mm256_setzero_ps()); }
+	__attribute__((target("avx2"))) static vec		add( vec a, vec b )			{ return (_mm256_add_ps(a, b)); }
+	__attribute__((target("avx2"))) static vec		min( vec a, vec b )			{ return (_mm256_min_ps(a, b)); }
+	__attribute__((target("avx2"))) static vec		max( vec a, vec b )			{ return (_mm256_max_ps(a, b)); }
+	__attribute__((target("avx2"))) static unsigned	eq_mask( vec a, vec b )
+	{ return (_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))); }
+	__attribute__((target("avx2"))) static counter	no_count()					{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static counter	count( counter c, vec a, vec b )
+	{ return (_mm256_sub_epi32(c, _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)))); }
+	__attribute__((target("avx2"))) static std::size_t	total( counter c )		{ return (avx2_ops_<int>::total(c)); }
+};
+
+template<>
+struct	avx2_ops_<double>
+{
+	typedef double	value_type;
+	typedef __m256d	vec;
+	typedef __m256i	counter;
+	enum { width = 4 };
+
+	__attribute__((target("avx2"))) static vec		load( const double* p )		{ return (_mm256_loadu_pd(p)); }
+	__attribute__((target("avx2"))) static void		store( double* p, vec v )	{ _mm256_storeu_pd(p, v); }
+	__attribute__((target("avx2"))) static vec		set1( double x )			{ return (_mm256_set1_pd(x)); }
+	__attribute__((target("avx2"))) static vec		zero()						{ return (_mm256_setzero_pd()); }
+	__attribute__((target("avx2"))) static vec		add( vec a, vec b )			{ return (_mm256_add_pd(a, b)); }
+	__attribute__((target("avx2"))) static vec		min( vec a, vec b )			{ return (_mm256_min_pd(a, b)); }
+	__attribute__((target("avx2"))) static vec		max( vec a, vec b )			{ return (_mm256_max_pd(a, b)); }
+	__attribute__((target("avx2"))) static unsigned	eq_mask( vec a, vec b )
+	{ return (_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))); }
+	__attribute__((target("avx2"))) static counter	no_count()					{ return (_mm256_setzero_si256()); }
+	__attribute__((target("avx2"))) static counter	count( counter c, vec a, vec b )
+	{ return (_mm256_sub_epi64(c, _mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ)))); }
+	__attribute__((target("avx2"))) static std::size_t	total( counter c )		{ return (avx2_ops_<long>::total(c)); }
+};
+
+// the SSE2 kernels, compiled for AVX2 (a function can only inline intrinsics of its own target)
+template< class Ops >
+__attribute__((target("avx2")))
+typename Ops::value_type	sum_avx2_( const typename Ops::value_type* p, std::size_t n )
+{
+	typename Ops::vec			acc0 = Ops::zero();
+	typename Ops::vec			acc1 = Ops::zero();
+	typename Ops::value_type	lanes[Ops::width];
+	std::size_t					i = 0;
+
+	for (; i + 2 * Ops::width <= n; i += 2 * Ops::width)
+	{
+		acc0 = Ops::add(acc0, Ops::load(p + i));
+		acc1 = Ops::add(acc1, Ops::load(p + i + Ops::width));
+	}
+	if (i + Ops::width <= n)
+	{
+		acc0 = Ops::add(acc0, Ops::load(p + i));
+		i += Ops::width;
+	}
+	Ops::store(lanes, Ops::add(acc0, acc1));
+	return (sum_lanes_<Ops>(lanes, p, i, n));
+}
+
+template< class Ops >
+__attribute__((target("avx2")))
+ft::pair<typename Ops::value_type, typename Ops::value_type>	minmax_avx2_( const typename Ops::value_type* p, std::size_t n )
+{
+	if (n < std::size_t(Ops::width))
+		return (minmax_(p, p + n, ft::false_type()));
+
+	typename Ops::vec			lo = Ops::load(p);
+	typename Ops::vec			hi = lo;
+	typename Ops::value_type	lo_lanes[Ops::width];
+	typename Ops::value_type	hi_lanes[Ops::width];
+
+	for (std::size_t i = Ops::width; i < n; i += Ops::width)
+	{
+		const typename Ops::vec	v = Ops::load(p + (i + Ops::width <= n ? i : n - Ops::width));
+
+		lo = Ops::min(lo, v);
+		hi = Ops::max(hi, v);
+	}
+	Ops::store(lo_lanes, lo);
+	Ops::store(hi_lanes, hi);
+	return (minmax_lanes_<Ops>(lo_lanes, hi_lanes));
+}
+
+template< class Ops >
+__attribute__((target("avx2")))
+std::size_t	count_avx2_( const typename Ops::value_type* p, std::size_t n, typename Ops::value_type value )
+{
+	const typename Ops::vec	key = Ops::set1(value);
+	std::size_t				i = 0;
+	std::size_t				found = 0;
+
+	while (i + Ops::width <= n)
+	{
+		typename Ops::counter	c = Ops::no_count();
+		std::size_t				stop = n - (n - i) % Ops::width;
+
+		if (stop - i > std::size_t(count_flush_))
+			stop = i + count_flush_;
+		for (; i < stop; i += Ops::width)
+			c = Ops::count(c, Ops::load(p + i), key);
+		found += Ops::total(c);
+	}
+	return (found + count_(p + i, p + n, value, ft::false_type()));
+}
+
+template< class Ops >
+__attribute__((target("avx2")))
+std::size_t	find_avx2_( const typename Ops::value_type* p, std::size_t n, typename Ops::value_type value )
+{
+	const typename Ops::vec	key = Ops::set1(value);
+	std::size_t				i = 0;
+
+	for (; i + 2 * Ops::width <= n; i += 2 * Ops::width)
+	{
+		const unsigned	mask = Ops::eq_mask(Ops::load(p + i), key)
+								| (Ops::eq_mask(Ops::load(p + i + Ops::width), key) << Ops::width);
+
+		if (mask != 0)
+			return (i + __builtin_ctz(mask));
+	}
+	return (find_(p + i, p + n, value, ft::false_type()) - p);
+}
+# endif
+
+# if defined(__SSE2__)
+template< class T >
+T	simd_sum_( const T* p, std::size_t n )
+{
+#  ifdef FT_ALGORITHM_X86_DISPATCH_
+	if (__builtin_cpu_supports("avx2"))
+		return (sum_avx2_<avx2_ops_<T> >(p, n));
+#  endif
+	return (sum_sse2_<sse2_ops_<T> >(p, n));
+}
+
+template< class T >
+ft::pair<T, T>	simd_minmax_( const T* p, std::size_t n )
+{
+#  ifdef FT_ALGORITHM_X86_DISPATCH_
+	if (__builtin_cpu_supports("avx2"))
+		return (minmax_avx2_<avx2_ops_<T> >(p, n));
+#  endif
+	return (minmax_sse2_<sse2_ops_<T> >(p, n));
+}
+
+template< class T >
+std::size_t	simd_count_( const T* p, std::size_t n, T value )
+{
+#  ifdef FT_ALGORITHM_X86_DISPATCH_
+	if (__builtin_cpu_supports("avx2"))
+		return (count_avx2_<avx2_ops_<T> >(p, n, value));
+#  endif
+	return (count_sse2_<sse2_ops_<T> >(p, n, value));
+}
+
+template< class T >
+std::size_t	simd_find_( const T* p, std::size_t n, T value )
+{
+#  ifdef FT_ALGORITHM_X86_DISPATCH_
+	if (__builtin_cpu_supports("avx2"))
+		return (find_avx2_<avx2_ops_<T> >(p, n, value));
+#  endif
+	return (find_sse2_<sse2_ops_<T> >(p, n, value));
+}
+
+template< class It >
+typename ft::iterator_traits<It>::value_type	sum_( It first, It last, ft::true_type )
+{ return (simd_sum_(contiguous_iterator_<It>::base(first), last - first)); }
+
+template< class It >
+ft::pair<typename ft::iterator_traits<It>::value_type, typename ft::iterator_traits<It>::value_type>
+	minmax_( It first, It last, ft::true_type )
+{ return (simd_minmax_(contiguous_iterator_<It>::base(first), last - first)); }
+
+template< class It, class T >
+typename ft::iterator_traits<It>::difference_type	count_( It first, It last, const T& value, ft::true_type )
+{
+	typedef typename contiguous_iterator_<It>::value_type	V;
+	const V		key = static_cast<V>(value);
+
+	if (!(static_cast<T>(key) == value))
+		return (0);
+	return (simd_count_(contiguous_iterator_<It>::base(first), last - first, key));
+}
+
+template< class It, class T >
+It	find_( It first, It last, const T& value, ft::true_type )
+{
+	typedef typename contiguous_iterator_<It>::value_type	V;
+	const V		key = static_cast<V>(value);
+
+	if (!(static_cast<T>(key) == value))
+		return (last);
+	return (first + simd_find_(contiguous_iterator_<It>::base(first), last - first, key));
+}
+# endif
+
+
+template< class InputIt >
+typename ft::iterator_traits<InputIt>::value_type	sum( InputIt first, InputIt last )
+{ return (ft::sum_(first, last, simd_range_<InputIt>())); }
+
+template< class ForwardIt >
+ft::pair<typename ft::iterator_traits<ForwardIt>::value_type, typename ft::iterator_traits<ForwardIt>::value_type>
+	minmax( ForwardIt first, ForwardIt last )
+{ return (ft::minmax_(first, last, simd_range_<ForwardIt>())); }
+
+template< class InputIt, class T >
+typename ft::iterator_traits<InputIt>::difference_type	count( InputIt first, InputIt last, const T& value )
+{
+	return (ft::count_(first, last, value,
+						ft::integral_constant<bool, simd_range_<InputIt>::value
+													&& simd_key_<typename contiguous_iterator_<InputIt>::value_type, T>::value>()));
+}
+
+template< class InputIt, class T >
+InputIt		find( InputIt first, InputIt last, const T& value )
+{
+	return (ft::find_(first, last, value,
+						ft::integral_constant<bool, simd_range_<InputIt>::value
+													&& simd_key_<typename contiguous_iterator_<InputIt>::value_type, T>::value>()));
+}
+
+
 }	// namespace ft
 
 #endif
@@ -0,0 +1,671 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   execution.hpp                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Execution policies:	https://en.cppreference.com/w/cpp/algorithm/execution_policy_tag_t
+//
+//	ft::execution::seq runs the algorithm of algorithm.hpp, ft::execution::par splits the range into
+//	chunks (about 4 per thread, of at least 4096 elements) and runs them on a thread_pool:
+//	thread_pool::instance() by default, or another one with par.on(pool).
+//	the parallel overloads need random access iterators (for_each, transform and equal for every range),
+//	the functions passed to them are called from several threads at once, and must not throw (thread_pool.hpp).
+//	parallel_for_each and parallel_reduce walk a range of an ordered container (ft::map, ft::set...).
+
+#ifndef EXECUTION_HPP
+# define EXECUTION_HPP
+
+# include <functional>
+# include <memory>
+
+# include "../containers/vector.hpp"
+# include "algorithm.hpp"
+# include "iterator.hpp"
+# include "rb_tree.hpp"
+# include "thread_pool.hpp"
+
+namespace ft {
+
+namespace execution {
+
+
+class	sequenced_policy
+{
+
+};
+
+class	parallel_policy
+{
+	public:
+		parallel_policy()
+		: pool_(NULL)
+		{
+
+		}
+
+		// the same policy on another pool
+		parallel_policy	on( ft::thread_pool& pool ) const
+		{
+			parallel_policy	policy;
+
+			policy.pool_ = &pool;
+			return (policy);
+		}
+
+		ft::thread_pool&	pool() const
+		{ return (pool_ != NULL ? *pool_ : ft::thread_pool::instance()); }
+
+	private:
+		ft::thread_pool*	pool_;
+};
+
+const sequenced_policy	seq = sequenced_policy();
+const parallel_policy	par = parallel_policy();
+
+
+}	// namespace execution
+
+
+enum
+{
+	parallel_chunks_per_thread_ = 4,
+	parallel_min_chunk_ = 4096
+};
+
+// [0, n) split into chunks of (nearly) the same size
+struct	parallel_chunks_
+{
+	parallel_chunks_( const execution::parallel_policy& policy, std::size_t size )
+	: n(size), count(1)
+	{
+		std::size_t		by_size = size / parallel_min_chunk_;
+		std::size_t		by_threads = policy.pool().concurrency() * parallel_chunks_per_thread_;
+
+		if (policy.pool().concurrency() > 1)
+			count = by_size < by_threads ? by_size : by_threads;
+		if (count == 0)
+			count = 1;
+	}
+
+	std::size_t	begin( std::size_t chunk ) const
+	{ return (chunk * n / count); }
+
+	std::size_t	end( std::size_t chunk ) const
+	{ return ((chunk + 1) * n / count); }
+
+	std::size_t		n;
+	std::size_t		count;
+};
+
+// one partial result per chunk, each its own T: not ft::vector<T>, which packs bools
+// into shared words that the chunks would read-modify-write at once
+template< class T >
+class	parallel_partials_
+{
+	public:
+		parallel_partials_( std::size_t count, const T& init )
+		: first_(alloc_.allocate(count)), count_(count)
+		{
+			try
+			{
+				ft::uninitialized_fill_n(first_, count, init);
+			}
+			catch (...)
+			{
+				alloc_.deallocate(first_, count);
+				throw ;
+			}
+		}
+
+		~parallel_partials_()
+		{
+			for (std::size_t i = 0; i < count_; ++i)
+				alloc_.destroy(first_ + i);
+			alloc_.deallocate(first_, count_);
+		}
+
+		T&	operator[]( std::size_t chunk )
+		{ return (first_[chunk]); }
+
+		T*	begin()
+		{ return (first_); }
+
+		T*	end()
+		{ return (first_ + count_); }
+
+		std::size_t	size() const
+		{ return (count_); }
+
+	private:
+		std::allocator<T>	alloc_;
+		T*					first_;
+		std::size_t			count_;
+
+		parallel_partials_( const parallel_partials_& );
+		parallel_partials_&	operator=( const parallel_partials_& );
+};
+
+// body(i) for every i in [0, count), on the pool of policy
+template< class Body >
+void	parallel_invoke_( void* body, std::size_t index )
+{ (*static_cast<Body*>(body))(index); }
+
+template< class Body >
+void	parallel_run_( const execution::parallel_policy& policy, std::size_t count, Body& body )
+{
+	if (count == 1)
+		body(0);
+	else
+		policy.pool().run(count, &parallel_invoke_<Body>, &body);
+}
+
+
+template< class RandomIt, class UnaryFunction >
+struct	for_each_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		UnaryFunction	fn(f);
+
+		for (RandomIt it = first + chunks.begin(chunk), end = first + chunks.end(chunk); it != end; ++it)
+			fn(*it);
+	}
+
+	parallel_chunks_	chunks;
+	RandomIt			first;
+	UnaryFunction		f;
+};
+
+template< class RandomIt1, class RandomIt2, class UnaryOperation >
+struct	transform_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		ft::transform(first + chunks.begin(chunk), first + chunks.end(chunk), d_first + chunks.begin(chunk), op);
+	}
+
+	parallel_chunks_	chunks;
+	RandomIt1			first;
+	RandomIt2			d_first;
+	UnaryOperation		op;
+};
+
+template< class RandomIt1, class RandomIt2, class RandomIt3, class BinaryOperation >
+struct	transform2_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		ft::transform(first1 + chunks.begin(chunk), first1 + chunks.end(chunk), first2 + chunks.begin(chunk),
+						d_first + chunks.begin(chunk), op);
+	}
+
+	parallel_chunks_	chunks;
+	RandomIt1			first1;
+	RandomIt2			first2;
+	RandomIt3			d_first;
+	BinaryOperation		op;
+};
+
+// every chunk is folded from its first element, then the partial results are folded in order
+template< class RandomIt, class T, class BinaryOp >
+struct	reduce_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		RandomIt	it = first + chunks.begin(chunk);
+		RandomIt	end = first + chunks.end(chunk);
+		T			acc = *it;
+
+		while (++it != end)
+			acc = op(acc, *it);
+		(*partials)[chunk] = acc;
+	}
+
+	parallel_chunks_		chunks;
+	RandomIt				first;
+	BinaryOp				op;
+	parallel_partials_<T>*	partials;
+};
+
+template< class RandomIt1, class RandomIt2 >
+struct	equal_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		if (__atomic_load_n(&mismatch, __ATOMIC_RELAXED))
+			return ;	// the answer is known already
+		if (!ft::equal(first1 + chunks.begin(chunk), first1 + chunks.end(chunk), first2 + chunks.begin(chunk)))
+			__atomic_store_n(&mismatch, 1, __ATOMIC_RELAXED);
+	}
+
+	parallel_chunks_	chunks;
+	RandomIt1			first1;
+	RandomIt2			first2;
+	int					mismatch;
+};
+
+
+/*
+	parallel sort: one chunk per thread is sorted by ft::sort (so radix sorted for integral keys),
+	then the sorted runs are merged by pairs, all the pairs of a round in parallel,
+	back and forth between the range and a buffer of the same size.
+*/
+
+template< class RandomIt, class Compare, bool Default >
+struct	sort_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		if (Default)
+			ft::sort(first + chunks.begin(chunk), first + chunks.end(chunk));
+		else
+			ft::sort(first + chunks.begin(chunk), first + chunks.end(chunk), comp);
+	}
+
+	parallel_chunks_	chunks;
+	RandomIt			first;
+	Compare				comp;
+};
+
+template< class SrcIt, class DstIt >
+struct	copy_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		DstIt	out = dst + chunks.begin(chunk);
+
+		for (SrcIt it = src + chunks.begin(chunk), end = src + chunks.end(chunk); it != end; ++it, ++out)
+			*out = *it;
+	}
+
+	parallel_chunks_	chunks;
+	SrcIt				src;
+	DstIt				dst;
+};
+
+// merge the runs [2 * width * i, + width) and [+ width, + 2 * width) of src into dst
+template< class SrcIt, class DstIt, class Compare >
+struct	merge_runs_
+{
+	void	operator()( std::size_t pair )
+	{
+		std::size_t		lo = pair * 2 * width;
+		std::size_t		mid = lo + width < chunks.count ? lo + width : chunks.count;
+		std::size_t		hi = lo + 2 * width < chunks.count ? lo + 2 * width : chunks.count;
+		SrcIt			left = src + chunks.begin(lo);
+		SrcIt			left_end = src + chunks.begin(mid);
+		SrcIt			right = left_end;
+		SrcIt			right_end = src + chunks.begin(hi);
+		DstIt			out = dst + chunks.begin(lo);
+
+		while (left != left_end && right != right_end)
+		{
+			if (comp(*right, *left))
+				*out++ = *right++;
+			else
+				*out++ = *left++;
+		}
+		for (; left != left_end; ++left, ++out)
+			*out = *left;
+		for (; right != right_end; ++right, ++out)
+			*out = *right;
+	}
+
+	parallel_chunks_	chunks;		// chunks.begin(chunks.count) is the end
+	SrcIt				src;
+	DstIt				dst;
+	Compare				comp;
+	std::size_t			width;
+};
+
+template< class SrcIt, class DstIt, class Compare >
+void	merge_round_( const execution::parallel_policy& policy, const parallel_chunks_& chunks,
+						SrcIt src, DstIt dst, Compare comp, std::size_t width )
+{
+	merge_runs_<SrcIt, DstIt, Compare>	body = { chunks, src, dst, comp, width };
+
+	parallel_run_(policy, (chunks.count + 2 * width - 1) / (2 * width), body);
+}
+
+template< class RandomIt, class Compare, bool Default >
+void	parallel_sort_( const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+
+	const std::size_t	n = last - first;
+	parallel_chunks_	chunks(policy, n);
+	std::size_t			threads = policy.pool().concurrency();
+
+	if (chunks.count > threads)
+		chunks.count = threads;		// one run per thread, the merges are balanced anyway
+	if (chunks.count == 1)
+	{
+		sort_chunk_<RandomIt, Compare, Default>	whole = { chunks, first, comp };
+
+		whole(0);
+		return ;
+	}
+
+	sort_chunk_<RandomIt, Compare, Default>	runs = { chunks, first, comp };
+
+	parallel_run_(policy, chunks.count, runs);
+
+	std::allocator<T>	alloc;
+	T*					buffer = alloc.allocate(n);
+	std::size_t			built = 0;
+	bool				in_buffer = false;
+
+	try
+	{
+		for (; built < n; ++built)
+			alloc.construct(buffer + built, *first);
+	}
+	catch (...)
+	{
+		while (built != 0)
+			alloc.destroy(buffer + --built);
+		alloc.deallocate(buffer, n);
+		throw ;
+	}
+	for (std::size_t width = 1; width < chunks.count; width *= 2, in_buffer = !in_buffer)
+	{
+		if (in_buffer)
+			merge_round_(policy, chunks, buffer, first, comp, width);
+		else
+			merge_round_(policy, chunks, first, buffer, comp, width);
+	}
+	if (in_buffer)
+	{
+		copy_chunk_<T*, RandomIt>	back = { parallel_chunks_(policy, n), buffer, first };
+
+		parallel_run_(policy, back.chunks.count, back);
+	}
+	while (built != 0)
+		alloc.destroy(buffer + --built);
+	alloc.deallocate(buffer, n);
+}
+
+
+// for_each
+template< class InputIt, class UnaryFunction >
+void	for_each( const execution::sequenced_policy&, InputIt first, InputIt last, UnaryFunction f )
+{ ft::for_each(first, last, f); }
+
+template< class RandomIt, class UnaryFunction >
+void	for_each( const execution::parallel_policy& policy, RandomIt first, RandomIt last, UnaryFunction f )
+{
+	for_each_chunk_<RandomIt, UnaryFunction>	body = { parallel_chunks_(policy, last - first), first, f };
+
+	parallel_run_(policy, body.chunks.count, body);
+}
+
+// transform
+template< class InputIt, class OutputIt, class UnaryOperation >
+OutputIt	transform( const execution::sequenced_policy&, InputIt first1, InputIt last1,
+						OutputIt d_first, UnaryOperation unary_op )
+{ return (ft::transform(first1, last1, d_first, unary_op)); }
+
+template< class RandomIt1, class RandomIt2, class UnaryOperation >
+RandomIt2	transform( const execution::parallel_policy& policy, RandomIt1 first1, RandomIt1 last1,
+						RandomIt2 d_first, UnaryOperation unary_op )
+{
+	transform_chunk_<RandomIt1, RandomIt2, UnaryOperation>	body = { parallel_chunks_(policy, last1 - first1),
+																		first1, d_first, unary_op };
+
+	parallel_run_(policy, body.chunks.count, body);
+	return (d_first + (last1 - first1));
+}
+
+template< class InputIt1, class InputIt2, class OutputIt, class BinaryOperation >
+OutputIt	transform( const execution::sequenced_policy&, InputIt1 first1, InputIt1 last1, InputIt2 first2,
+						OutputIt d_first, BinaryOperation binary_op )
+{ return (ft::transform(first1, last1, first2, d_first, binary_op)); }
+
+template< class RandomIt1, class RandomIt2, class RandomIt3, class BinaryOperation >
+RandomIt3	transform( const execution::parallel_policy& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2,
+						RandomIt3 d_first, BinaryOperation binary_op )
+{
+	transform2_chunk_<RandomIt1, RandomIt2, RandomIt3, BinaryOperation>	body = {
+		parallel_chunks_(policy, last1 - first1), first1, first2, d_first, binary_op };
+
+	parallel_run_(policy, body.chunks.count, body);
+	return (d_first + (last1 - first1));
+}
+
+// reduce
+template< class InputIt, class T, class BinaryOp >
+T	reduce( const execution::sequenced_policy&, InputIt first, InputIt last, T init, BinaryOp op )
+{ return (ft::reduce(first, last, init, op)); }
+
+template< class RandomIt, class T, class BinaryOp >
+T	reduce( const execution::parallel_policy& policy, RandomIt first, RandomIt last, T init, BinaryOp op )
+{
+	if (first == last)
+		return (init);
+
+	const parallel_chunks_					chunks(policy, last - first);
+	parallel_partials_<T>					partials(chunks.count, init);
+	reduce_chunk_<RandomIt, T, BinaryOp>	body = { chunks, first, op, &partials };
+
+	parallel_run_(policy, body.chunks.count, body);
+	return (ft::reduce(partials.begin(), partials.end(), init, op));
+}
+
+template< class InputIt, class T >
+T	reduce( const execution::sequenced_policy&, InputIt first, InputIt last, T init )
+{ return (ft::reduce(first, last, init)); }
+
+template< class RandomIt, class T >
+T	reduce( const execution::parallel_policy& policy, RandomIt first, RandomIt last, T init )
+{ return (ft::reduce(policy, first, last, init, std::plus<T>())); }
+
+template< class InputIt >
+typename ft::iterator_traits<InputIt>::value_type	reduce( const execution::sequenced_policy&,
+															InputIt first, InputIt last )
+{ return (ft::reduce(first, last)); }
+
+template< class RandomIt >
+typename ft::iterator_traits<RandomIt>::value_type	reduce( const execution::parallel_policy& policy,
+															RandomIt first, RandomIt last )
+{ return (ft::reduce(policy, first, last, typename ft::iterator_traits<RandomIt>::value_type())); }
+
+// sort
+template< class RandomIt >
+void	sort( const execution::sequenced_policy&, RandomIt first, RandomIt last )
+{ ft::sort(first, last); }
+
+template< class RandomIt, class Compare >
+void	sort( const execution::sequenced_policy&, RandomIt first, RandomIt last, Compare comp )
+{ ft::sort(first, last, comp); }
+
+template< class RandomIt >
+void	sort( const execution::parallel_policy& policy, RandomIt first, RandomIt last )
+{
+	typedef typename ft::iterator_traits<RandomIt>::value_type	T;
+
+	ft::parallel_sort_<RandomIt, std::less<T>, true>(policy, first, last, std::less<T>());
+}
+
+template< class RandomIt, class Compare >
+void	sort( const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp )
+{ ft::parallel_sort_<RandomIt, Compare, false>(policy, first, last, comp); }
+
+// equal
+template< class InputIt1, class InputIt2 >
+bool	equal( const execution::sequenced_policy&, InputIt1 first1, InputIt1 last1, InputIt2 first2 )
+{ return (ft::equal(first1, last1, first2)); }
+
+template< class RandomIt1, class RandomIt2 >
+bool	equal( const execution::parallel_policy& policy, RandomIt1 first1, RandomIt1 last1, RandomIt2 first2 )
+{
+	equal_chunk_<RandomIt1, RandomIt2>	body = { parallel_chunks_(policy, last1 - first1), first1, first2, 0 };
+
+	parallel_run_(policy, body.chunks.count, body);
+	return (body.mismatch == 0);
+}
+
+
+/*
+	parallel traversal of the ordered containers (ft::map, ft::multimap, ft::set, ft::multiset):
+	the nodes of the top levels of the tree cut [first, last) into ranges of whole subtrees,
+	about parallel_chunks_per_thread_ per thread, and every range is walked with ++ by one thread.
+	the cuts are placed by the shape of the tree, not by the keys: no comparison is made,
+	and first / last may be anywhere, inside a run of equal keys as well.
+*/
+
+// a before b in order; the DUMMY (end) is after every node
+template< class Link >
+bool	tree_in_order_before_( Link a, Link b )
+{
+	if (a == b || a->isDummy())
+		return (false);
+	if (b->isDummy())
+		return (true);
+
+	ft::vector<Link>	path_a;		// from the node up to the root
+	ft::vector<Link>	path_b;
+
+	for (; !a->isDummy(); a = a->parent)
+		path_a.push_back(a);
+	for (; !b->isDummy(); b = b->parent)
+		path_b.push_back(b);
+
+	std::size_t		i = path_a.size();
+	std::size_t		j = path_b.size();
+
+	while (i > 0 && j > 0 && path_a[i - 1] == path_b[j - 1])
+	{
+		--i;
+		--j;
+	}
+
+	Link	common = path_a[i];		// the lowest common ancestor
+
+	if (i == 0)		// a is above b
+		return (path_b[j - 1] == common->right);
+	return (path_a[i - 1] == common->left);
+}
+
+// the nodes of the depth top levels of the subtree of node, in order
+template< class Link >
+void	tree_top_nodes_( Link node, std::size_t depth, ft::vector<Link>& out )
+{
+	if (node == NULL || depth == 0)
+		return ;
+	tree_top_nodes_(node->left, depth - 1, out);
+	out.push_back(node);
+	tree_top_nodes_(node->right, depth - 1, out);
+}
+
+// chunk i is [bounds[i], bounds[i + 1]): none of them is empty
+template< class TreeIt >
+struct	tree_chunks_
+{
+	typedef rb_node_<typename TreeIt::value_type>*	link_type;
+
+	tree_chunks_( const execution::parallel_policy& policy, TreeIt first, TreeIt last )
+	{
+		link_type	begin = const_cast<link_type>(first.get_link());
+		link_type	end = const_cast<link_type>(last.get_link());
+
+		bounds.push_back(begin);
+		if (begin != end && policy.pool().concurrency() > 1)
+		{
+			const std::size_t	target = policy.pool().concurrency() * parallel_chunks_per_thread_;
+			std::size_t			depth = 1;
+			link_type			root = begin;
+			ft::vector<link_type>	tops;
+
+			while ((static_cast<std::size_t>(1) << depth) < target)
+				++depth;
+			while (!root->parent->isDummy())
+				root = root->parent;
+			tree_top_nodes_(root, depth, tops);
+			for (std::size_t i = 0; i < tops.size(); ++i)
+				if (tree_in_order_before_(begin, tops[i]) && tree_in_order_before_(tops[i], end))
+					bounds.push_back(tops[i]);
+		}
+		if (begin != end)
+			bounds.push_back(end);
+	}
+
+	std::size_t	count() const
+	{ return (bounds.size() - 1); }
+
+	ft::vector<link_type>	bounds;
+};
+
+template< class TreeIt, class UnaryFunction >
+struct	tree_for_each_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		UnaryFunction	fn(f);
+
+		for (TreeIt it(chunks->bounds[chunk]), end(chunks->bounds[chunk + 1]); it != end; ++it)
+			fn(*it);
+	}
+
+	const tree_chunks_<TreeIt>*		chunks;
+	UnaryFunction					f;
+};
+
+template< class TreeIt, class T, class BinaryOp, class UnaryOp >
+struct	tree_reduce_chunk_
+{
+	void	operator()( std::size_t chunk )
+	{
+		TreeIt	it(chunks->bounds[chunk]);
+		TreeIt	end(chunks->bounds[chunk + 1]);
+		T		acc = transform(*it);
+
+		while (++it != end)
+			acc = reduce(acc, transform(*it));
+		(*partials)[chunk] = acc;
+	}
+
+	const tree_chunks_<TreeIt>*		chunks;
+	BinaryOp						reduce;
+	UnaryOp							transform;
+	parallel_partials_<T>*			partials;
+};
+
+// f(*it) for every it of [first, last), iterators of an ordered container
+template< class TreeIt, class UnaryFunction >
+void	parallel_for_each( const execution::parallel_policy& policy, TreeIt first, TreeIt last, UnaryFunction f )
+{
+	tree_chunks_<TreeIt>						chunks(policy, first, last);
+	tree_for_each_chunk_<TreeIt, UnaryFunction>	body = { &chunks, f };
+
+	if (chunks.count() != 0)
+		parallel_run_(policy, chunks.count(), body);
+}
+
+// init reduce transform(*first) reduce ... transform(*(last - 1)), grouped by chunks:
+// reduce has to be associative, but the chunks are combined in key order, so it may not commute
+template< class TreeIt, class T, class BinaryOp, class UnaryOp >
+T	parallel_reduce( const execution::parallel_policy& policy, TreeIt first, TreeIt last, T init,
+						BinaryOp reduce, UnaryOp transform )
+{
+	tree_chunks_<TreeIt>								chunks(policy, first, last);
+	parallel_partials_<T>								partials(chunks.count(), init);
+	tree_reduce_chunk_<TreeIt, T, BinaryOp, UnaryOp>	body = { &chunks, reduce, transform, &partials };
+
+	if (chunks.count() != 0)
+		parallel_run_(policy, chunks.count(), body);
+	for (std::size_t i = 0; i < partials.size(); ++i)
+		init = reduce(init, partials[i]);
+	return (init);
+}
+
+
+}	// namespace ft
+
+#endif
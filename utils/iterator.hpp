@@ -15,11 +15,13 @@
 // // iterator:			https://en.cppreference.com/w/cpp/iterator/iterator
 // // reverse_iterator:	https://en.cppreference.com/w/cpp/iterator/reverse_iterator
 // // distance:			https://en.cppreference.com/w/cpp/iterator/distance
+// // advance:			https://en.cppreference.com/w/cpp/iterator/advance
 
 #ifndef ITERATOR_HPP
 # define ITERATOR_HPP
 
 #include <cstddef>
+#include <iterator>
 # include "type_traits.hpp"
 
 namespace ft
@@ -243,9 +245,123 @@ typename reverse_iterator<Iter1>::difference_type	operator-( const reverse_itera
 // end of Non-member functions (reverse_iterator)
 
 
+// key_iterator: the keys of a range of pairs (ft::map, ft::multimap), as a range of their own,
+// e.g. to intersect the keys of two maps, or of a map and a sorted vector
+template< class Iter >
+class	key_iterator
+{
+	public:
+		// Member type
+			typedef Iter																		iterator_type;
+			typedef ft::bidirectional_iterator_tag												iterator_category;
+			typedef typename ft::remove_cv<typename ft::iterator_traits<Iter>::value_type::first_type>::type	value_type;
+			typedef typename ft::iterator_traits<Iter>::difference_type							difference_type;
+			typedef const value_type*															pointer;
+			typedef const value_type&															reference;
+
+		// Member functions
+			key_iterator()
+			: current()
+			{
+
+			}
+
+			explicit key_iterator( iterator_type x )
+			: current(x)
+			{
+
+			}
+
+			iterator_type	base() const
+			{ return (current); }
+
+			reference	operator*() const
+			{ return (current->first); }
+
+			pointer		operator->() const
+			{ return (&current->first); }
+
+			key_iterator&	operator++()
+			{
+				++current;
+				return (*this);
+			}
+
+			key_iterator&	operator--()
+			{
+				--current;
+				return (*this);
+			}
+
+			key_iterator	operator++( int )
+			{
+				key_iterator	tmp = *this;
+				++current;
+				return (tmp);
+			}
+
+			key_iterator	operator--( int )
+			{
+				key_iterator	tmp = *this;
+				--current;
+				return (tmp);
+			}
+
+	protected:
+		// Member objects
+			iterator_type	current;
+
+};	// class	key_iterator
+
+template< class Iterator1, class Iterator2 >
+bool	operator==( const key_iterator<Iterator1>& lhs, const key_iterator<Iterator2>& rhs )
+{ return (lhs.base() == rhs.base()); }
+
+template< class Iterator1, class Iterator2 >
+bool	operator!=( const key_iterator<Iterator1>& lhs, const key_iterator<Iterator2>& rhs )
+{ return (lhs.base() != rhs.base()); }
+
+template< class Iter >
+ft::key_iterator<Iter>	make_key_iterator( Iter it )
+{ return (ft::key_iterator<Iter>(it)); }
+
+
+// iterator_category
+	// iterators of std containers have std tags, so convert them to ft tags before dispatch
+	template< class Tag >
+	struct	iterator_tag_to_ft_
+	{ typedef Tag type; };
+
+	template<>
+	struct	iterator_tag_to_ft_< std::input_iterator_tag >
+	{ typedef ft::input_iterator_tag type; };
+
+	template<>
+	struct	iterator_tag_to_ft_< std::output_iterator_tag >
+	{ typedef ft::output_iterator_tag type; };
+
+	template<>
+	struct	iterator_tag_to_ft_< std::forward_iterator_tag >
+	{ typedef ft::forward_iterator_tag type; };
+
+	template<>
+	struct	iterator_tag_to_ft_< std::bidirectional_iterator_tag >
+	{ typedef ft::bidirectional_iterator_tag type; };
+
+	template<>
+	struct	iterator_tag_to_ft_< std::random_access_iterator_tag >
+	{ typedef ft::random_access_iterator_tag type; };
+
+	template< class Iter >
+	typename iterator_tag_to_ft_<typename ft::iterator_traits<Iter>::iterator_category>::type
+		iterator_category( const Iter& )
+	{ return (typename iterator_tag_to_ft_<typename ft::iterator_traits<Iter>::iterator_category>::type()); }
+
+
 // other functions
 template< class InputIt >
-typename ft::iterator_traits<InputIt>::difference_type	distance( InputIt first, InputIt last)
+typename ft::iterator_traits<InputIt>::difference_type	distance_( InputIt first, InputIt last,
+																	ft::input_iterator_tag )
 {
 	typename ft::iterator_traits<InputIt>::difference_type	ret = 0;
 
@@ -257,6 +373,44 @@ typename ft::iterator_traits<InputIt>::difference_type	distance( InputIt first,
 	return (ret);
 }
 
+template< class RandomIt >
+typename ft::iterator_traits<RandomIt>::difference_type	distance_( RandomIt first, RandomIt last,
+																	ft::random_access_iterator_tag )
+{ return (last - first); }
+
+template< class InputIt >
+typename ft::iterator_traits<InputIt>::difference_type	distance( InputIt first, InputIt last)
+{ return (ft::distance_(first, last, ft::iterator_category(first))); }
+
+
+template< class InputIt, class Distance >
+void	advance_( InputIt& it, Distance n, ft::input_iterator_tag )
+{
+	for (; n > 0; --n)
+		++it;
+}
+
+template< class BidirIt, class Distance >
+void	advance_( BidirIt& it, Distance n, ft::bidirectional_iterator_tag )
+{
+	for (; n > 0; --n)
+		++it;
+	for (; n < 0; ++n)
+		--it;
+}
+
+template< class RandomIt, class Distance >
+void	advance_( RandomIt& it, Distance n, ft::random_access_iterator_tag )
+{ it += n; }
+
+template< class InputIt, class Distance >
+void	advance( InputIt& it, Distance n )
+{
+	typename ft::iterator_traits<InputIt>::difference_type	d = n;
+
+	ft::advance_(it, d, ft::iterator_category(it));
+}
+
 
 }	// namespace ft
 
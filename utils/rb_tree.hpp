@@ -160,6 +160,34 @@ class	rb_node_
 				tmp = tmp->right;
 			return (tmp);
 		}
+
+		// In-order steps and their upkeep, through the node type of the tree (see rb_threaded_node_):
+		// a plain node climbs the tree, and keeps nothing up to date
+		static link_type	successor( link_type node )
+		{ return (rb_tree_increment(node)); }
+
+		static link_type	predecessor( link_type node )
+		{ return (rb_tree_decrement(node)); }
+
+		static void	threadNode( link_type, link_type, bool )
+		{
+
+		}
+
+		static void	unthreadNode( link_type )
+		{
+
+		}
+
+		static void	threadEnds( link_type, link_type, link_type )
+		{
+
+		}
+
+		static void	threadAll( link_type )
+		{
+
+		}
 	// ~public:
 		
 };	// class rb_node_
@@ -222,8 +250,93 @@ const rb_node_<Val_>*	rb_tree_decrement(const rb_node_<Val_>* node) throw()
 { return (local_rb_tree_decrement_(const_cast<rb_node_<Val_>*>(node))); }
 
 
+/*
+	rb_threaded_node_: rb_node_ with in-order links, for rb_tree< ..., true >.
+	every node points to its successor (next) and predecessor (prev), and the DUMMY closes
+	the circle (DUMMY->next: begin, DUMMY->prev: end - 1), so ++ and -- are one load
+	instead of a climb through the parents. the links cost two pointers per node,
+	and are kept on insert and erase in O(1): rotations do not change the order.
+*/
+template< class T >
+class	rb_threaded_node_ : public rb_node_<T>
+{
+	public:
+		typedef typename rb_node_<T>::link_type		link_type;
+
+		link_type	next;
+		link_type	prev;
+
+		static link_type	successor( link_type node )
+		{ return (threaded_(node)->next); }
+
+		static link_type	predecessor( link_type node )
+		{ return (threaded_(node)->prev); }
+
+		// node goes just before parent (insert_left) or just after it, as its new child
+		static void	threadNode( link_type node, link_type parent, bool insert_left )
+		{
+			if (insert_left)
+			{
+				link_(threaded_(parent)->prev, node);
+				link_(node, parent);
+			}
+			else
+			{
+				link_(node, threaded_(parent)->next);
+				link_(parent, node);
+			}
+		}
+
+		static void	unthreadNode( link_type node )
+		{ link_(threaded_(node)->prev, threaded_(node)->next); }
 
-template< typename T >
+		// header alone (first NULL), or the circle header, first ... last, header
+		static void	threadEnds( link_type header, link_type first, link_type last )
+		{
+			if (first == NULL)
+				link_(header, header);
+			else
+			{
+				link_(header, first);
+				link_(last, header);
+			}
+		}
+
+		// a tree built without the links (copy): one climbing walk
+		static void	threadAll( link_type header )
+		{
+			link_type	before = header;
+
+			for (link_type node = header->parent; node != header; node = rb_tree_increment(node))
+			{
+				link_(before, node);
+				before = node;
+			}
+			link_(before, header);
+		}
+
+	private:
+		static rb_threaded_node_*	threaded_( link_type node )
+		{ return (static_cast<rb_threaded_node_*>(node)); }
+
+		static void	link_( link_type first, link_type second )
+		{
+			threaded_(first)->next = second;
+			threaded_(second)->prev = first;
+		}
+};	// class rb_threaded_node_
+
+template< class T, bool Threaded >
+struct	rb_node_type_
+{ typedef rb_node_<T>	type; };
+
+template< class T >
+struct	rb_node_type_<T, true>
+{ typedef rb_threaded_node_<T>	type; };
+
+
+
+template< typename T, typename Node_ = rb_node_<T> >
 class	rb_iterator_
 {
 	public:
@@ -235,7 +348,7 @@ class	rb_iterator_
  		typedef ptrdiff_t	difference_type;
 
 	private:
-		typedef rb_iterator_<T>						Self_;
+		typedef rb_iterator_<T, Node_>				Self_;
 		typedef typename rb_node_<T>::link_type		link_type;
 	
 	public:
@@ -265,7 +378,7 @@ class	rb_iterator_
 
 		Self_&	operator++()
 		{
-			iterator_node_ = rb_tree_increment(iterator_node_);
+			iterator_node_ = Node_::successor(iterator_node_);
 			return (*this);
 		}
 		
@@ -273,13 +386,13 @@ class	rb_iterator_
 		{
 			Self_	tmp = *this;
 
-			iterator_node_ = rb_tree_increment(iterator_node_);
+			iterator_node_ = Node_::successor(iterator_node_);
 			return (tmp);
 		}
 
 		Self_&	operator--()
 		{
-			iterator_node_ = rb_tree_decrement(iterator_node_);
+			iterator_node_ = Node_::predecessor(iterator_node_);
 			return (*this);
 		}
 
@@ -287,7 +400,7 @@ class	rb_iterator_
 		{
 			Self_	tmp = *this;
 
-			iterator_node_ = rb_tree_decrement(iterator_node_);
+			iterator_node_ = Node_::predecessor(iterator_node_);
 			return (tmp);
 		}
 
@@ -305,7 +418,7 @@ class	rb_iterator_
 
 };
 
-template< typename T >
+template< typename T, typename Node_ = rb_node_<T> >
 class	rb_const_iterator_
 {
 	public:
@@ -313,13 +426,13 @@ class	rb_const_iterator_
 		typedef const T&	reference;
 		typedef const T*	pointer;
 
-		typedef rb_iterator_<T>		iterator;
+		typedef rb_iterator_<T, Node_>	iterator;
 
 		typedef ft::bidirectional_iterator_tag	iterator_category;
  		typedef ptrdiff_t	difference_type;
 
 	private:
-		typedef rb_const_iterator_<T>	Self_;
+		typedef rb_const_iterator_<T, Node_>	Self_;
 		typedef const rb_node_<T>*		link_type;
 	
 	public:
@@ -349,7 +462,7 @@ class	rb_const_iterator_
 
 		Self_&	operator++()
 		{
-			iterator_node_ = rb_tree_increment(iterator_node_);
+			iterator_node_ = Node_::successor(const_cast<typename rb_node_<T>::link_type>(iterator_node_));
 			return (*this);
 		}
 		
@@ -357,13 +470,13 @@ class	rb_const_iterator_
 		{
 			Self_	tmp = *this;
 
-			iterator_node_ = rb_tree_increment(iterator_node_);
+			iterator_node_ = Node_::successor(const_cast<typename rb_node_<T>::link_type>(iterator_node_));
 			return (tmp);
 		}
 
 		Self_&	operator--()
 		{
-			iterator_node_ = rb_tree_decrement(iterator_node_);
+			iterator_node_ = Node_::predecessor(const_cast<typename rb_node_<T>::link_type>(iterator_node_));
 			return (*this);
 		}
 
@@ -371,7 +484,7 @@ class	rb_const_iterator_
 		{
 			Self_	tmp = *this;
 
-			iterator_node_ = rb_tree_decrement(iterator_node_);
+			iterator_node_ = Node_::predecessor(const_cast<typename rb_node_<T>::link_type>(iterator_node_));
 			return (tmp);
 		}
 
@@ -391,8 +504,275 @@ class	rb_const_iterator_
 
 
 
-template< typename Key_, typename Val_, typename KeyOfValue_, typename Compare_, typename Allocator_ = std::allocator<Val_> >
+// Red-black rebalancing on bare links, shared by rb_tree and intrusive_map.
+// header is the DUMMY node (header->left: root, header->parent: begin).
+// Nodes are only relinked, never copied or freed: the caller owns them.
+template< typename Val_ >
+struct	rb_tree_balance_
+{
+	typedef rb_node_<Val_>*							link_type;
+	typedef typename rb_node_<Val_>::color_type		color_type;
+
+	static const color_type	BLACK = rb_node_<Val_>::BLACK;
+	static const color_type	RED = rb_node_<Val_>::RED;
+
+	// hang new_node under parent (header when the tree is empty), then rebalance
+	static void	linkNode(link_type header, link_type new_node, link_type parent, bool insert_left)
+	{
+		new_node->color = RED;
+		new_node->left = NULL;
+		new_node->right = NULL;
+		new_node->parent = parent;
+		if (parent == header)
+		{
+			header->left = new_node;
+			header->parent = new_node;
+		}
+		else if (insert_left)
+		{
+			parent->left = new_node;
+			if (parent == header->parent)
+				header->parent = new_node;
+		}
+		else
+			parent->right = new_node;
+		fixRedRed(header, new_node);
+		header->left->color = BLACK;
+		header->left->parent = header;
+	}
+
+	// Rotates (the root is reached through its parent, so the header needs no update)
+	static void	leftRotate(link_type rotate_root)
+	{
+		link_type	new_parent = rotate_root->right;
+		rotate_root->moveDown(new_parent);
+
+		rotate_root->right = new_parent->left;
+		if (rotate_root->right != NULL)
+			rotate_root->right->parent = rotate_root;
+		new_parent->left = rotate_root;
+	}
+
+	static void	rightRotate(link_type rotate_root)
+	{
+		link_type	new_parent = rotate_root->left;
+		rotate_root->moveDown(new_parent);
+
+		rotate_root->left = new_parent->right;
+		if (rotate_root->left != NULL)
+			rotate_root->left->parent = rotate_root;
+		new_parent->right = rotate_root;
+	}
+
+	static void	swapColors(link_type n1, link_type n2)
+	{
+		color_type	tmp = n1->color;
+		n1->color = n2->color;
+		n2->color = tmp;
+	}
+
+	static void	fixRedRed(link_type header, link_type child_to_fix)
+	{
+		if (child_to_fix == header->left)
+		{
+			header->left->color = BLACK;
+			return ;
+		}
+
+		link_type	parent = child_to_fix->parent;
+		link_type	grandparent = parent->parent;
+		if (grandparent->isDummy())
+			grandparent = NULL;
+		link_type	uncle = child_to_fix->uncle();
+
+		if (parent->color == RED)
+		{
+			if (uncle != NULL && uncle->color == RED)
+			{
+				parent->color = BLACK;
+				uncle->color = BLACK;
+				grandparent->color = RED;
+				fixRedRed(header, grandparent);
+			}
+			else
+			{	// uncle: BLACK
+				if (parent->isOnLeft())
+				{
+					if (child_to_fix->isOnLeft())
+						swapColors(parent, grandparent);
+					else
+					{
+						leftRotate(parent);
+						swapColors(child_to_fix, grandparent);
+					}
+					rightRotate(grandparent);
+				}
+				else
+				{	// parent: onRight
+					if (child_to_fix->isOnLeft())
+					{
+						rightRotate(parent);
+						swapColors(child_to_fix, grandparent);
+					}
+					else
+						swapColors(parent, grandparent);
+					leftRotate(grandparent);
+				}
+			}
+		}
+	}
+
+	static link_type	newSubroot_toReplace(link_type subroot_to_delete)
+	{
+		if (subroot_to_delete->left != NULL && subroot_to_delete->right != NULL)
+			return (subroot_to_delete->right->leftest());
+
+		if (subroot_to_delete->left == NULL && subroot_to_delete->right == NULL)
+			return (NULL);
+		if (subroot_to_delete->left != NULL)
+			return (subroot_to_delete->left);
+		else
+			return (subroot_to_delete->right);
+	}
+
+	static void	unlinkNode(link_type header, link_type node_to_delete)
+	{
+		link_type	new_subroot = newSubroot_toReplace(node_to_delete);
+		link_type	parent_of_subroot = node_to_delete->parent;
+
+		if (new_subroot == NULL)
+		{
+			if (node_to_delete == header->left)
+				header->left = NULL;
+			else
+			{
+				if ((new_subroot == NULL || new_subroot->color == BLACK)
+					&& (node_to_delete->color == BLACK))
+				{
+					fixDoubleBlack(header, node_to_delete);
+				}
+				else
+				{
+					if (node_to_delete->sibling() != NULL)
+						node_to_delete->sibling()->color = RED;
+				}
+
+				if (node_to_delete->isOnLeft())
+					parent_of_subroot->left = NULL;
+				else
+					parent_of_subroot->right = NULL;
+			}
+		}
+		else if (node_to_delete->left == NULL
+				|| node_to_delete->right == NULL)
+		{
+			if (node_to_delete == header->left)
+			{
+				node_to_delete->swapNode(new_subroot);
+				new_subroot->left = NULL;
+				new_subroot->right = NULL;
+			}
+			else
+			{
+				if (node_to_delete->isOnLeft())
+					parent_of_subroot->left = new_subroot;
+				else
+					parent_of_subroot->right = new_subroot;
+				new_subroot->parent = parent_of_subroot;
+				if ((new_subroot == NULL || new_subroot->color == BLACK)
+					&& (node_to_delete->color == BLACK))
+					fixDoubleBlack(header, new_subroot);
+				else
+					new_subroot->color = BLACK;
+			}
+		}
+		else
+		{
+			new_subroot->swapNode(node_to_delete);
+			unlinkNode(header, node_to_delete);
+		}
+	}
+
+	static void	fixDoubleBlack(link_type header, link_type child_to_fix)
+	{
+		if (child_to_fix == header->left)
+			return ;
+		
+		link_type	parent = child_to_fix->parent;
+		link_type	sibling = child_to_fix->sibling();
+
+		if (sibling == NULL)
+			fixDoubleBlack(header, parent);
+		else
+		{
+			if (sibling->color == RED)
+			{
+				parent->color = RED;
+				sibling->color = BLACK;
+				if (sibling->isOnLeft())
+					rightRotate(parent);
+				else
+					leftRotate(parent);
+				fixDoubleBlack(header, child_to_fix);
+			}
+			else
+			{
+				if (sibling->hasRedChild())
+				{
+					if (sibling->left != NULL && sibling->left->color == RED)
+					{
+						if (sibling->isOnLeft())
+						{
+							sibling->left->color = sibling->color;
+							sibling->color = parent->color;
+							rightRotate(parent);
+						}
+						else
+						{
+							sibling->left->color = parent->color;
+							rightRotate(sibling);
+							leftRotate(parent);
+						}
+					}
+					else
+					{
+						if (sibling->isOnLeft())
+						{
+							sibling->right->color = parent->color;
+							leftRotate(sibling);
+							rightRotate(parent);
+						}
+						else
+						{
+							sibling->right->color = sibling->color;
+							sibling->color = parent->color;
+							leftRotate(parent);
+						}
+					}
+					parent->color = BLACK;
+				}
+				else
+				{
+					sibling->color = RED;
+					if (parent->color == BLACK)
+						fixDoubleBlack(header, parent);
+					else
+						parent->color = BLACK;
+				}
+			}
+		}
+	}
+
+
+};	// struct rb_tree_balance_
+
+
+// Threaded_: the nodes keep in-order links (rb_threaded_node_), for O(1) ++ and --
+template< typename Key_, typename Val_, typename KeyOfValue_, typename Compare_, typename Allocator_ = std::allocator<Val_>,
+			bool Threaded_ = false >
 class	rb_tree
+: private ft::ebo_holder_<typename Allocator_::template rebind<typename rb_node_type_<Val_, Threaded_>::type>::other, 0>,
+	private ft::ebo_holder_<Compare_, 1>
 {
 	public:
 		// Member types
@@ -412,13 +792,15 @@ class	rb_tree
 			typedef Val_&			reference;
 			typedef const Val_&		const_reference;
 
-			typedef rb_iterator_<Val_>						iterator;
-			typedef rb_const_iterator_<Val_>				const_iterator;
+			typedef typename rb_node_type_<Val_, Threaded_>::type	stored_node_type;
+
+			typedef rb_iterator_<Val_, stored_node_type>		iterator;
+			typedef rb_const_iterator_<Val_, stored_node_type>	const_iterator;
 			typedef ft::reverse_iterator<iterator>			reverse_iterator;
 			typedef ft::reverse_iterator<const_iterator>	const_reverse_iterator;
 
 
-			typedef typename Allocator_::template rebind<rb_node_<Val_> >::other
+			typedef typename Allocator_::template rebind<stored_node_type>::other
     				node_allocator_type;
 
 			static const color_type	BLACK = rb_node_<Val_>::BLACK;
@@ -427,13 +809,31 @@ class	rb_tree
 	protected:
 		typedef rb_node_<Val_>*			link_type;
 		typedef const rb_node_<Val_>*	const_link_type;
+		typedef rb_tree_balance_<Val_>	balance_type_;
 
 		// Member objects
+			// empty allocator and comparator take no space (ebo_holder_)
+			typedef ft::ebo_holder_<node_allocator_type, 0>		node_alloc_holder_;
+			typedef ft::ebo_holder_<Compare_, 1>				compare_holder_;
+
 			link_type				dummy_;
 			link_type				prev_end;
-			node_allocator_type		node_alloc_;
 			size_type				size_;
-			Compare_				key_compare_;
+
+			node_allocator_type&	node_alloc_()
+			{ return (node_alloc_holder_::get()); }
+
+			const node_allocator_type&	node_alloc_() const
+			{ return (node_alloc_holder_::get()); }
+
+			Compare_&	compare_()
+			{ return (compare_holder_::get()); }
+
+			const Compare_&		compare_() const
+			{ return (compare_holder_::get()); }
+
+			bool	key_compare_( const key_type& lhs, const key_type& rhs ) const
+			{ return (compare_holder_::get()(lhs, rhs)); }
 		
 // Macro(define)
 #define RB_TREE_ROOT_		dummy_->left
@@ -444,21 +844,21 @@ class	rb_tree
 	public:
 		// Constructors
 			rb_tree()
-			: node_alloc_(node_allocator_type()), key_compare_(Compare_())
+			: node_alloc_holder_(), compare_holder_()
 			{
 				dummy_ = createNode(value_type());
 				initialize();
 			}
 
 			rb_tree( const key_compare_type& key_comp, const node_allocator_type& node_alloc)
-			: node_alloc_(node_alloc), key_compare_(key_comp)
+			: node_alloc_holder_(node_alloc), compare_holder_(key_comp)
 			{
 				dummy_ = createNode(value_type());
 				initialize();
 			}
 
 			rb_tree( const rb_tree& other)
-			: node_alloc_(other.node_alloc_), key_compare_(other.key_compare_)
+			: node_alloc_holder_(other.node_alloc_()), compare_holder_(other.compare_())
 			{
 				dummy_ = createNode(value_type());
 				initialize();
@@ -467,6 +867,7 @@ class	rb_tree
 					RB_TREE_ROOT_ = copyTree(other.RB_TREE_ROOT_, dummy_);
 					RB_TREE_BEGIN_ = RB_TREE_ROOT_->leftest();
 					RB_TREE_PREV_RB_TREE_END_ = RB_TREE_ROOT_->rightest();
+					stored_node_type::threadAll(dummy_);
 				}
 			}
 
@@ -482,24 +883,25 @@ class	rb_tree
 					return (*this);
 				
 				clear();
-				key_compare_ = other.key_compare_;
-				node_alloc_ = other.node_alloc_;
+				compare_() = other.compare_();
+				node_alloc_() = other.node_alloc_();
 
 				if (other.size_)
 				{
 					RB_TREE_ROOT_ = copyTree(other.RB_TREE_ROOT_, dummy_);
 					RB_TREE_BEGIN_ = RB_TREE_ROOT_->leftest();
 					RB_TREE_PREV_RB_TREE_END_ = RB_TREE_ROOT_->rightest();
+					stored_node_type::threadAll(dummy_);
 				}
 
 				return (*this);
 			}
 
 			key_compare_type	key_comp() const
-			{ return (key_compare_); }
+			{ return (compare_()); }
 
 			allocator_type	get_allocator() const
-			{ return (allocator_type(node_alloc_)); }
+			{ return (allocator_type(node_alloc_())); }
 		// ~Constructors
 
 
@@ -539,7 +941,7 @@ class	rb_tree
 
 			size_type	max_size() const
 			{ return std::min(static_cast<size_type>(std::numeric_limits<difference_type>::max() / sizeof(value_type)),
-				node_alloc_.max_size()); }
+				node_alloc_().max_size()); }
 
 		// Modifiers
 			void	clear()
@@ -554,31 +956,53 @@ class	rb_tree
 				return (insertNode(value, insert_place));
 			}
 
+			// insert even if an equal key exists (after the equal ones): multiset, multimap
+			iterator	insert_equal( const value_type &value )
+			{
+				link_type	parent = dummy_;
+				link_type	current_node = RB_TREE_ROOT_;
+				bool		insert_left = true;
+
+				while (current_node)
+				{
+					parent = current_node;
+					insert_left = key_compare_(key_(value), key_(current_node));
+					current_node = insert_left ? current_node->left : current_node->right;
+				}
+				return (linkNode(value, parent, insert_left));
+			}
+
+			// erase every element with key (at most one in a unique tree)
 			size_type	erase( const key_type& key)
 			{
-				if (RB_TREE_ROOT_ == NULL)
-					return (0);
+				ft::pair<iterator, iterator>	range = equal_range(key);
+				size_type						erased = 0;
 
-				iterator	it_to_delete = lower_bound(key);
-				if (it_to_delete.get_link() == RB_TREE_END_ || key_compare_(key, key_(it_to_delete)))
-					return (0);
+				while (range.first != range.second)
+				{
+					erase(range.first++);
+					++erased;
+				}
+				return (erased);
+			}
 
-				link_type	save_it_to_delete = it_to_delete.get_link();
+			// nodes are relinked, not copied, on delete: iterators to other elements stay valid
+			void	erase( const_iterator pos )
+			{
+				link_type	it_to_delete = const_cast<link_type>(pos.get_link());
 				link_type	save_begin = RB_TREE_BEGIN_;
 				link_type	save_prev_end = RB_TREE_PREV_RB_TREE_END_;
 
-				deleteNode(it_to_delete.get_link());
+				deleteNode(it_to_delete);
 				if (size_)
 				{
-					if (save_it_to_delete == save_begin)
+					if (it_to_delete == save_begin)
 						RB_TREE_BEGIN_ = RB_TREE_ROOT_->leftest();
-					if (save_it_to_delete == save_prev_end)
+					if (it_to_delete == save_prev_end)
 						RB_TREE_PREV_RB_TREE_END_ = RB_TREE_ROOT_->rightest();
 				}
 				else
 					initialize();
-				
-				return (1);				
 			}
 
 			void	swap( rb_tree& other)
@@ -600,10 +1024,13 @@ class	rb_tree
 					std::swap(RB_TREE_PREV_RB_TREE_END_, other.RB_TREE_PREV_RB_TREE_END_);
 					RB_TREE_ROOT_->parent = RB_TREE_END_;
 					other.RB_TREE_ROOT_->parent = other.RB_TREE_END_;
+					stored_node_type::threadEnds(RB_TREE_END_, RB_TREE_BEGIN_, RB_TREE_PREV_RB_TREE_END_);
+					stored_node_type::threadEnds(other.RB_TREE_END_, other.RB_TREE_BEGIN_,
+													other.RB_TREE_PREV_RB_TREE_END_);
 					std::swap(size_, other.size_);
 				}
-				std::swap(key_compare_, other.key_compare_);
-				std::swap(node_alloc_, other.node_alloc_);
+				std::swap(compare_(), other.compare_());
+				std::swap(node_alloc_(), other.node_alloc_());
 			}
 
 		// ~Modifiers
@@ -627,6 +1054,13 @@ class	rb_tree
 					return (it);
 			}
 
+			size_type	count( const key_type& key ) const
+			{
+				ft::pair<const_iterator, const_iterator>	range = equal_range(key);
+
+				return (ft::distance(range.first, range.second));
+			}
+
 			ft::pair<iterator, iterator>	equal_range( const key_type& key)
 			{
 				link_type	lower_x = RB_TREE_ROOT_;
@@ -709,6 +1143,7 @@ class	rb_tree
 				RB_TREE_BEGIN_ = dummy_;
 				RB_TREE_PREV_RB_TREE_END_ = NULL;
 				dummy_->right = dummy_;
+				stored_node_type::threadEnds(dummy_, NULL, NULL);
 
 				size_ = 0;
 			}
@@ -717,12 +1152,12 @@ class	rb_tree
 			link_type	allocate_node_()
 			{
 				++size_;
-				return (node_alloc_.allocate(1));
+				return (node_alloc_().allocate(1));
 			}
 
 			link_type	createNode( const value_type& value )
 			{
-				link_type	new_node = node_alloc_.allocate(1);
+				link_type	new_node = node_alloc_().allocate(1);
 
 				new_node->color = RED;
 				new_node->left = NULL;
@@ -761,249 +1196,16 @@ class	rb_tree
 				Allocator_	value_alloc;
 				value_alloc.destroy(node->value);
 				value_alloc.deallocate(node->value, 1);
-				node_alloc_.destroy(node);
-				node_alloc_.deallocate(node, 1);
+				node_alloc_().destroy(static_cast<stored_node_type*>(node));
+				node_alloc_().deallocate(static_cast<stored_node_type*>(node), 1);
 				--size_;
 			}
 
-		// Rotates
-		void	leftRotate(link_type rotate_root)
-		{
-			link_type	new_parent = rotate_root->right;
-			if (rotate_root == RB_TREE_ROOT_)
-				RB_TREE_ROOT_ = rotate_root;
-			
-			rotate_root->moveDown(new_parent);
-
-			rotate_root->right = new_parent->left;
-			if (rotate_root->right != NULL)
-				rotate_root->right->parent = rotate_root;
-			new_parent->left = rotate_root;
-		}
-
-		void	rightRotate(link_type rotate_root)
-		{
-			link_type	new_parent = rotate_root->left;
-			if (rotate_root == RB_TREE_ROOT_)
-				RB_TREE_ROOT_ = rotate_root;
-			
-			rotate_root->moveDown(new_parent);
-
-			rotate_root->left = new_parent->right;
-			if (rotate_root->left != NULL)
-				rotate_root->left->parent = rotate_root;
-			new_parent->right = rotate_root;
-		}
-
-		void	swapColors(link_type n1, link_type n2)
-		{
-			color_type	tmp = n1->color;
-			n1->color = n2->color;
-			n2->color = tmp;
-		}
-
-		void	swapValues(link_type n1, link_type n2)
-		{
-			value_type	tmp = n1->value_;
-			n1->value_ = n2->value_;
-			n2->value_ = tmp;
-		}
-
-		void	fixRedRed(link_type child_to_fix)
-		{
-			if (child_to_fix == RB_TREE_ROOT_)
-			{
-				RB_TREE_ROOT_->color = BLACK;
-				return ;
-			}
-
-			link_type	parent = child_to_fix->parent;
-			link_type	grandparent = parent->parent;
-			if (grandparent->isDummy())
-				grandparent = NULL;
-			link_type	uncle = child_to_fix->uncle();
-
-			if (parent->color == RED)
-			{
-				if (uncle != NULL && uncle->color == RED)
-				{
-					parent->color = BLACK;
-					uncle->color = BLACK;
-					grandparent->color = RED;
-					fixRedRed(grandparent);
-				}
-				else
-				{	// uncle: BLACK
-					if (parent->isOnLeft())
-					{
-						if (child_to_fix->isOnLeft())
-							swapColors(parent, grandparent);
-						else
-						{
-							leftRotate(parent);
-							swapColors(child_to_fix, grandparent);
-						}
-						rightRotate(grandparent);
-					}
-					else
-					{	// parent: onRight
-						if (child_to_fix->isOnLeft())
-						{
-							rightRotate(parent);
-							swapColors(child_to_fix, grandparent);
-						}
-						else
-							swapColors(parent, grandparent);
-						leftRotate(grandparent);
-					}
-				}
-			}
-		}
-
-
-
-		link_type	newSubroot_toReplace(link_type subroot_to_delete)
-		{
-			if (subroot_to_delete->left != NULL && subroot_to_delete->right != NULL)
-				return (subroot_to_delete->right->leftest());
-
-			if (subroot_to_delete->left == NULL && subroot_to_delete->right == NULL)
-				return (NULL);
-			if (subroot_to_delete->left != NULL)
-				return (subroot_to_delete->left);
-			else
-				return (subroot_to_delete->right);
-		}
-
 		void	deleteNode(link_type node_to_delete)
 		{
-			link_type	new_subroot = newSubroot_toReplace(node_to_delete);
-			link_type	parent_of_subroot = node_to_delete->parent;
-
-			if (new_subroot == NULL)
-			{
-				if (node_to_delete == RB_TREE_ROOT_)
-					RB_TREE_ROOT_ = NULL;
-				else
-				{
-					if ((new_subroot == NULL || new_subroot->color == BLACK)
-						&& (node_to_delete->color == BLACK))
-					{
-						fixDoubleBlack(node_to_delete);
-					}
-					else
-					{
-						if (node_to_delete->sibling() != NULL)
-							node_to_delete->sibling()->color = RED;
-					}
-
-					if (node_to_delete->isOnLeft())
-						parent_of_subroot->left = NULL;
-					else
-						parent_of_subroot->right = NULL;
-				}
-				destroyNode(node_to_delete);
-			}
-			else if (node_to_delete->left == NULL
-					|| node_to_delete->right == NULL)
-			{
-				if (node_to_delete == RB_TREE_ROOT_)
-				{
-					node_to_delete->swapNode(new_subroot);
-					new_subroot->left = NULL;
-					new_subroot->right = NULL;
-					destroyNode(node_to_delete);
- 				}
-				else
-				{
-					if (node_to_delete->isOnLeft())
-						parent_of_subroot->left = new_subroot;
-					else
-						parent_of_subroot->right = new_subroot;
-					destroyNode(node_to_delete);
-					new_subroot->parent = parent_of_subroot;
-					if ((new_subroot == NULL || new_subroot->color == BLACK)
-						&& (node_to_delete->color == BLACK))
-						fixDoubleBlack(new_subroot);
-					else
-						new_subroot->color = BLACK;
-				}
-			}
-			else
-			{
-				new_subroot->swapNode(node_to_delete);
-				deleteNode(node_to_delete);
-			}
-		}
-
-		void	fixDoubleBlack(link_type child_to_fix)
-		{
-			if (child_to_fix == RB_TREE_ROOT_)
-				return ;
-			
-			link_type	parent = child_to_fix->parent;
-			link_type	sibling = child_to_fix->sibling();
-
-			if (sibling == NULL)
-				fixDoubleBlack(parent);
-			else
-			{
-				if (sibling->color == RED)
-				{
-					parent->color = RED;
-					sibling->color = BLACK;
-					if (sibling->isOnLeft())
-						rightRotate(parent);
-					else
-						leftRotate(parent);
-					fixDoubleBlack(child_to_fix);
-				}
-				else
-				{
-					if (sibling->hasRedChild())
-					{
-						if (sibling->left != NULL && sibling->left->color == RED)
-						{
-							if (sibling->isOnLeft())
-							{
-								sibling->left->color = sibling->color;
-								sibling->color = parent->color;
-								rightRotate(parent);
-							}
-							else
-							{
-								sibling->left->color = parent->color;
-								rightRotate(sibling);
-								leftRotate(parent);
-							}
-						}
-						else
-						{
-							if (sibling->isOnLeft())
-							{
-								sibling->right->color = parent->color;
-								leftRotate(sibling);
-								rightRotate(parent);
-							}
-							else
-							{
-								sibling->right->color = sibling->color;
-								sibling->color = parent->color;
-								leftRotate(parent);
-							}
-						}
-						parent->color = BLACK;
-					}
-					else
-					{
-						sibling->color = RED;
-						if (parent->color == BLACK)
-							fixDoubleBlack(parent);
-						else
-							parent->color = BLACK;
-					}
-				}
-			}
+			stored_node_type::unthreadNode(node_to_delete);
+			balance_type_::unlinkNode(dummy_, node_to_delete);
+			destroyNode(node_to_delete);
 		}
 
 		link_type	findInsertPlace(const value_type &value)
@@ -1033,39 +1235,26 @@ class	rb_tree
 
 		pair<iterator, bool> 	insertNode(const value_type &value, link_type pos)
 		{
-			link_type	new_node;
-
 			if (size_ == 0)
-			{
-				new_node = createNode(value);
-				new_node->parent = pos;
-				RB_TREE_ROOT_ = new_node;
-				RB_TREE_BEGIN_ = new_node;
-				RB_TREE_PREV_RB_TREE_END_ = new_node;
-			}
+				return (ft::make_pair(linkNode(value, pos, true), true));
 			else if (key_compare_(key_(value), key_(pos)))
-			{
-				new_node = createNode(value);
-				new_node->parent = pos;
-				pos->left = new_node;
-				if (pos == RB_TREE_BEGIN_)
-					RB_TREE_BEGIN_ = new_node;
-			}
+				return (ft::make_pair(linkNode(value, pos, true), true));
 			else if (key_compare_(key_(pos), key_(value)))
-			{
-				new_node = createNode(value);
-				new_node->parent = pos;
-				pos->right = new_node;
-				if (pos == RB_TREE_PREV_RB_TREE_END_)
-					RB_TREE_PREV_RB_TREE_END_ = new_node;
-			}
+				return (ft::make_pair(linkNode(value, pos, false), true));
 			else
 				return (ft::make_pair(iterator(pos), false));
-			link_type	save_new_node = new_node;
-			fixRedRed(new_node);
-			RB_TREE_ROOT_->color = BLACK;
-			RB_TREE_ROOT_->parent = dummy_;
-			return (ft::make_pair(iterator(save_new_node), true));
+		}
+
+		// create a node as a child of parent (parent is dummy_ when the tree is empty) and rebalance
+		iterator	linkNode(const value_type &value, link_type parent, bool insert_left)
+		{
+			link_type	new_node = createNode(value);
+
+			if (parent == dummy_ || (!insert_left && parent == RB_TREE_PREV_RB_TREE_END_))
+				RB_TREE_PREV_RB_TREE_END_ = new_node;
+			stored_node_type::threadNode(new_node, parent, insert_left);
+			balance_type_::linkNode(dummy_, new_node, parent, insert_left);
+			return (iterator(new_node));
 		}
 
 key_type key_(link_type x) const { return (KeyOfValue_()(*(x->value))); }
@@ -1154,8 +1343,10 @@ const_link_type root_() const { return (RB_TREE_ROOT_); }
 			dummy_->color = from.dummy_->color;
 			dummy_->parent = from.dummy_->parent;
 			dummy_->left= from.dummy_->left;
-			dummy_->right = from.dummy_->right;
+			dummy_->right = dummy_;
 			RB_TREE_ROOT_->parent = dummy_;
+			RB_TREE_PREV_RB_TREE_END_ = from.RB_TREE_PREV_RB_TREE_END_;
+			stored_node_type::threadEnds(dummy_, RB_TREE_BEGIN_, RB_TREE_PREV_RB_TREE_END_);
 			size_ = from.size_;
 			from.initialize();
 		}
@@ -1197,37 +1388,37 @@ const_link_type root_() const { return (RB_TREE_ROOT_); }
 
 
 // Non-member functions
-	template< typename Key, typename Val, typename Compare, typename Alloc >
-	inline bool operator==( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
+	inline bool operator==( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return lhs.size() == rhs.size() &&
 			ft::equal(lhs.begin(), lhs.end(), rhs.begin()); }
 
-	template< typename Key, typename Val, typename Compare, typename Alloc >
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
 
-	inline bool operator<( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	inline bool operator<( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(),
 										rhs.end()); }
 
-	template< typename Key, typename Val, typename Compare, typename Alloc >
-	inline bool operator!=( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
+	inline bool operator!=( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return !(lhs == rhs); }
 
-	template< typename Key, typename Val, typename Compare, typename Alloc >
-	inline bool operator>( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
+	inline bool operator>( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return rhs < lhs; }
 
-	template< typename Key, typename Val, typename Compare, typename Alloc >
-	inline bool operator<=( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
+	inline bool operator<=( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return !(rhs < lhs); }
 
-	template< typename Key, typename Val, typename Compare, typename Alloc >
-	inline bool operator>=( const ft::rb_tree<Key, Val, Compare, Alloc>& lhs,
-							const ft::rb_tree<Key, Val, Compare, Alloc>& rhs )
+	template< typename Key, typename Val, typename KeyOfValue, typename Compare, typename Alloc, bool Threaded >
+	inline bool operator>=( const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& lhs,
+							const ft::rb_tree<Key, Val, KeyOfValue, Compare, Alloc, Threaded>& rhs )
 	{ return !(lhs < rhs); }
 
 
@@ -0,0 +1,343 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   thread_pool.hpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: rnitta <rnitta@student.42.fr>              +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 10:00:00 by rnitta            #+#    #+#             */
+/*   Updated: 2026/10/19 10:00:00 by rnitta           ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// thread_pool: fork-join work-stealing pool on pthreads, used by the parallel algorithms (execution.hpp)
+//
+//	run(count, fn, context) calls fn(context, i) for every i in [0, count) and returns when all are done.
+//	every worker has its own deque of tasks: it pushes and pops at the back (the newest, still in cache),
+//	and an idle thread steals at the front (the oldest, usually the largest piece of work) of the others.
+//	tasks submitted from outside the pool go to one more, shared, deque.
+//	the caller of run() runs tasks until its own are done, and only sleeps while there is none to take,
+//	so run() may be called from inside a task (nested parallelism) without blocking a worker.
+//	tasks must not throw: there is no way to carry an exception to the caller in c++98.
+
+#ifndef THREAD_POOL_HPP
+# define THREAD_POOL_HPP
+
+# include <cstring>
+# include <stdexcept>
+# include <string>
+# include <pthread.h>
+# include <unistd.h>
+
+# include "../containers/deque.hpp"
+
+namespace ft {
+
+
+class	thread_pool
+{
+	public:
+		typedef std::size_t		size_type;
+		typedef void			(*task_function)( void* context, size_type index );
+
+		// workers: number of threads started; the thread which calls run() takes part as well
+		explicit	thread_pool( size_type workers = default_workers() )
+		: queues_(NULL), threads_(NULL), workers_(workers), queued_(0), stop_(false), next_victim_(0)
+		{
+			int		err;
+
+			// workers_ is read by the running workers, so it is set before the first one starts
+			queues_ = new queue_[workers + 1];
+			threads_ = new pthread_t[workers];
+			pthread_mutex_init(&sleep_lock_, NULL);
+			pthread_cond_init(&wake_, NULL);
+			pthread_key_create(&worker_key_, NULL);
+			for (size_type started = 0; started < workers; ++started)
+			{
+				worker_start_*	start = new worker_start_;
+
+				start->pool = this;
+				start->index = started;
+				err = pthread_create(&threads_[started], NULL, &thread_pool::worker_main_, start);
+				if (err != 0)
+				{
+					delete start;
+					shutdown_(started);
+					throw std::runtime_error(std::string("thread_pool: pthread_create: ") + std::strerror(err));
+				}
+			}
+		}
+
+		~thread_pool()
+		{ shutdown_(workers_); }
+
+		size_type	workers() const
+		{ return (workers_); }
+
+		// threads which run tasks during run(): the workers and the caller
+		size_type	concurrency() const
+		{ return (workers_ + 1); }
+
+		void	run( size_type count, task_function fn, void* context )
+		{
+			size_type	pending = count;
+			queue_&		queue = queues_[current_queue_()];
+
+			if (count == 0)
+				return ;
+			// counted before they are visible, so that a thief never takes queued_ below zero
+			__atomic_fetch_add(&queued_, count, __ATOMIC_SEQ_CST);
+			{
+				lock_guard_	guard(queue.lock);
+				size_type	pushed = 0;
+
+				try
+				{
+					for (; pushed < count; ++pushed)
+						queue.tasks.push_back(task_(fn, context, pushed, &pending));
+				}
+				catch (...)
+				{	// still locked: no thief has seen the tasks pushed
+					while (pushed-- != 0)
+						queue.tasks.pop_back();
+					__atomic_fetch_sub(&queued_, count, __ATOMIC_SEQ_CST);
+					throw ;
+				}
+			}
+			wake_workers_(count);
+
+			// help until every task of this call has finished, sleeping while there is none to take:
+			// the task which finishes the call wakes the sleepers under sleep_lock_ (execute_)
+			while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) != 0)
+			{
+				task_	task;
+
+				if (take_(task))
+				{
+					execute_(task);
+					continue ;
+				}
+				lock_guard_	guard(sleep_lock_);
+
+				while (__atomic_load_n(&pending, __ATOMIC_ACQUIRE) != 0
+						&& __atomic_load_n(&queued_, __ATOMIC_SEQ_CST) == 0)
+					pthread_cond_wait(&wake_, &sleep_lock_);
+			}
+		}
+
+		// hardware threads - 1: with the caller, one thread per hardware thread
+		static size_type	default_workers()
+		{
+			long	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+			return (cpus > 1 ? static_cast<size_type>(cpus - 1) : 0);
+		}
+
+		// the pool of ft::execution::par
+		static thread_pool&	instance()
+		{
+			static thread_pool	pool;
+
+			return (pool);
+		}
+
+	private:
+		struct	task_
+		{
+			task_()
+			: fn(NULL), context(NULL), index(0), pending(NULL)
+			{
+
+			}
+
+			task_( task_function f, void* c, size_type i, size_type* p )
+			: fn(f), context(c), index(i), pending(p)
+			{
+
+			}
+
+			task_function	fn;
+			void*			context;
+			size_type		index;
+			size_type*		pending;	// tasks of the same run() which have not finished
+		};
+
+		struct	queue_
+		{
+			queue_()
+			{ pthread_mutex_init(&lock, NULL); }
+
+			~queue_()
+			{ pthread_mutex_destroy(&lock); }
+
+			pthread_mutex_t		lock;
+			ft::deque<task_>	tasks;
+		};
+
+		struct	worker_start_
+		{
+			thread_pool*	pool;
+			size_type		index;
+		};
+
+		// mutex locked for the scope, so that an exception cannot leave it locked
+		class	lock_guard_
+		{
+			public:
+				explicit	lock_guard_( pthread_mutex_t& mutex )
+				: mutex_(mutex)
+				{ pthread_mutex_lock(&mutex_); }
+
+				~lock_guard_()
+				{ pthread_mutex_unlock(&mutex_); }
+
+			private:
+				pthread_mutex_t&	mutex_;
+
+				lock_guard_( const lock_guard_& );
+				lock_guard_&	operator=( const lock_guard_& );
+		};
+
+		queue_*				queues_;		// one per worker, then the shared one of the other threads
+		pthread_t*			threads_;
+		size_type			workers_;
+		size_type			queued_;		// tasks in all the queues
+		bool				stop_;
+		size_type			next_victim_;	// where the shared queue's thieves start, to spread them
+		pthread_mutex_t		sleep_lock_;
+		pthread_cond_t		wake_;
+		pthread_key_t		worker_key_;	// index + 1 of the worker running on this thread, 0 otherwise
+
+		// not copyable
+		thread_pool( const thread_pool& );
+		thread_pool&	operator=( const thread_pool& );
+
+		size_type	current_queue_() const
+		{
+			size_type	worker = reinterpret_cast<size_type>(pthread_getspecific(worker_key_));
+
+			return (worker != 0 ? worker - 1 : workers_);
+		}
+
+		// the back of the own queue, otherwise the front of another one
+		bool	take_( task_& out )
+		{
+			const size_type	queues = workers_ + 1;
+			const size_type	own = current_queue_();
+
+			if (__atomic_load_n(&queued_, __ATOMIC_ACQUIRE) == 0)
+				return (false);
+			if (pop_(queues_[own], out, true))
+				return (true);
+
+			size_type	start = __atomic_fetch_add(&next_victim_, 1, __ATOMIC_RELAXED);
+
+			for (size_type i = 0; i < queues; ++i)
+			{
+				size_type	victim = (start + i) % queues;
+
+				if (victim != own && pop_(queues_[victim], out, false))
+					return (true);
+			}
+			return (false);
+		}
+
+		bool	pop_( queue_& queue, task_& out, bool back )
+		{
+			bool	found = false;
+
+			{
+				lock_guard_	guard(queue.lock);
+
+				if (!queue.tasks.empty())
+				{
+					found = true;
+					if (back)
+					{
+						out = queue.tasks.back();
+						queue.tasks.pop_back();
+					}
+					else
+					{
+						out = queue.tasks.front();
+						queue.tasks.pop_front();
+					}
+				}
+			}
+			if (found)
+				__atomic_fetch_sub(&queued_, 1, __ATOMIC_SEQ_CST);
+			return (found);
+		}
+
+		// the last task of a run() wakes its caller (task.pending is not read after: it may be gone)
+		void	execute_( const task_& task )
+		{
+			task.fn(task.context, task.index);
+			if (__atomic_sub_fetch(task.pending, 1, __ATOMIC_ACQ_REL) == 0)
+			{
+				lock_guard_	guard(sleep_lock_);
+
+				pthread_cond_broadcast(&wake_);
+			}
+		}
+
+		void	wake_workers_( size_type count )
+		{
+			lock_guard_	guard(sleep_lock_);
+
+			if (count >= workers_)
+				pthread_cond_broadcast(&wake_);
+			else
+				while (count-- != 0)
+					pthread_cond_signal(&wake_);
+		}
+
+		static void*	worker_main_( void* arg )
+		{
+			worker_start_*	start = static_cast<worker_start_*>(arg);
+			thread_pool*	pool = start->pool;
+
+			pthread_setspecific(pool->worker_key_, reinterpret_cast<void*>(start->index + 1));
+			delete start;
+			while (true)
+			{
+				task_	task;
+
+				if (pool->take_(task))
+				{
+					pool->execute_(task);
+					continue ;
+				}
+				// queued_ is raised before the wake up is sent under sleep_lock_, so it cannot be missed
+				lock_guard_	guard(pool->sleep_lock_);
+
+				while (!pool->stop_ && __atomic_load_n(&pool->queued_, __ATOMIC_SEQ_CST) == 0)
+					pthread_cond_wait(&pool->wake_, &pool->sleep_lock_);
+				if (pool->stop_)
+					return (NULL);
+			}
+		}
+
+		// started: the threads to join
+		void	shutdown_( size_type started )
+		{
+			{
+				lock_guard_	guard(sleep_lock_);
+
+				stop_ = true;
+				pthread_cond_broadcast(&wake_);
+			}
+			for (size_type i = 0; i < started; ++i)
+				pthread_join(threads_[i], NULL);
+			pthread_key_delete(worker_key_);
+			pthread_cond_destroy(&wake_);
+			pthread_mutex_destroy(&sleep_lock_);
+			delete[] threads_;
+			delete[] queues_;
+		}
+};	// class thread_pool
+
+
+}	// namespace ft
+
+#endif
@@ -13,6 +13,10 @@
 // enable_if:			https://en.cppreference.com/w/cpp/types/enable_if
 // integral_constant:	https://en.cppreference.com/w/cpp/types/integral_constant
 // is_integral:			https://en.cppreference.com/w/cpp/types/is_integral
+// is_trivial:			https://en.cppreference.com/w/cpp/types/is_trivial
+// is_trivially_copyable:	https://en.cppreference.com/w/cpp/types/is_trivially_copyable
+// is_empty:			https://en.cppreference.com/w/cpp/types/is_empty
+// is_same:			https://en.cppreference.com/w/cpp/types/is_same
 
 #ifndef TYPE_TRAITS_HPP
 # define TYPE_TRAITS_HPP
@@ -43,6 +47,13 @@ namespace ft
 	typedef integral_constant<bool, true>	true_type;
 	typedef integral_constant<bool, false>	false_type;
 
+// is_same
+	template< class T, class U >
+	struct	is_same : public false_type {};
+
+	template< class T >
+	struct	is_same< T, T > : public true_type {};
+
 // remove cv
 	template< class T >
 	struct	remove_cv
@@ -94,6 +105,17 @@ namespace ft
 	template< class T >
 	struct	is_integral : public is_integral_helper<typename remove_cv<T>::type> {};
 
+// is_trivial
+	// c++98 can not detect triviality by itself, so use the compiler intrinsic (gcc, clang)
+	template< class T >
+	struct	is_trivial : public integral_constant<bool, __is_trivial(T)> {};
+
+	template< class T >
+	struct	is_trivially_copyable : public integral_constant<bool, __is_trivially_copyable(T)> {};
+
+	template< class T >
+	struct	is_empty : public integral_constant<bool, __is_empty(T)> {};
+
 
 }	// namespace ft
 
@@ -13,6 +13,8 @@
 #ifndef UTIL_HPP
 # define UTIL_HPP
 
+# include "type_traits.hpp"
+
 namespace ft {
 
 
@@ -27,6 +29,69 @@ struct _Select1st
 };
 
 
+template< typename T >
+struct _Identity
+{
+	T&	operator()( T& x ) const
+	{ return (x); }
+
+	const T&	operator()( const T& x ) const
+	{ return (x); }
+};
+
+
+// holds a T, which takes no space when T is an empty class (empty base optimization)
+// e.g. std::allocator, std::less. Tag distinguishes two holders in one class.
+template< typename T, int Tag = 0, bool = ft::is_empty<T>::value >
+class	ebo_holder_
+{
+	public:
+		ebo_holder_()
+		: value_()
+		{
+
+		}
+
+		explicit	ebo_holder_( const T& value )
+		: value_(value)
+		{
+
+		}
+
+		T&	get()
+		{ return (value_); }
+
+		const T&	get() const
+		{ return (value_); }
+
+	private:
+		T	value_;
+};
+
+template< typename T, int Tag >
+class	ebo_holder_<T, Tag, true> : private T
+{
+	public:
+		ebo_holder_()
+		: T()
+		{
+
+		}
+
+		explicit	ebo_holder_( const T& value )
+		: T(value)
+		{
+
+		}
+
+		T&	get()
+		{ return (*this); }
+
+		const T&	get() const
+		{ return (*this); }
+};
+
+
 }	// namespace ft
 
 #endif